@@ -0,0 +1,205 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "FolderPathMatcher.h"
+
+#include "OutlinerShortcutsEditorDefinitions.h"
+
+
+void FFolderPathMatcher::Compile(const TArray<FString>& Patterns)
+{
+	Nodes.Reset();
+	Nodes.AddDefaulted(); // root
+	NumPatterns = 0;
+
+	for (int32 PatternIndex = 0; PatternIndex < Patterns.Num(); ++PatternIndex)
+	{
+		FString Pattern = Patterns[PatternIndex].TrimStartAndEnd();
+		if (Pattern.IsEmpty() || Pattern.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		const bool bExclude = Pattern.RemoveFromStart(TEXT("!"));
+		Pattern.ReplaceInline(TEXT("\\"), TEXT("/"));
+
+		TArray<FString> Segments;
+		Pattern.ParseIntoArray(Segments, TEXT("/"), true);
+		if (Segments.Num() == 0)
+		{
+			OUTLINER_SHORTCUTS_WARN_H("Ignoring the empty folder pattern `%s`", *Patterns[PatternIndex]);
+			continue;
+		}
+
+		int32 Node = 0;
+		for (const FString& Segment : Segments)
+		{
+			Node = AddChild(Node, Segment);
+		}
+
+		// Patterns are compiled in order, so the index of a later pattern always wins
+		int32& EndPattern = bExclude ? Nodes[Node].ExcludePattern : Nodes[Node].IncludePattern;
+		EndPattern = PatternIndex;
+		++NumPatterns;
+	}
+
+	OUTLINER_SHORTCUTS_LOG_D("Compiled %d folder patterns into %d nodes", NumPatterns, Nodes.Num());
+}
+
+FFolderPathMatcher::FStates FFolderPathMatcher::GetInitialStates() const
+{
+	FStates States;
+	if (Nodes.Num() > 0)
+	{
+		AddClosure(States, 0);
+	}
+	return States;
+}
+
+FFolderPathMatcher::FStates FFolderPathMatcher::Step(const FStates& States, FStringView Segment) const
+{
+	FStates NextStates;
+	if (States.Num() == 0)
+	{
+		return NextStates;
+	}
+
+	// A name never added can't be one of the literals, which were all added when compiled
+	const FName SegmentName(Segment.Len(), Segment.GetData(), FNAME_Find);
+	// Only built for the nodes with wildcards
+	TOptional<FString> SegmentString;
+	for (const int32 State : States)
+	{
+		const FNode& Node = Nodes[State];
+		if (Node.bIsAnyDepth)
+		{
+			// `**` can consume any number of segments
+			AddClosure(NextStates, State);
+		}
+		if (const int32* Literal = SegmentName.IsNone() ? nullptr : Node.Literals.Find(SegmentName))
+		{
+			AddClosure(NextStates, *Literal);
+		}
+		for (const TPair<FString, int32>& Wildcard : Node.Wildcards)
+		{
+			if (!SegmentString.IsSet())
+			{
+				SegmentString.Emplace(Segment);
+			}
+			if (SegmentString->MatchesWildcard(Wildcard.Key, ESearchCase::IgnoreCase))
+			{
+				AddClosure(NextStates, Wildcard.Value);
+			}
+		}
+		if (Node.AnySegment != INDEX_NONE)
+		{
+			AddClosure(NextStates, Node.AnySegment);
+		}
+	}
+	return NextStates;
+}
+
+bool FFolderPathMatcher::IsMatch(const FStates& States) const
+{
+	int32 IncludePattern = INDEX_NONE;
+	int32 ExcludePattern = INDEX_NONE;
+	for (const int32 State : States)
+	{
+		IncludePattern = FMath::Max(IncludePattern, Nodes[State].IncludePattern);
+		ExcludePattern = FMath::Max(ExcludePattern, Nodes[State].ExcludePattern);
+	}
+	return IncludePattern > ExcludePattern;
+}
+
+bool FFolderPathMatcher::Matches(FStringView FolderPath) const
+{
+	FStates States = GetInitialStates();
+	while (FolderPath.Len() > 0 && States.Num() > 0)
+	{
+		int32 SlashIndex = INDEX_NONE;
+		const FStringView Segment = FolderPath.FindChar(TEXT('/'), SlashIndex) ? FolderPath.Left(SlashIndex) : FolderPath;
+		FolderPath.RightChopInline(Segment.Len() + 1);
+		if (Segment.Len() > 0)
+		{
+			States = Step(States, Segment);
+		}
+	}
+	return IsMatch(States);
+}
+
+const FFolderPathMatcher::FStates& FFolderPathMatcher::GetFolderStates(FName FolderPath, TMap<FName, FStates>& CachedStates) const
+{
+	if (const FStates* Cached = CachedStates.Find(FolderPath))
+	{
+		return *Cached;
+	}
+
+	// Parents are added first, the reference to their states is only used before the folder is added
+	const FString Path = FolderPath.ToString();
+	int32 SlashIndex = INDEX_NONE;
+	FStates States = Path.FindLastChar(TEXT('/'), SlashIndex)
+		? Step(GetFolderStates(FName(*Path.Left(SlashIndex)), CachedStates), FStringView(Path).RightChop(SlashIndex + 1))
+		: Step(GetInitialStates(), Path);
+	return CachedStates.Add(FolderPath, MoveTemp(States));
+}
+
+int32 FFolderPathMatcher::AddChild(int32 Parent, const FString& Segment)
+{
+	auto AddNode = [this]()
+	{
+		return Nodes.AddDefaulted();
+	};
+
+	if (Segment == TEXT("**"))
+	{
+		if (Nodes[Parent].AnyDepth == INDEX_NONE)
+		{
+			const int32 Child = AddNode();
+			Nodes[Child].bIsAnyDepth = true;
+			Nodes[Parent].AnyDepth = Child;
+		}
+		return Nodes[Parent].AnyDepth;
+	}
+
+	if (Segment == TEXT("*"))
+	{
+		if (Nodes[Parent].AnySegment == INDEX_NONE)
+		{
+			const int32 Child = AddNode();
+			Nodes[Parent].AnySegment = Child;
+		}
+		return Nodes[Parent].AnySegment;
+	}
+
+	if (Segment.Contains(TEXT("*")) || Segment.Contains(TEXT("?")))
+	{
+		for (const TPair<FString, int32>& Wildcard : Nodes[Parent].Wildcards)
+		{
+			if (Wildcard.Key.Equals(Segment, ESearchCase::IgnoreCase))
+			{
+				return Wildcard.Value;
+			}
+		}
+		const int32 Child = AddNode();
+		Nodes[Parent].Wildcards.Emplace(Segment, Child);
+		return Child;
+	}
+
+	// FName comparisons are case insensitive
+	const FName SegmentName(*Segment);
+	if (const int32* Child = Nodes[Parent].Literals.Find(SegmentName))
+	{
+		return *Child;
+	}
+	const int32 Child = AddNode();
+	Nodes[Parent].Literals.Add(SegmentName, Child);
+	return Child;
+}
+
+void FFolderPathMatcher::AddClosure(FStates& States, int32 Node) const
+{
+	while (Node != INDEX_NONE && !States.Contains(Node))
+	{
+		States.Add(Node);
+		Node = Nodes[Node].AnyDepth;
+	}
+}
@@ -0,0 +1,845 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "OutlinerShortcutsBenchmark.h"
+
+#include "SSceneOutliner.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "SceneOutlinerEvents.h"
+#include "OutlinerShortcutsSettings.h"
+#include "OutlinerShortcutsLibrary.h"
+#include "SceneOutlinerTreeModel.h"
+#include "SceneOutlinerTreePolicies.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "SceneOutlinerExpansionCache.h"
+#include "SceneOutlinerExpansionMirror.h"
+#include "SceneOutlinerLabelIndex.h"
+#include "SceneOutlinerSelectionReveal.h"
+
+#include "Editor.h"
+#include "LevelEditor.h"
+#include "EditorLoadingAndSavingUtils.h"
+#include "Engine/Note.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Views/STreeView.h"
+
+namespace
+{
+	// Time given to the Outliner to show all the actors of a synthetic map
+	constexpr double OutlinerPopulateTimeout = 300.;
+	// Time given to the Outliners to rebuild their rows after a command
+	constexpr double OutlinerRefreshTimeout = 60.;
+	// One chain in this many ends with an actor of the focused class, see `FocusedActorClasses`
+	constexpr int32 FocusedChainInterval = 10;
+	// Regressions smaller than this are considered noise, whatever the threshold
+	constexpr double MinRegressionMs = 1.;
+
+	const TCHAR* CsvHeader = TEXT("Scenario,Actors,FolderDepth,FolderFanOut,AttachmentDepth,Command,Iterations,MinMs,MedianMs,MaxMs,MedianRefreshedMs");
+
+	// True while an Outliner still has to rebuild its rows. The tree of an Outliner is only flagged once the Outliner ticked after its refresh.
+	bool IsAnyOutlinerRefreshPending()
+	{
+#if UE5_1_ONWARDS
+		for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+		{
+			if (SOutliner->GetTree().IsPendingRefresh())
+			{
+				return true;
+			}
+		}
+		return false;
+#else
+		SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+		return SOutliner && SOutliner->GetTree().IsPendingRefresh();
+#endif
+	}
+
+	// Folders expanded by the `ExpandMatchingFolders` command during the benchmark, a subtree with a nested exclusion like a real configuration
+	const TArray<FString> BenchmarkFolderPatterns = { TEXT("Benchmark/*"), TEXT("Benchmark/Folder_0/**"), TEXT("!Benchmark/Folder_0/Folder_1/**") };
+
+	// Sets `FolderExpansionPatterns` like the settings panel would, so the patterns are compiled again
+	void SetFolderExpansionPatterns(const TArray<FString>& Patterns)
+	{
+		UOutlinerShortcutsEditorSettings* EditorSettings = GetMutableDefault<UOutlinerShortcutsEditorSettings>();
+		EditorSettings->FolderExpansionPatterns = Patterns;
+		FPropertyChangedEvent PropertyChangedEvent(FindFProperty<FProperty>(UOutlinerShortcutsEditorSettings::StaticClass(), GET_MEMBER_NAME_CHECKED(UOutlinerShortcutsEditorSettings, FolderExpansionPatterns)));
+		EditorSettings->PostEditChangeProperty(PropertyChangedEvent);
+	}
+
+	// True once every Outliner is ready and shows the actor
+	bool AreAllOutlinersShowing(const AActor* Actor)
+	{
+		if (!Actor)
+		{
+			return false;
+		}
+#if UE5_1_ONWARDS
+		const TArray<TSharedRef<SSceneOutliner>> SOutliners = FOutlinerShortcutsEditorModule::GetAllSSceneOutliners();
+		for (const TSharedRef<SSceneOutliner>& SOutliner : SOutliners)
+		{
+			if (!FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(&SOutliner.Get()) || !SOutliner->GetTreeItem(FSceneOutlinerTreeItemID(Actor)).IsValid())
+			{
+				return false;
+			}
+		}
+		return SOutliners.Num() > 0;
+#else
+		SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+		return SOutliner && FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(SOutliner) && SOutliner->GetTreeItem(FSceneOutlinerTreeItemID(Actor)).IsValid();
+#endif
+	}
+
+	// Selects only the folder in the most recently used Outliner, so the commands on the selection get its whole subtree
+	void SelectOutlinerFolder(FName FolderPath)
+	{
+		SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+		if (!SOutliner)
+		{
+			return;
+		}
+
+		// Only the world items and the folders are walked, the folder is found without reaching any actor
+		FSceneOutlinerWidgetTreeModel Model(*SOutliner);
+		TArray<int32> Stack;
+		Model.GetRootItems(Stack);
+		TArray<int32> Children;
+		while (Stack.Num() > 0)
+		{
+			const int32 Item = Stack.Pop(EAllowShrinking::No);
+			const FName ItemPath = Model.GetFolderPath(Item);
+			if (ItemPath == FolderPath)
+			{
+				SOutliner->ClearSelection();
+				SOutliner->SetItemSelection(Model.GetItem(Item), true);
+				return;
+			}
+
+			Children.Reset();
+			Model.GetChildren(Item, Children);
+			for (const int32 Child : Children)
+			{
+				if (!Model.GetFolderPath(Child).IsNone())
+				{
+					Stack.Add(Child);
+				}
+			}
+		}
+		OUTLINER_SHORTCUTS_WARN_H("Folder `%s` not found in the Outliner", *FolderPath.ToString());
+	}
+
+#if UE5_1_ONWARDS
+	// Opens the second Outliner tab of the Level Editor, returning null if it could not be opened
+	TSharedPtr<SDockTab> OpenSecondOutliner()
+	{
+		FLevelEditorModule* LevelEditorModule = FModuleManager::LoadModulePtr<FLevelEditorModule>("LevelEditor");
+		const TSharedPtr<ILevelEditor> LevelEditor = LevelEditorModule ? LevelEditorModule->GetFirstLevelEditor() : nullptr;
+		const TSharedPtr<FTabManager> TabManager = LevelEditor ? LevelEditor->GetTabManager() : nullptr;
+		return TabManager ? TabManager->TryInvokeTab(FName(TEXT("LevelEditorSceneOutliner2"))) : nullptr;
+	}
+#endif
+
+	FString GetBenchmarkDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("OutlinerShortcuts") / TEXT("Benchmarks");
+	}
+
+	void AddFolderPaths(const FString& Path, int32 Depth, int32 FanOut, int32 MaxFolders, TArray<FName>& OutLeafFolders)
+	{
+		if (OutLeafFolders.Num() >= MaxFolders)
+		{
+			return;
+		}
+		if (Depth <= 0)
+		{
+			OutLeafFolders.Add(FName(*Path));
+			return;
+		}
+		for (int32 Index = 0; Index < FanOut; ++Index)
+		{
+			AddFolderPaths(FString::Printf(TEXT("%s/Folder_%d"), *Path, Index), Depth - 1, FanOut, MaxFolders, OutLeafFolders);
+		}
+	}
+}
+
+FOutlinerShortcutsBenchmark* FOutlinerShortcutsBenchmark::Instance = nullptr;
+
+void FOutlinerShortcutsBenchmark::OnStartupModule()
+{
+	Instance = this;
+	BenchmarkCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.Benchmark"),
+		TEXT("Times the Outliner Shortcuts commands on synthetic maps and compares them to a baseline. Args: Actors=1000,10000 FolderDepth=3 FolderFanOut=4 AttachmentDepth=2 Iterations=5 Threshold=0.2 Baseline=<Path> -SaveBaseline -Force -Quit"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args) { Start(Args); }),
+		ECVF_Default);
+	CaptureTreeCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.CaptureTree"),
+		TEXT("Saves the tree and expansion of the most recently used Outliner, to replay it with `OutlinerShortcuts.ReplayTree`. Args: File=<Path>"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&FOutlinerShortcutsBenchmark::CaptureTree),
+		ECVF_Default);
+	ReplayTreeCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.ReplayTree"),
+		TEXT("Times the expansion policies on a tree saved by `OutlinerShortcuts.CaptureTree`, without any Outliner. Args: <Path> Iterations=5 -Quit"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&FOutlinerShortcutsBenchmark::ReplayTree),
+		ECVF_Default);
+}
+
+void FOutlinerShortcutsBenchmark::OnShutdownModule()
+{
+	IConsoleManager::Get().UnregisterConsoleObject(BenchmarkCommand);
+	IConsoleManager::Get().UnregisterConsoleObject(CaptureTreeCommand);
+	IConsoleManager::Get().UnregisterConsoleObject(ReplayTreeCommand);
+	BenchmarkCommand = nullptr;
+	CaptureTreeCommand = nullptr;
+	ReplayTreeCommand = nullptr;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+	Steps.Empty();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FOutlinerShortcutsBenchmark* FOutlinerShortcutsBenchmark::Get()
+{
+	return Instance;
+}
+
+FString FOutlinerShortcutsBenchmark::FScenario::GetName() const
+{
+	return FString::Printf(TEXT("A%d_D%d_F%d_C%d"), NumActors, FolderDepth, FolderFanOut, AttachmentDepth);
+}
+
+double FOutlinerShortcutsBenchmark::FResult::GetMedianMs(const TArray<double>& Samples)
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.;
+	}
+	TArray<double> Sorted = Samples;
+	Sorted.Sort();
+	return Sorted[Sorted.Num() / 2];
+}
+
+bool FOutlinerShortcutsBenchmark::Start(const TArray<FString>& Args)
+{
+	if (IsRunning())
+	{
+		OUTLINER_SHORTCUTS_WARN_H("A benchmark is already running");
+		return false;
+	}
+
+	const FString CommandLine = FString::Join(Args, TEXT(" "));
+
+	FScenario Defaults;
+	FString ActorCounts = TEXT("1000,10000,100000");
+	FParse::Value(*CommandLine, TEXT("Actors="), ActorCounts);
+	FParse::Value(*CommandLine, TEXT("FolderDepth="), Defaults.FolderDepth);
+	FParse::Value(*CommandLine, TEXT("FolderFanOut="), Defaults.FolderFanOut);
+	FParse::Value(*CommandLine, TEXT("AttachmentDepth="), Defaults.AttachmentDepth);
+	Iterations = 5;
+	FParse::Value(*CommandLine, TEXT("Iterations="), Iterations);
+	Threshold = 0.2f;
+	FParse::Value(*CommandLine, TEXT("Threshold="), Threshold);
+	BaselineFilename = GetBenchmarkDir() / TEXT("Baseline.csv");
+	FParse::Value(*CommandLine, TEXT("Baseline="), BaselineFilename);
+	bSaveBaseline = FParse::Param(*CommandLine, TEXT("SaveBaseline"));
+	bQuitWhenDone = FParse::Param(*CommandLine, TEXT("Quit"));
+
+	Defaults.FolderDepth = FMath::Max(Defaults.FolderDepth, 0);
+	Defaults.FolderFanOut = FMath::Max(Defaults.FolderFanOut, 1);
+	Defaults.AttachmentDepth = FMath::Max(Defaults.AttachmentDepth, 0);
+	Iterations = FMath::Max(Iterations, 1);
+
+	// Each scenario opens a new map, don't throw away the work of the user without asking
+	const UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("No Editor World to run the benchmark in");
+		return false;
+	}
+	if (World->GetOutermost()->IsDirty() && !FParse::Param(*CommandLine, TEXT("Force")))
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("The current map has unsaved changes. Save it or run the benchmark with `-Force` to discard them.");
+		return false;
+	}
+
+	Steps.Empty();
+	Results.Empty();
+	CurrentStep = 0;
+	NumRegressions = 0;
+	bWasStopped = false;
+
+	TArray<FString> Counts;
+	ActorCounts.ParseIntoArray(Counts, TEXT(","));
+	for (const FString& Count : Counts)
+	{
+		FScenario Scenario = Defaults;
+		Scenario.NumActors = FMath::Max(FCString::Atoi(*Count), 1);
+		AddScenarioSteps(Scenario);
+	}
+
+	if (Steps.Num() == 0)
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("No scenario to run, check the `Actors=` argument");
+		return false;
+	}
+
+	// Time sliced expansion would only measure the first slice
+	UOutlinerShortcutsEditorSettings* EditorSettings = GetMutableDefault<UOutlinerShortcutsEditorSettings>();
+	bPreviousTimeSliceExpandAll = EditorSettings->bTimeSliceExpandAll;
+	EditorSettings->bTimeSliceExpandAll = false;
+	// The folders and classes of the synthetic maps are only known here, the settings of the user would match none of them
+	PreviousFolderExpansionPatterns = EditorSettings->FolderExpansionPatterns;
+	SetFolderExpansionPatterns(BenchmarkFolderPatterns);
+	PreviousFocusedActorClasses = EditorSettings->FocusedActorClasses;
+	EditorSettings->FocusedActorClasses = { ANote::StaticClass() };
+
+#if UE5_1_ONWARDS
+	// The mirror commands and the commands on all the Outliners need another Outliner to update
+	if (FOutlinerShortcutsEditorModule::GetAllSSceneOutliners().Num() < 2)
+	{
+		OpenedOutlinerTab = OpenSecondOutliner();
+		if (!OpenedOutlinerTab.IsValid())
+		{
+			OUTLINER_SHORTCUTS_WARN_H("Not able to open a second Outliner, `MirrorExpansion` and `ToggleLiveExpansionMirror` will fail");
+		}
+	}
+#endif
+
+	OUTLINER_SHORTCUTS_LOG_H("Running %d scenarios, %d iterations per command", Counts.Num(), Iterations);
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FOutlinerShortcutsBenchmark::Tick));
+	return true;
+}
+
+bool FOutlinerShortcutsBenchmark::Tick(float DeltaTime)
+{
+	// One step per tick, so the Outliner gets to refresh between two commands like it would between two key presses
+	if (Steps.IsValidIndex(CurrentStep) && Steps[CurrentStep]())
+	{
+		++CurrentStep;
+	}
+
+	if (!Steps.IsValidIndex(CurrentStep))
+	{
+		Finish();
+		return false;
+	}
+	return true;
+}
+
+void FOutlinerShortcutsBenchmark::Finish()
+{
+	TickHandle.Reset();
+	Steps.Empty();
+
+	GetMutableDefault<UOutlinerShortcutsEditorSettings>()->bTimeSliceExpandAll = bPreviousTimeSliceExpandAll;
+	SetFolderExpansionPatterns(PreviousFolderExpansionPatterns);
+	GetMutableDefault<UOutlinerShortcutsEditorSettings>()->FocusedActorClasses = PreviousFocusedActorClasses;
+#if UE5_1_ONWARDS
+	if (const TSharedPtr<SDockTab> OpenedTab = OpenedOutlinerTab.Pin())
+	{
+		OpenedTab->RequestCloseTab();
+	}
+	OpenedOutlinerTab.Reset();
+#endif
+
+	WriteResults();
+	NumRegressions = CompareToBaseline(BaselineFilename);
+
+	// The Find and Reveal popup is left open by the last iteration
+	FSlateApplication::Get().DismissAllMenus();
+	// Drop the synthetic actors
+	UEditorLoadingAndSavingUtils::NewBlankMap(false);
+
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, NumRegressions > 0 ? 1 : 0);
+	}
+}
+
+void FOutlinerShortcutsBenchmark::AddScenarioSteps(const FScenario& Scenario)
+{
+	const FString ScenarioName = Scenario.GetName();
+
+	// Filled by the populate step and read by the ones after it
+	TSharedRef<TWeakObjectPtr<AActor>> LastActor = MakeShared<TWeakObjectPtr<AActor>>();
+	TSharedRef<double> PopulateEndTime = MakeShared<double>(0.);
+
+	Steps.Add([Scenario, LastActor, PopulateEndTime]()
+		{
+			OUTLINER_SHORTCUTS_LOG_H("Scenario `%s`: spawning actors", *Scenario.GetName());
+			PopulateWorld(Scenario, *LastActor);
+			*PopulateEndTime = FPlatformTime::Seconds();
+			return true;
+		});
+
+	// Wait for the Outliners to show the last spawned actor, the time it takes is part of opening a map
+	const int32 ReadyResultIndex = Results.AddDefaulted();
+	Results[ReadyResultIndex].Scenario = ScenarioName;
+	Results[ReadyResultIndex].Settings = Scenario;
+	Results[ReadyResultIndex].Command = TEXT("OutlinerPopulate");
+
+	Steps.Add([this, LastActor, PopulateEndTime, ReadyResultIndex]()
+		{
+			const double WaitedTime = FPlatformTime::Seconds() - *PopulateEndTime;
+			if (AreAllOutlinersShowing(LastActor->Get()))
+			{
+				Results[ReadyResultIndex].SamplesMs.Add(WaitedTime * 1000.);
+				return true;
+			}
+			if (WaitedTime > OutlinerPopulateTimeout)
+			{
+				OUTLINER_SHORTCUTS_ERROR_H("The Outliner was not populated after %.0fs, stopping the benchmark", WaitedTime);
+				CurrentStep = Steps.Num();
+				bWasStopped = true;
+			}
+			return false;
+		});
+
+	const auto CollapseAll = []() { FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAll(); };
+	const auto CollapseToRoot = []() { FOutlinerShortcutsEditorModule::SceneOutlinerCollapseToRoot(); };
+	const auto ExpandAll = []() { FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll(); };
+
+	// Each command starts from the state it is the most expensive from
+	AddCommandSteps(Scenario, TEXT("CollapseAll"), ExpandAll, &FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAll);
+	AddCommandSteps(Scenario, TEXT("ExpandAll"), CollapseAll, &FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll);
+	AddCommandSteps(Scenario, TEXT("CollapseToRoot"), ExpandAll, &FOutlinerShortcutsEditorModule::SceneOutlinerCollapseToRoot);
+	AddCommandSteps(Scenario, TEXT("ExpandToDepth"), CollapseAll, []()
+		{
+			const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+			return FOutlinerShortcutsEditorModule::SceneOutlinerExpandToDepth(EditorSettings ? EditorSettings->ExpandToDepth : 1);
+		});
+	AddCommandSteps(Scenario, TEXT("ExpandOneLevel"), CollapseToRoot, &FOutlinerShortcutsEditorModule::SceneOutlinerExpandOneLevel);
+	AddCommandSteps(Scenario, TEXT("CollapseOneLevel"), ExpandAll, &FOutlinerShortcutsEditorModule::SceneOutlinerCollapseOneLevel);
+	AddCommandSteps(Scenario, TEXT("ExpandMatchingFolders"), CollapseAll, &FOutlinerShortcutsEditorModule::SceneOutlinerExpandMatchingFolders);
+	AddCommandSteps(Scenario, TEXT("ExpandFocusedClasses"), CollapseAll, &FOutlinerShortcutsEditorModule::SceneOutlinerExpandFocusedClasses);
+	AddCommandSteps(Scenario, TEXT("CollapseAllExceptFocusedClasses"), ExpandAll, &FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllExceptFocusedClasses);
+	// The first top level folder, holding one folder in `FolderFanOut` of the synthetic map
+	const FName SelectedFolder(TEXT("Benchmark/Folder_0"));
+	AddCommandSteps(Scenario, TEXT("ExpandSelectedRecursively"), [SelectedFolder]()
+		{
+			FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAll();
+			SelectOutlinerFolder(SelectedFolder);
+		}, &FOutlinerShortcutsEditorModule::SceneOutlinerExpandSelectedRecursively);
+	AddCommandSteps(Scenario, TEXT("CollapseSelectedRecursively"), [SelectedFolder]()
+		{
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll();
+			SelectOutlinerFolder(SelectedFolder);
+		}, &FOutlinerShortcutsEditorModule::SceneOutlinerCollapseSelectedRecursively);
+	// The last actor spawned is at the end of an attachment chain in the deepest folders, the farthest from the root
+	AddCommandSteps(Scenario, TEXT("RevealSelection"), [LastActor]()
+		{
+			FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAll();
+			if (AActor* Actor = LastActor->Get())
+			{
+				GEditor->SelectNone(false, true);
+				GEditor->SelectActor(Actor, true, true);
+			}
+		}, &FOutlinerShortcutsEditorModule::SceneOutlinerRevealSelection);
+	// Opening the popup builds the label index of the map, with the other indices walking the actors along, dirtied so each iteration times it. Typing the label of the last actor
+	// and picking the first result is done without the popup, which only forwards to the index and to `RevealItem`.
+	AddCommandSteps(Scenario, TEXT("FindAndReveal"), []()
+		{
+			FSlateApplication::Get().DismissAllMenus();
+			FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAll();
+			if (FSceneOutlinerLabelIndex* LabelIndex = FSceneOutlinerLabelIndex::Get())
+			{
+				LabelIndex->MarkDirty();
+			}
+		}, [LastActor]()
+		{
+			FSceneOutlinerLabelIndex* LabelIndex = FSceneOutlinerLabelIndex::Get();
+			SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+			const AActor* Actor = LastActor->Get();
+			if (!LabelIndex || !SOutliner || !Actor || !FOutlinerShortcutsEditorModule::SceneOutlinerFindAndReveal())
+			{
+				return false;
+			}
+
+			TArray<FSceneOutlinerLabelIndex::FResult> Found;
+			LabelIndex->Find(Actor->GetActorLabel(), 1, Found);
+			const FSceneOutlinerTreeItemPtr Item = Found.Num() > 0 ? SOutliner->GetTreeItem(Found[0].ID) : nullptr;
+			if (!Item)
+			{
+				return false;
+			}
+			FSceneOutlinerSelectionReveal::RevealItem(*SOutliner, Item);
+			return true;
+		});
+#if UE5_1_ONWARDS
+	const auto ExpandAllOutliners = []() { FOutlinerShortcutsEditorModule::SceneOutlinerExpandAllOutliners(); };
+	const auto CollapseAllOutliners = []() { FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutliners(); };
+	AddCommandSteps(Scenario, TEXT("CollapseAllOutliners"), ExpandAllOutliners, &FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutliners);
+	AddCommandSteps(Scenario, TEXT("CollapseAllOutlinersToRoot"), ExpandAllOutliners, &FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutlinersToRoot);
+	AddCommandSteps(Scenario, TEXT("ExpandAllOutliners"), CollapseAllOutliners, &FOutlinerShortcutsEditorModule::SceneOutlinerExpandAllOutliners);
+	// The most recently used Outliner is expanded and the others collapsed, so mirroring changes every item
+	AddCommandSteps(Scenario, TEXT("MirrorExpansion"), []()
+		{
+			FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutliners();
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll();
+		}, &FOutlinerShortcutsEditorModule::SceneOutlinerMirrorExpansion);
+	AddCommandSteps(Scenario, TEXT("ExpandMatchingFoldersAllOutliners"), CollapseAllOutliners, &FOutlinerShortcutsEditorModule::SceneOutlinerExpandMatchingFoldersAllOutliners);
+	// Starting the live mirror brings the other Outliners in sync right away, the same work as `MirrorExpansion` plus the listeners
+	const auto StopLiveMirror = []()
+	{
+		if (FSceneOutlinerExpansionMirror* Mirror = FSceneOutlinerExpansionMirror::Get())
+		{
+			Mirror->StopLiveMirror();
+		}
+	};
+	AddCommandSteps(Scenario, TEXT("ToggleLiveExpansionMirror"), [StopLiveMirror]()
+		{
+			StopLiveMirror();
+			FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutliners();
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll();
+		}, &FOutlinerShortcutsEditorModule::SceneOutlinerToggleLiveExpansionMirror);
+	// Left running, the mirror would copy the changes of the next commands and slow them down
+	Steps.Add([StopLiveMirror]()
+		{
+			StopLiveMirror();
+			return true;
+		});
+#endif
+
+	// The synthetic map is a temporary package, which is never saved when closed. Seed its state with everything expanded,
+	// otherwise restoring would time the `CollapseToRoot` fallback instead of reading the cache file.
+	Steps.Add([]()
+		{
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll();
+			return true;
+		});
+	Steps.Add([]()
+		{
+			FSceneOutlinerExpansionCache* ExpansionCache = FSceneOutlinerExpansionCache::Get();
+			SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+			const UWorld* World = FOutlinerShortcutsEditorModule::GetCurrentEditorWorld();
+			if (!ExpansionCache || !SOutliner || !World)
+			{
+				OUTLINER_SHORTCUTS_WARN_H("Unable to seed the expansion state, `RestoreLastState` will time its fallback");
+				return true;
+			}
+			ExpansionCache->SaveExpansion(*SOutliner, World->GetOutermost()->GetName());
+			ExpansionCache->WaitForPendingWrites();
+			return true;
+		});
+	AddCommandSteps(Scenario, TEXT("RestoreLastState"), CollapseAll, &FOutlinerShortcutsEditorModule::SceneOutlinerRestoreLastState);
+#if UE5_1_ONWARDS
+	AddCommandSteps(Scenario, TEXT("RestoreLastStateAllOutliners"), CollapseAllOutliners, &FOutlinerShortcutsEditorModule::SceneOutlinerRestoreLastStateAllOutliners);
+#endif
+	Steps.Add([]()
+		{
+			if (const UWorld* World = FOutlinerShortcutsEditorModule::GetCurrentEditorWorld())
+			{
+				IFileManager::Get().Delete(*FSceneOutlinerExpansionCache::GetCacheFilename(World->GetOutermost()->GetName()), false, false, true);
+			}
+			return true;
+		});
+
+	// What runs once the Outliner of a freshly opened map is ready, with the behavior from the settings
+	AddCommandSteps(Scenario, TEXT("OnMapOpened"), ExpandAll, &FSceneOutlinerEvents::ApplyOutlinerActionsFromOnMapOpenedSettings);
+}
+
+void FOutlinerShortcutsBenchmark::AddCommandSteps(const FScenario& Scenario, const FString& CommandName, TFunction<void()> Setup, TFunction<bool()> Command)
+{
+	const int32 ResultIndex = Results.AddDefaulted();
+	Results[ResultIndex].Scenario = Scenario.GetName();
+	Results[ResultIndex].Settings = Scenario;
+	Results[ResultIndex].Command = CommandName;
+
+	// Shared by the steps of an iteration, which run one after the other
+	TSharedRef<double> StartTime = MakeShared<double>(0.);
+	TSharedRef<uint64> StartFrame = MakeShared<uint64>(0);
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Steps.Add([Setup]()
+			{
+				Setup();
+				return true;
+			});
+		Steps.Add([this, Command, ResultIndex, StartTime, StartFrame]()
+			{
+				*StartTime = FPlatformTime::Seconds();
+				*StartFrame = GFrameCounter;
+				if (!Command())
+				{
+					OUTLINER_SHORTCUTS_WARN_H("`%s` failed", *Results[ResultIndex].Command);
+				}
+				Results[ResultIndex].SamplesMs.Add((FPlatformTime::Seconds() - *StartTime) * 1000.);
+				return true;
+			});
+		// `Refresh` only flags the Outliners, their items are updated and their rows rebuilt when Slate ticks them, after this ticker
+		Steps.Add([this, ResultIndex, StartTime, StartFrame]()
+			{
+				const double WaitedTime = FPlatformTime::Seconds() - *StartTime;
+				if (GFrameCounter == *StartFrame || IsAnyOutlinerRefreshPending())
+				{
+					if (WaitedTime < OutlinerRefreshTimeout)
+					{
+						return false;
+					}
+					OUTLINER_SHORTCUTS_WARN_H("The Outliner was not refreshed %.0fs after `%s`", WaitedTime, *Results[ResultIndex].Command);
+				}
+				Results[ResultIndex].RefreshedSamplesMs.Add(WaitedTime * 1000.);
+				return true;
+			});
+	}
+}
+
+void FOutlinerShortcutsBenchmark::PopulateWorld(const FScenario& Scenario, TWeakObjectPtr<AActor>& OutLastActor)
+{
+	UEditorLoadingAndSavingUtils::NewBlankMap(false);
+	UWorld* World = GEditor->GetEditorWorldContext().World();
+	if (!World)
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("Not able to create a blank map");
+		return;
+	}
+
+	// Actors are spread evenly between the deepest folders, each top level actor having a chain of attached actors under it.
+	// Some chains end with a note, the class focused by the benchmark.
+	const int32 ChainLength = Scenario.AttachmentDepth + 1;
+	const int32 NumChains = FMath::DivideAndRoundUp(Scenario.NumActors, ChainLength);
+
+	TArray<FName> LeafFolders;
+	if (Scenario.FolderDepth > 0)
+	{
+		AddFolderPaths(TEXT("Benchmark"), Scenario.FolderDepth, Scenario.FolderFanOut, NumChains, LeafFolders);
+	}
+
+	FScopedSlowTask SlowTask(Scenario.NumActors, FText::FromString(FString::Printf(TEXT("Spawning %d actors"), Scenario.NumActors)));
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	int32 NumSpawned = 0;
+	for (int32 ChainIndex = 0; ChainIndex < NumChains; ++ChainIndex)
+	{
+		AActor* Parent = nullptr;
+		for (int32 LinkIndex = 0; LinkIndex < ChainLength && NumSpawned < Scenario.NumActors; ++LinkIndex, ++NumSpawned)
+		{
+			const bool bIsFocused = ChainIndex % FocusedChainInterval == 0 && (LinkIndex == ChainLength - 1 || NumSpawned == Scenario.NumActors - 1);
+			AActor* Actor = bIsFocused ? World->SpawnActor<AActor>(ANote::StaticClass(), FTransform::Identity, SpawnParameters)
+				: World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform::Identity, SpawnParameters);
+			if (Parent)
+			{
+				Actor->AttachToActor(Parent, FAttachmentTransformRules::KeepWorldTransform);
+			}
+			else if (LeafFolders.Num() > 0)
+			{
+				Actor->SetFolderPath(LeafFolders[ChainIndex % LeafFolders.Num()]);
+			}
+			Parent = Actor;
+			OutLastActor = Actor;
+		}
+		SlowTask.EnterProgressFrame(ChainLength);
+	}
+}
+
+void FOutlinerShortcutsBenchmark::WriteResults() const
+{
+	TArray<FString> Lines;
+	Lines.Add(CsvHeader);
+	for (const FResult& Result : Results)
+	{
+		if (Result.SamplesMs.Num() == 0)
+		{
+			continue;
+		}
+		const double MedianRefreshedMs = FResult::GetMedianMs(Result.RefreshedSamplesMs);
+		Lines.Add(FString::Printf(TEXT("%s,%d,%d,%d,%d,%s,%d,%.3f,%.3f,%.3f,%.3f"),
+			*Result.Scenario, Result.Settings.NumActors, Result.Settings.FolderDepth, Result.Settings.FolderFanOut, Result.Settings.AttachmentDepth,
+			*Result.Command, Result.SamplesMs.Num(), FMath::Min(Result.SamplesMs), Result.GetMedianMs(), FMath::Max(Result.SamplesMs), MedianRefreshedMs));
+		OUTLINER_SHORTCUTS_LOG("%-20s %-30s median %10.3f ms  refreshed %10.3f ms", *Result.Scenario, *Result.Command, Result.GetMedianMs(), MedianRefreshedMs);
+	}
+
+	const FString Filename = GetBenchmarkDir() / FString::Printf(TEXT("Benchmark-%s.csv"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringArrayToFile(Lines, *Filename))
+	{
+		OUTLINER_SHORTCUTS_LOG_H("Results written to `%s`", *Filename);
+	}
+	else
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("Not able to write the results to `%s`", *Filename);
+	}
+
+	if (bSaveBaseline)
+	{
+		if (FFileHelper::SaveStringArrayToFile(Lines, *BaselineFilename))
+		{
+			OUTLINER_SHORTCUTS_LOG_H("Baseline saved to `%s`", *BaselineFilename);
+		}
+		else
+		{
+			OUTLINER_SHORTCUTS_ERROR_H("Not able to write the baseline to `%s`", *BaselineFilename);
+		}
+	}
+}
+
+int32 FOutlinerShortcutsBenchmark::CompareToBaseline(const FString& InBaselineFilename) const
+{
+	TArray<FString> Lines;
+	if (bSaveBaseline || !FFileHelper::LoadFileToStringArray(Lines, *InBaselineFilename))
+	{
+		OUTLINER_SHORTCUTS_LOG_H("No baseline to compare to at `%s`", *InBaselineFilename);
+		return 0;
+	}
+
+	// Medians of each command of each scenario, see `CsvHeader`. Baselines saved before the refreshed column have no value for it.
+	constexpr int32 ScenarioColumn = 0;
+	constexpr int32 CommandColumn = 5;
+	constexpr int32 MedianColumn = 8;
+	constexpr int32 MedianRefreshedColumn = 10;
+	TMap<FString, double> BaselineMedians;
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		TArray<FString> Columns;
+		Lines[LineIndex].ParseIntoArray(Columns, TEXT(","), false);
+		const FString Key = Columns.Num() > CommandColumn ? Columns[ScenarioColumn] + TEXT("|") + Columns[CommandColumn] : FString();
+		if (Columns.Num() > MedianColumn)
+		{
+			BaselineMedians.Add(Key, FCString::Atod(*Columns[MedianColumn]));
+		}
+		if (Columns.Num() > MedianRefreshedColumn)
+		{
+			BaselineMedians.Add(Key + TEXT("|Refreshed"), FCString::Atod(*Columns[MedianRefreshedColumn]));
+		}
+	}
+
+	int32 NumSlowerCommands = 0;
+	auto CheckRegression = [this, &BaselineMedians, &NumSlowerCommands](const FResult& Result, const FString& Key, const TArray<double>& Samples)
+	{
+		const double* BaselineMedian = BaselineMedians.Find(Key);
+		if (!BaselineMedian || Samples.Num() == 0)
+		{
+			return;
+		}
+
+		const double Median = FResult::GetMedianMs(Samples);
+		if (Median > *BaselineMedian * (1. + Threshold) && Median - *BaselineMedian > MinRegressionMs)
+		{
+			++NumSlowerCommands;
+			OUTLINER_SHORTCUTS_ERROR("Regression: %s %s took %.3f ms, baseline is %.3f ms (+%.0f%%)", *Result.Scenario, *Key.RightChop(Result.Scenario.Len() + 1), Median, *BaselineMedian, (Median / *BaselineMedian - 1.) * 100.);
+		}
+	};
+
+	for (const FResult& Result : Results)
+	{
+		const FString Key = Result.Scenario + TEXT("|") + Result.Command;
+		CheckRegression(Result, Key, Result.SamplesMs);
+		CheckRegression(Result, Key + TEXT("|Refreshed"), Result.RefreshedSamplesMs);
+	}
+
+	if (NumSlowerCommands == 0)
+	{
+		OUTLINER_SHORTCUTS_LOG_H("No regression against `%s` (threshold %.0f%%)", *InBaselineFilename, Threshold * 100.f);
+	}
+	return NumSlowerCommands;
+}
+
+void FOutlinerShortcutsBenchmark::CaptureTree(const TArray<FString>& Args)
+{
+	SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetReadySSceneOutliner();
+	const UWorld* World = FOutlinerShortcutsEditorModule::GetCurrentEditorWorld();
+	if (!SOutliner || !World)
+	{
+		return;
+	}
+
+	const FString CommandLine = FString::Join(Args, TEXT(" "));
+	FString Filename = FPaths::ProjectSavedDir() / TEXT("OutlinerShortcuts") / TEXT("Trees") / FPaths::MakeValidFileName(World->GetOutermost()->GetName().Replace(TEXT("/"), TEXT("_")), TEXT('_')) + TEXT(".bin");
+	FParse::Value(*CommandLine, TEXT("File="), Filename);
+
+	// Nothing is changed, the batch is only read from
+	FSceneOutlinerExpansionBatch Batch;
+	const FSceneOutlinerWidgetTreeModel WidgetModel(*SOutliner, &Batch);
+	const TSharedRef<FSceneOutlinerMemoryTreeModel> Model = FSceneOutlinerMemoryTreeModel::Capture(WidgetModel);
+	if (Model->SaveToFile(Filename))
+	{
+		OUTLINER_SHORTCUTS_LOG_H("Saved the %d items of the Outliner to `%s`", Model->Num(), *Filename);
+	}
+	else
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("Not able to write the tree to `%s`", *Filename);
+	}
+}
+
+void FOutlinerShortcutsBenchmark::ReplayTree(const TArray<FString>& Args)
+{
+	const FString CommandLine = FString::Join(Args, TEXT(" "));
+	const bool bQuit = FParse::Param(*CommandLine, TEXT("Quit"));
+	int32 NumIterations = 5;
+	FParse::Value(*CommandLine, TEXT("Iterations="), NumIterations);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	const TSharedPtr<FSceneOutlinerMemoryTreeModel> Model = Args.Num() > 0 ? FSceneOutlinerMemoryTreeModel::LoadFromFile(Args[0]) : nullptr;
+	if (!Model)
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("Usage: OutlinerShortcuts.ReplayTree <Path> [Iterations=5] [-Quit], with a file saved by `OutlinerShortcuts.CaptureTree`");
+		if (bQuit)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+		return;
+	}
+
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	const TBitArray<> CapturedExpansion = Model->GetExpansion();
+
+	// Each operation starts from the state it is the most expensive from, as in the benchmark of the commands
+	FOutlinerShortcutsOperation CollapseAll;
+	CollapseAll.Type = EOutlinerShortcutsOperationType::CollapseAll;
+	FOutlinerShortcutsOperation ExpandAll;
+	ExpandAll.Type = EOutlinerShortcutsOperationType::ExpandAll;
+	FOutlinerShortcutsOperation CollapseToRoot;
+	CollapseToRoot.Type = EOutlinerShortcutsOperationType::CollapseToRoot;
+	FOutlinerShortcutsOperation ExpandToDepth;
+	ExpandToDepth.Type = EOutlinerShortcutsOperationType::ExpandToDepth;
+	ExpandToDepth.Depth = EditorSettings ? EditorSettings->ExpandToDepth : 1;
+	FOutlinerShortcutsOperation ExpandMatchingFolders;
+	ExpandMatchingFolders.Type = EOutlinerShortcutsOperationType::ExpandMatchingFolders;
+
+	const TArray<TPair<FOutlinerShortcutsOperation, FOutlinerShortcutsOperation>> Runs = {
+		{ ExpandAll, CollapseAll },
+		{ CollapseAll, ExpandAll },
+		{ ExpandAll, CollapseToRoot },
+		{ CollapseAll, ExpandToDepth },
+		{ ExpandAll, ExpandMatchingFolders },
+	};
+
+	OUTLINER_SHORTCUTS_LOG_H("Replaying `%s`: %d items, %d iterations per policy", *Args[0], Model->Num(), NumIterations);
+	for (const TPair<FOutlinerShortcutsOperation, FOutlinerShortcutsOperation>& Run : Runs)
+	{
+		FResult Result;
+		Result.Command = UEnum::GetValueAsString(Run.Value.Type);
+		int32 NumVisited = 0;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Model->SetExpansion(CapturedExpansion);
+			FSceneOutlinerTreePolicies::ApplyOperation(*Model, Run.Key, NumVisited);
+
+			const double StartTime = FPlatformTime::Seconds();
+			FSceneOutlinerTreePolicies::ApplyOperation(*Model, Run.Value, NumVisited);
+			Result.SamplesMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.);
+		}
+		OUTLINER_SHORTCUTS_LOG("%-50s min %10.3f ms  median %10.3f ms  %d items visited", *Result.Command, FMath::Min(Result.SamplesMs), Result.GetMedianMs(), NumVisited);
+	}
+	Model->SetExpansion(CapturedExpansion);
+
+	if (bQuit)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, 0);
+	}
+}
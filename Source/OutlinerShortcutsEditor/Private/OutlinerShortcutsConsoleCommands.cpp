@@ -0,0 +1,180 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "OutlinerShortcutsConsoleCommands.h"
+
+#include "OutlinerShortcutsLibrary.h"
+#include "SceneOutlinerLabelIndex.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "HAL/PlatformTime.h"
+
+
+void FOutlinerShortcutsConsoleCommands::OnStartupModule()
+{
+	FOutlinerShortcutsOperation Operation;
+
+	Operation.Type = EOutlinerShortcutsOperationType::CollapseAll;
+	RegisterOperationCommand(TEXT("OutlinerShortcuts.CollapseAll"), TEXT("Collapses the given Outliners, or the most recently used one. Args: [OutlinerId...]"), Operation);
+	Operation.Type = EOutlinerShortcutsOperationType::CollapseToRoot;
+	RegisterOperationCommand(TEXT("OutlinerShortcuts.CollapseToRoot"), TEXT("Collapses the given Outliners to root, or the most recently used one. Args: [OutlinerId...]"), Operation);
+	Operation.Type = EOutlinerShortcutsOperationType::ExpandAll;
+	RegisterOperationCommand(TEXT("OutlinerShortcuts.ExpandAll"), TEXT("Expands the given Outliners, or the most recently used one. Args: [OutlinerId...]"), Operation);
+	Operation.Type = EOutlinerShortcutsOperationType::RestoreLastState;
+	RegisterOperationCommand(TEXT("OutlinerShortcuts.RestoreLastState"), TEXT("Restores the expansion saved for the current map in the given Outliners, or the most recently used one. Args: [OutlinerId...]"), Operation);
+	Operation.Type = EOutlinerShortcutsOperationType::ExpandMatchingFolders;
+	RegisterOperationCommand(TEXT("OutlinerShortcuts.ExpandMatchingFolders"), TEXT("Expands only the folders matching the Folder Expansion Patterns of the settings in the given Outliners, or the most recently used one. Args: [OutlinerId...]"), Operation);
+	Operation.Type = EOutlinerShortcutsOperationType::ExpandFocusedClasses;
+	RegisterOperationCommand(TEXT("OutlinerShortcuts.ExpandFocusedClasses"), TEXT("Expands the parents of the actors of the Focused Actor Classes of the settings in the given Outliners, or the most recently used one. Args: [OutlinerId...]"), Operation);
+	Operation.Type = EOutlinerShortcutsOperationType::CollapseAllExceptFocusedClasses;
+	RegisterOperationCommand(TEXT("OutlinerShortcuts.CollapseAllExceptFocusedClasses"), TEXT("Collapses the given Outliners, or the most recently used one, except the parents of the actors of the Focused Actor Classes of the settings. Args: [OutlinerId...]"), Operation);
+
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+	ConsoleObjects.Add(ConsoleManager.RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.ExpandToDepth"),
+		TEXT("Expands the given Outliners, or the most recently used one, down to the given depth. Args: <Depth> [OutlinerId...]"),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&FOutlinerShortcutsConsoleCommands::ExpandToDepth),
+		ECVF_Default));
+	ConsoleObjects.Add(ConsoleManager.RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.Apply"),
+		TEXT("Applies several operations in one pass, refreshing each Outliner once. Args: <Operation>... [Outliner=<OutlinerId>]... Operations: CollapseAll, CollapseToRoot, ExpandAll, ExpandToDepth[=<Depth>], RestoreLastState, ExpandMatchingFolders, ExpandFocusedClasses, CollapseAllExceptFocusedClasses"),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&FOutlinerShortcutsConsoleCommands::Apply),
+		ECVF_Default));
+	ConsoleObjects.Add(ConsoleManager.RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.ListOutliners"),
+		TEXT("Prints the identifiers of the opened Outliners, from the most recently used"),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&FOutlinerShortcutsConsoleCommands::ListOutliners),
+		ECVF_Default));
+	ConsoleObjects.Add(ConsoleManager.RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.FindLabel"),
+		TEXT("Prints the actors and folders whose label contains the query, as listed by the Find and Reveal popup, and the time the lookup took. Args: <Query> [Max=<MaxResults>]"),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&FOutlinerShortcutsConsoleCommands::FindLabel),
+		ECVF_Default));
+}
+
+void FOutlinerShortcutsConsoleCommands::OnShutdownModule()
+{
+	for (IConsoleObject* ConsoleObject : ConsoleObjects)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ConsoleObject);
+	}
+	ConsoleObjects.Empty();
+}
+
+void FOutlinerShortcutsConsoleCommands::RegisterOperationCommand(const TCHAR* Name, const TCHAR* Help, const FOutlinerShortcutsOperation& Operation)
+{
+	ConsoleObjects.Add(IConsoleManager::Get().RegisterConsoleCommand(Name, Help,
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([Operation](const TArray<FString>& Args, FOutputDevice& Ar)
+			{
+				TArray<FName> OutlinerIds;
+				for (const FString& Arg : Args)
+				{
+					OutlinerIds.Add(FName(*Arg));
+				}
+				ApplyOperations({ Operation }, OutlinerIds, Ar);
+			}),
+		ECVF_Default));
+}
+
+void FOutlinerShortcutsConsoleCommands::ApplyOperations(const TArray<FOutlinerShortcutsOperation>& Operations, const TArray<FName>& OutlinerIds, FOutputDevice& Ar)
+{
+	const FOutlinerShortcutsBatchResult Result = UOutlinerShortcutsLibrary::ApplyOperations(Operations, OutlinerIds);
+	Ar.Logf(TEXT("%s %d operations in %.2f ms: %d Outliners refreshed, %d items visited, %d expanded, %d collapsed"),
+		Result.bSuccess ? TEXT("Applied") : TEXT("Partially applied"), Operations.Num(), Result.DurationMs,
+		Result.OutlinersTouched, Result.ItemsVisited, Result.ItemsExpanded, Result.ItemsCollapsed);
+}
+
+void FOutlinerShortcutsConsoleCommands::Apply(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	TArray<FOutlinerShortcutsOperation> Operations;
+	TArray<FName> OutlinerIds;
+	for (const FString& Arg : Args)
+	{
+		FString OutlinerId;
+		if (FParse::Value(*Arg, TEXT("Outliner="), OutlinerId))
+		{
+			OutlinerIds.Add(FName(*OutlinerId));
+			continue;
+		}
+
+		FOutlinerShortcutsOperation Operation;
+		if (!UOutlinerShortcutsLibrary::ParseOperation(Arg, Operation))
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("Unknown operation or invalid depth `%s`"), *Arg);
+			return;
+		}
+		Operations.Add(Operation);
+	}
+
+	if (Operations.Num() == 0)
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("No operation given"));
+		return;
+	}
+	ApplyOperations(Operations, OutlinerIds, Ar);
+}
+
+void FOutlinerShortcutsConsoleCommands::ExpandToDepth(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	if (Args.Num() == 0 || !Args[0].IsNumeric())
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Usage: OutlinerShortcuts.ExpandToDepth <Depth> [OutlinerId...]"));
+		return;
+	}
+
+	FOutlinerShortcutsOperation Operation;
+	Operation.Type = EOutlinerShortcutsOperationType::ExpandToDepth;
+	Operation.Depth = FCString::Atoi(*Args[0]);
+
+	TArray<FName> OutlinerIds;
+	for (int32 Index = 1; Index < Args.Num(); ++Index)
+	{
+		OutlinerIds.Add(FName(*Args[Index]));
+	}
+	ApplyOperations({ Operation }, OutlinerIds, Ar);
+}
+
+void FOutlinerShortcutsConsoleCommands::ListOutliners(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	const TArray<FName> OutlinerIds = UOutlinerShortcutsLibrary::GetOutlinerIds();
+	if (OutlinerIds.Num() == 0)
+	{
+		Ar.Logf(TEXT("No Outliner identifiers (only available from UE 5.1)"));
+	}
+	for (const FName& OutlinerId : OutlinerIds)
+	{
+		Ar.Logf(TEXT("%s"), *OutlinerId.ToString());
+	}
+}
+
+void FOutlinerShortcutsConsoleCommands::FindLabel(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	FSceneOutlinerLabelIndex* LabelIndex = FSceneOutlinerLabelIndex::Get();
+	int32 MaxResults = 50;
+	FString Query;
+	for (const FString& Arg : Args)
+	{
+		if (!FParse::Value(*Arg, TEXT("Max="), MaxResults))
+		{
+			Query = Query.IsEmpty() ? Arg : Query + TEXT(" ") + Arg;
+		}
+	}
+	if (!LabelIndex || Query.IsEmpty())
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Usage: OutlinerShortcuts.FindLabel <Query> [Max=<MaxResults>]"));
+		return;
+	}
+
+	// Built apart so the time printed is the one of a lookup
+	LabelIndex->BuildIfNeeded();
+	TArray<FSceneOutlinerLabelIndex::FResult> Results;
+	const double StartTime = FPlatformTime::Seconds();
+	LabelIndex->Find(Query, MaxResults, Results);
+	const double DurationMs = (FPlatformTime::Seconds() - StartTime) * 1000.;
+
+	for (const FSceneOutlinerLabelIndex::FResult& Result : Results)
+	{
+		Ar.Logf(TEXT("%s%s\t%s"), *Result.Label, Result.bIsFolder ? TEXT("/") : TEXT(""), *Result.ParentPath.ToString());
+	}
+	Ar.Logf(TEXT("Found %d results among %d actors and folders in %.3f ms"), Results.Num(), LabelIndex->Num(), DurationMs);
+}
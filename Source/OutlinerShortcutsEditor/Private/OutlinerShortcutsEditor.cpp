@@ -8,11 +8,35 @@
 #include "Widgets/Views/STreeView.h"
 #include "SceneOutlinerFwd.h"
 #include "SSceneOutliner.h"
+#include "FolderTreeItem.h"
+#include "WorldTreeItem.h"
+#include "ISceneOutlinerMode.h"
 
 #include "Editor.h"
 #include "SceneOutlinerEvents.h"
+#include "SceneOutlinerHierarchyIndex.h"
+#include "SceneOutlinerTimeSlicedExpansion.h"
+#include "SceneOutlinerExpansionFrontier.h"
+#include "SceneOutlinerTracker.h"
+#include "SceneOutlinerExpansionCache.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "OutlinerShortcutsStats.h"
+#include "OutlinerShortcutsBenchmark.h"
+#include "OutlinerShortcutsConsoleCommands.h"
+#include "SceneOutlinerSelectionReveal.h"
+#include "SceneOutlinerExpansionPlanner.h"
+#include "SceneOutlinerIncrementalExpansion.h"
+#include "SceneOutlinerExpansionMirror.h"
+#include "SceneOutlinerFingerprints.h"
+#include "SceneOutlinerActorClassIndex.h"
+#include "SceneOutlinerLabelIndex.h"
+#include "SceneOutlinerWorldActorIndex.h"
+#include "SSceneOutlinerQuickFind.h"
+#include "SceneOutlinerTreeModel.h"
+#include "SceneOutlinerTreePolicies.h"
 #include "ISettingsModule.h"
 #include "OutlinerShortcutsSettings.h"
+#include "FolderPathMatcher.h"
 
 #include "Framework/Docking/TabManager.h"
 
@@ -70,6 +94,8 @@ void FOutlinerShortcutsEditorModule::ShutdownModule()
 		ModuleListeners[i]->OnShutdownModule();
 	}
 
+	FOutlinerShortcutsLogLimiter::LogSummary();
+
 	OUTLINER_SHORTCUTS_LOG("`FOutlinerShortcutsEditorModule` Unloaded");
 }
 
@@ -106,7 +132,27 @@ void FOutlinerShortcutsEditorModule::UnregisterSettings()
 
 void FOutlinerShortcutsEditorModule::AddModuleListeners()
 {
+	ModuleListeners.Add(MakeShareable(new FOutlinerShortcutsStats));
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerHierarchyIndex));
+#if UE5_1_ONWARDS
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerTracker));
+#endif
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerFingerprints));
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerTimeSlicedExpansion));
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerExpansionCache));
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerExpansionPlanner));
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerIncrementalExpansion));
+#if UE5_1_ONWARDS
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerExpansionMirror));
+#endif
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerSelectionReveal));
+	// Before the indices built on it, which register to it when started
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerWorldActorIndex));
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerActorClassIndex));
+	ModuleListeners.Add(MakeShareable(new FSceneOutlinerLabelIndex));
 	ModuleListeners.Add(MakeShareable(new FSceneOutlinerEvents));
+	ModuleListeners.Add(MakeShareable(new FOutlinerShortcutsConsoleCommands));
+	ModuleListeners.Add(MakeShareable(new FOutlinerShortcutsBenchmark));
 }
 
 void FOutlinerShortcutsEditorModule::MapCommands()
@@ -131,6 +177,47 @@ void FOutlinerShortcutsEditorModule::MapCommands()
 		[]() {
 			FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll();
 		}));
+	CommandList->MapAction(Commands.SceneOutlinerExpandToDepth, FExecuteAction::CreateLambda(
+		[]() {
+			const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandToDepth(EditorSettings ? EditorSettings->ExpandToDepth : 1);
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerExpandOneLevel, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandOneLevel();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerCollapseOneLevel, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerCollapseOneLevel();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerRevealSelection, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerRevealSelection();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerExpandMatchingFolders, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandMatchingFolders();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerExpandFocusedClasses, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandFocusedClasses();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerCollapseAllExceptFocusedClasses, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllExceptFocusedClasses();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerExpandSelectedRecursively, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandSelectedRecursively();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerCollapseSelectedRecursively, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerCollapseSelectedRecursively();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerFindAndReveal, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerFindAndReveal();
+		}));
 
 #if UE5_1_ONWARDS
 	CommandList->MapAction(Commands.SceneOutlinerCollapseAllOutliners, FExecuteAction::CreateStatic(
@@ -145,6 +232,18 @@ void FOutlinerShortcutsEditorModule::MapCommands()
 		[]() {
 			FOutlinerShortcutsEditorModule::SceneOutlinerExpandAllOutliners();
 		}));
+	CommandList->MapAction(Commands.SceneOutlinerExpandMatchingFoldersAllOutliners, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerExpandMatchingFoldersAllOutliners();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerMirrorExpansion, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerMirrorExpansion();
+		}));
+	CommandList->MapAction(Commands.SceneOutlinerToggleLiveExpansionMirror, FExecuteAction::CreateLambda(
+		[]() {
+			FOutlinerShortcutsEditorModule::SceneOutlinerToggleLiveExpansionMirror();
+		}));
 #endif
 
 	// register the commands to the Level Editor to make them available to shortcuts
@@ -163,12 +262,21 @@ void FOutlinerShortcutsEditorModule::MapCommands()
 bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAll()
 {
 	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerCollapseAll);
+	CancelTimeSlicedExpansion();
 
 	if (SSceneOutliner* SOutliner = GetSSceneOutliner())
 	{
 		if (IsSceneOutlinerReady(SOutliner))
 		{
-			SOutliner->CollapseAll();
+			if (FSceneOutlinerFingerprints::ShouldSkip(*SOutliner, FSceneOutlinerFingerprints::CollapseAllPolicy))
+			{
+				return true;
+			}
+			FSceneOutlinerExpansionBatch Batch;
+			Batch.CollapseAll(*SOutliner);
+			Batch.Commit();
+			FSceneOutlinerFingerprints::Record(*SOutliner, FSceneOutlinerFingerprints::CollapseAllPolicy);
 			return true;
 		}
 #if PRE_UE5_1
@@ -188,20 +296,21 @@ bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAll()
 bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseToRoot()
 {
 	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerCollapseToRoot);
+	CancelTimeSlicedExpansion();
 
 	if (SSceneOutliner* SOutliner = GetSSceneOutliner())
 	{
 		if (IsSceneOutlinerReady(SOutliner))
 		{
-			SOutliner->CollapseAll();
-			TArray<FSceneOutlinerTreeItemPtr> RootItems = GetSceneOutlinerRootItems(SOutliner);
-			for (FSceneOutlinerTreeItemPtr Item : RootItems)
+			if (FSceneOutlinerFingerprints::ShouldSkip(*SOutliner, FSceneOutlinerFingerprints::CollapseToRootPolicy))
 			{
-				if (Item)
-				{
-					SOutliner->SetItemExpansion(Item, true);
-				}
+				return true;
 			}
+			FSceneOutlinerExpansionBatch Batch;
+			CollapseToRoot(Batch, *SOutliner);
+			Batch.Commit();
+			FSceneOutlinerFingerprints::Record(*SOutliner, FSceneOutlinerFingerprints::CollapseToRootPolicy);
 			return true;
 		}
 #if PRE_UE5_1
@@ -221,12 +330,29 @@ bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseToRoot()
 bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll()
 {
 	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerExpandAll);
+	// Pressing the shortcut again while a time sliced expansion is running cancels it
+	if (CancelTimeSlicedExpansion())
+	{
+		return true;
+	}
 
 	if (SSceneOutliner* SOutliner = GetSSceneOutliner())
 	{
 		if (IsSceneOutlinerReady(SOutliner))
 		{
-			SOutliner->ExpandAll();
+			if (FSceneOutlinerFingerprints::ShouldSkip(*SOutliner, FSceneOutlinerFingerprints::ExpandAllPolicy))
+			{
+				return true;
+			}
+			if (ShouldTimeSliceExpandAll())
+			{
+				return FSceneOutlinerTimeSlicedExpansion::Get()->Start({ SOutliner });
+			}
+			FSceneOutlinerExpansionBatch Batch;
+			Batch.ExpandAll(*SOutliner);
+			Batch.Commit();
+			FSceneOutlinerFingerprints::Record(*SOutliner, FSceneOutlinerFingerprints::ExpandAllPolicy);
 			return true;
 		}
 #if PRE_UE5_1
@@ -243,19 +369,235 @@ bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandAll()
 	return false;
 }
 
+bool FOutlinerShortcutsEditorModule::SceneOutlinerRestoreLastState()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerRestoreLastState);
+	CancelTimeSlicedExpansion();
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		FSceneOutlinerExpansionCache* ExpansionCache = FSceneOutlinerExpansionCache::Get();
+		if (!ExpansionCache || !ExpansionCache->RestoreExpansion(Batch, *SOutliner))
+		{
+			OUTLINER_SHORTCUTS_LOG_D("No expansion state saved for this map, collapsing to root");
+			CollapseToRoot(Batch, *SOutliner);
+		}
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandToDepth(int32 Depth)
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerExpandToDepth);
+	CancelTimeSlicedExpansion();
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		const FName Policy = FSceneOutlinerFingerprints::MakeExpandToDepthPolicy(Depth);
+		if (FSceneOutlinerFingerprints::ShouldSkip(*SOutliner, Policy))
+		{
+			return true;
+		}
+
+		FSceneOutlinerExpansionBatch Batch;
+		WithExpansionFrontier(Batch, *SOutliner, [Depth](ISceneOutlinerTreeModel& Model, FSceneOutlinerExpansionFrontier& Frontier)
+			{
+				Frontier.ExpandToDepth(Model, Depth);
+			});
+		Batch.Commit();
+		FSceneOutlinerFingerprints::Record(*SOutliner, Policy);
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandOneLevel()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerExpandOneLevel);
+	CancelTimeSlicedExpansion();
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		WithExpansionFrontier(Batch, *SOutliner, [](ISceneOutlinerTreeModel& Model, FSceneOutlinerExpansionFrontier& Frontier)
+			{
+				Frontier.ExpandOneLevel(Model);
+			});
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseOneLevel()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerCollapseOneLevel);
+	CancelTimeSlicedExpansion();
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		WithExpansionFrontier(Batch, *SOutliner, [](ISceneOutlinerTreeModel& Model, FSceneOutlinerExpansionFrontier& Frontier)
+			{
+				Frontier.CollapseOneLevel(Model);
+			});
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerRevealSelection()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerRevealSelection);
+	CancelTimeSlicedExpansion();
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		if (FSceneOutlinerSelectionReveal* SelectionReveal = FSceneOutlinerSelectionReveal::Get())
+		{
+			return SelectionReveal->RevealSelection(*SOutliner);
+		}
+		OUTLINER_SHORTCUTS_ERROR_H("`FSceneOutlinerSelectionReveal` is not registered");
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandMatchingFolders()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerExpandMatchingFolders);
+	CancelTimeSlicedExpansion();
+
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!EditorSettings)
+	{
+		OUTLINER_SHORTCUTS_WARN_H("Unable to get `UOutlinerShortcutsEditorSettings`...");
+		return false;
+	}
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		ExpandMatchingFolders(Batch, *SOutliner, EditorSettings->GetFolderPatternMatcher());
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandFocusedClasses()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerExpandFocusedClasses);
+	CancelTimeSlicedExpansion();
+
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!EditorSettings)
+	{
+		OUTLINER_SHORTCUTS_WARN_H("Unable to get `UOutlinerShortcutsEditorSettings`...");
+		return false;
+	}
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		ExpandParentsOfClasses(Batch, *SOutliner, EditorSettings->GetFocusedActorClasses(), false);
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllExceptFocusedClasses()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerCollapseAllExceptFocusedClasses);
+	CancelTimeSlicedExpansion();
+
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!EditorSettings)
+	{
+		OUTLINER_SHORTCUTS_WARN_H("Unable to get `UOutlinerShortcutsEditorSettings`...");
+		return false;
+	}
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		ExpandParentsOfClasses(Batch, *SOutliner, EditorSettings->GetFocusedActorClasses(), true);
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandSelectedRecursively()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerExpandSelectedRecursively);
+	CancelTimeSlicedExpansion();
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		SetSelectedSubtreesExpansion(Batch, *SOutliner, true);
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseSelectedRecursively()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerCollapseSelectedRecursively);
+	CancelTimeSlicedExpansion();
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		SetSelectedSubtreesExpansion(Batch, *SOutliner, false);
+		return true;
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerFindAndReveal()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerFindAndReveal);
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		SSceneOutlinerQuickFind::Open(*SOutliner);
+		return true;
+	}
+	return false;
+}
+
 #if UE5_1_ONWARDS
 bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutliners()
 {
 	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerCollapseAllOutliners);
+	CancelTimeSlicedExpansion();
 
 	bool bAllCollapsed = true;
+	FSceneOutlinerExpansionBatch Batch;
+	TArray<SSceneOutliner*> AppliedOutliners;
 
-	TArray<SSceneOutliner*> SOutliners = GetAllSSceneOutliners();
-	for (SSceneOutliner* SOutliner : SOutliners)
+	const TArray<TSharedRef<SSceneOutliner>> SOutliners = GetAllSSceneOutliners();
+	for (const TSharedRef<SSceneOutliner>& SOutliner : SOutliners)
 	{
-		if (IsSceneOutlinerReady(SOutliner))
+		if (IsSceneOutlinerReady(&SOutliner.Get()))
 		{
-			SOutliner->CollapseAll();
+			if (!FSceneOutlinerFingerprints::ShouldSkip(SOutliner.Get(), FSceneOutlinerFingerprints::CollapseAllPolicy))
+			{
+				Batch.CollapseAll(SOutliner.Get());
+				AppliedOutliners.Add(&SOutliner.Get());
+			}
 			bAllCollapsed &= true;
 		}
 		else
@@ -270,28 +612,33 @@ bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutliners()
 		OUTLINER_SHORTCUTS_ERROR_H("Not able to get any `SSceneOutliner`");
 	}
 
+	Batch.Commit();
+	for (SSceneOutliner* SOutliner : AppliedOutliners)
+	{
+		FSceneOutlinerFingerprints::Record(*SOutliner, FSceneOutlinerFingerprints::CollapseAllPolicy);
+	}
 	return bAllCollapsed;
 }
 
 bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutlinersToRoot()
 {
 	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerCollapseAllOutlinersToRoot);
+	CancelTimeSlicedExpansion();
 
 	bool bAllCollapsed = true;
+	FSceneOutlinerExpansionBatch Batch;
+	TArray<SSceneOutliner*> AppliedOutliners;
 
-	TArray<SSceneOutliner*> SOutliners = GetAllSSceneOutliners();
-	for (SSceneOutliner* SOutliner : SOutliners)
+	const TArray<TSharedRef<SSceneOutliner>> SOutliners = GetAllSSceneOutliners();
+	for (const TSharedRef<SSceneOutliner>& SOutliner : SOutliners)
 	{
-		if (IsSceneOutlinerReady(SOutliner))
+		if (IsSceneOutlinerReady(&SOutliner.Get()))
 		{
-			SOutliner->CollapseAll();
-			TArray<FSceneOutlinerTreeItemPtr> RootItems = GetSceneOutlinerRootItems(SOutliner);
-			for (FSceneOutlinerTreeItemPtr Item : RootItems)
+			if (!FSceneOutlinerFingerprints::ShouldSkip(SOutliner.Get(), FSceneOutlinerFingerprints::CollapseToRootPolicy))
 			{
-				if (Item)
-				{
-					SOutliner->SetItemExpansion(Item, true);
-				}
+				CollapseToRoot(Batch, SOutliner.Get());
+				AppliedOutliners.Add(&SOutliner.Get());
 			}
 			bAllCollapsed &= true;
 		}
@@ -307,21 +654,49 @@ bool FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutlinersToRoot()
 		OUTLINER_SHORTCUTS_ERROR_H("Not able to get any `SSceneOutliner`");
 	}
 
+	Batch.Commit();
+	for (SSceneOutliner* SOutliner : AppliedOutliners)
+	{
+		FSceneOutlinerFingerprints::Record(*SOutliner, FSceneOutlinerFingerprints::CollapseToRootPolicy);
+	}
 	return bAllCollapsed;
 }
 
 bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandAllOutliners()
 {
 	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerExpandAllOutliners);
+	// Pressing the shortcut again while a time sliced expansion is running cancels it
+	if (CancelTimeSlicedExpansion())
+	{
+		return true;
+	}
 
 	bool bAllExpanded = true;
 
-	TArray<SSceneOutliner*> SOutliners = GetAllSSceneOutliners();
-	for (SSceneOutliner* SOutliner : SOutliners)
+	const bool bTimeSliced = ShouldTimeSliceExpandAll();
+	TArray<SSceneOutliner*> TimeSlicedOutliners;
+	FSceneOutlinerExpansionBatch Batch;
+	TArray<SSceneOutliner*> AppliedOutliners;
+
+	const TArray<TSharedRef<SSceneOutliner>> SOutliners = GetAllSSceneOutliners();
+	for (const TSharedRef<SSceneOutliner>& SOutliner : SOutliners)
 	{
-		if (IsSceneOutlinerReady(SOutliner))
+		if (IsSceneOutlinerReady(&SOutliner.Get()))
 		{
-			SOutliner->ExpandAll();
+			if (FSceneOutlinerFingerprints::ShouldSkip(SOutliner.Get(), FSceneOutlinerFingerprints::ExpandAllPolicy))
+			{
+				// Already expanded
+			}
+			else if (bTimeSliced)
+			{
+				TimeSlicedOutliners.Add(&SOutliner.Get());
+			}
+			else
+			{
+				Batch.ExpandAll(SOutliner.Get());
+				AppliedOutliners.Add(&SOutliner.Get());
+			}
 			bAllExpanded &= true;
 		}
 		else
@@ -336,10 +711,155 @@ bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandAllOutliners()
 		OUTLINER_SHORTCUTS_ERROR_H("Not able to get any `SSceneOutliner`");
 	}
 
+	Batch.Commit();
+	for (SSceneOutliner* SOutliner : AppliedOutliners)
+	{
+		FSceneOutlinerFingerprints::Record(*SOutliner, FSceneOutlinerFingerprints::ExpandAllPolicy);
+	}
+
+	if (TimeSlicedOutliners.Num() > 0)
+	{
+		bAllExpanded &= FSceneOutlinerTimeSlicedExpansion::Get()->Start(TimeSlicedOutliners);
+	}
+
 	return bAllExpanded;
 }
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerRestoreLastStateAllOutliners()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerRestoreLastStateAllOutliners);
+	CancelTimeSlicedExpansion();
+
+	FSceneOutlinerExpansionCache* ExpansionCache = FSceneOutlinerExpansionCache::Get();
+	bool bAllRestored = true;
+	FSceneOutlinerExpansionBatch Batch;
+
+	const TArray<TSharedRef<SSceneOutliner>> SOutliners = GetAllSSceneOutliners();
+	for (const TSharedRef<SSceneOutliner>& SOutliner : SOutliners)
+	{
+		if (IsSceneOutlinerReady(&SOutliner.Get()))
+		{
+			if (!ExpansionCache || !ExpansionCache->RestoreExpansion(Batch, SOutliner.Get()))
+			{
+				OUTLINER_SHORTCUTS_LOG_D("No expansion state saved for this map, collapsing `%s` to root", *SOutliner->GetOutlinerIdentifier().ToString());
+				CollapseToRoot(Batch, SOutliner.Get());
+			}
+		}
+		else
+		{
+			bAllRestored = false;
+			OUTLINER_SHORTCUTS_WARN_H("SceneOutliner `%s` is not ready", *SOutliner->GetOutlinerIdentifier().ToString());
+		}
+	}
+
+	if (SOutliners.Num() == 0)
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("Not able to get any `SSceneOutliner`");
+	}
+
+	return bAllRestored;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerExpandMatchingFoldersAllOutliners()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerExpandMatchingFoldersAllOutliners);
+	CancelTimeSlicedExpansion();
+
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!EditorSettings)
+	{
+		OUTLINER_SHORTCUTS_WARN_H("Unable to get `UOutlinerShortcutsEditorSettings`...");
+		return false;
+	}
+
+	const FFolderPathMatcher& Matcher = EditorSettings->GetFolderPatternMatcher();
+	bool bAllExpanded = true;
+	FSceneOutlinerExpansionBatch Batch;
+
+	const TArray<TSharedRef<SSceneOutliner>> SOutliners = GetAllSSceneOutliners();
+	for (const TSharedRef<SSceneOutliner>& SOutliner : SOutliners)
+	{
+		if (IsSceneOutlinerReady(&SOutliner.Get()))
+		{
+			ExpandMatchingFolders(Batch, SOutliner.Get(), Matcher);
+		}
+		else
+		{
+			bAllExpanded = false;
+			OUTLINER_SHORTCUTS_WARN_H("SceneOutliner `%s` is not ready", *SOutliner->GetOutlinerIdentifier().ToString());
+		}
+	}
+
+	if (SOutliners.Num() == 0)
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("Not able to get any `SSceneOutliner`");
+	}
+
+	return bAllExpanded;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerMirrorExpansion()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(SceneOutlinerMirrorExpansion);
+	CancelTimeSlicedExpansion();
+
+	FSceneOutlinerExpansionMirror* Mirror = FSceneOutlinerExpansionMirror::Get();
+	if (!Mirror)
+	{
+		return false;
+	}
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		if (Mirror->MirrorFrom(*SOutliner))
+		{
+			return true;
+		}
+		OUTLINER_SHORTCUTS_WARN_H("No other ready SceneOutliner to mirror `%s` to", *SOutliner->GetOutlinerIdentifier().ToString());
+	}
+	return false;
+}
+
+bool FOutlinerShortcutsEditorModule::SceneOutlinerToggleLiveExpansionMirror()
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	FSceneOutlinerExpansionMirror* Mirror = FSceneOutlinerExpansionMirror::Get();
+	if (!Mirror)
+	{
+		return false;
+	}
+
+	if (Mirror->IsLiveMirrorRunning())
+	{
+		Mirror->StopLiveMirror();
+		return true;
+	}
+
+	if (SSceneOutliner* SOutliner = GetReadySSceneOutliner())
+	{
+		CancelTimeSlicedExpansion();
+		Mirror->StartLiveMirror(*SOutliner);
+		return true;
+	}
+	return false;
+}
 #endif
 
+bool FOutlinerShortcutsEditorModule::ShouldTimeSliceExpandAll()
+{
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	return EditorSettings && EditorSettings->bTimeSliceExpandAll && FSceneOutlinerTimeSlicedExpansion::Get();
+}
+
+bool FOutlinerShortcutsEditorModule::CancelTimeSlicedExpansion()
+{
+	FSceneOutlinerTimeSlicedExpansion* TimeSlicedExpansion = FSceneOutlinerTimeSlicedExpansion::Get();
+	return TimeSlicedExpansion && TimeSlicedExpansion->Cancel();
+}
+
 ISceneOutliner* FOutlinerShortcutsEditorModule::GetISceneOutliner()
 {
 #if PRE_UE5_1
@@ -355,17 +875,17 @@ ISceneOutliner* FOutlinerShortcutsEditorModule::GetISceneOutliner()
 			}
 			else
 			{
-				OUTLINER_SHORTCUTS_ERROR_H("Not able to get an `ISceneOutliner` through `LevelEditor->GetSceneOutliner()");
+				OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to get an `ISceneOutliner` through `LevelEditor->GetSceneOutliner()");
 			}
 		}
 		else
 		{
-			OUTLINER_SHORTCUTS_ERROR_H("Not able to get an `ILevelEditor` through `LevelEditorModule->GetFirstLevelEditor()`");
+			OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to get an `ILevelEditor` through `LevelEditorModule->GetFirstLevelEditor()`");
 		}
 	}
 	else
 	{
-		OUTLINER_SHORTCUTS_ERROR_H("Not able to load `LevelEditor` module");
+		OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to load `LevelEditor` module");
 	}
 
 	return nullptr;
@@ -385,14 +905,23 @@ SSceneOutliner* FOutlinerShortcutsEditorModule::GetSSceneOutliner()
 		}
 		else
 		{
-			OUTLINER_SHORTCUTS_ERROR_H("Not able to convert `ISceneOutliner` to `SSceneOutliner`");
+			OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to convert `ISceneOutliner` to `SSceneOutliner`");
 		}
 	}
 	else
 	{
-		OUTLINER_SHORTCUTS_ERROR_H("Not able to get `SceneOutliner`");
+		OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to get `SceneOutliner`");
 	}
 #else
+	// The tracker keeps the Outliners sorted from their tab activation events, so we don't need to go through all the tabs
+	if (FSceneOutlinerTracker* Tracker = FSceneOutlinerTracker::Get())
+	{
+		if (const TSharedPtr<SSceneOutliner> SOutliner = Tracker->GetMostRecentlyUsedOutliner())
+		{
+			return SOutliner.Get();
+		}
+	}
+
 	const FLevelEditorModule* LevelEditorModule = FModuleManager::LoadModulePtr<FLevelEditorModule>("LevelEditor");
 	if (LevelEditorModule)
 	{
@@ -445,7 +974,7 @@ SSceneOutliner* FOutlinerShortcutsEditorModule::GetSSceneOutliner()
 			}
 			else
 			{
-				OUTLINER_SHORTCUTS_ERROR_H("Not able to get the TabManager throguh `LevelEditor->GetTabManager()`");
+				OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to get the TabManager throguh `LevelEditor->GetTabManager()`");
 			}
 
 			// if all the above fails, we fallback on the default one
@@ -454,12 +983,12 @@ SSceneOutliner* FOutlinerShortcutsEditorModule::GetSSceneOutliner()
 		}
 		else
 		{
-			OUTLINER_SHORTCUTS_ERROR_H("Not able to get an `ILevelEditor` through `LevelEditorModule->GetFirstLevelEditor()`");
+			OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to get an `ILevelEditor` through `LevelEditorModule->GetFirstLevelEditor()`");
 		}
 	}
 	else
 	{
-		OUTLINER_SHORTCUTS_ERROR_H("Not able to load `LevelEditor` module");
+		OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to load `LevelEditor` module");
 	}
 #endif
 
@@ -467,66 +996,49 @@ SSceneOutliner* FOutlinerShortcutsEditorModule::GetSSceneOutliner()
 }
 
 #if UE5_1_ONWARDS
-TArray<ISceneOutliner*> FOutlinerShortcutsEditorModule::GetAllISceneOutliners()
+TArray<TSharedRef<ISceneOutliner>> FOutlinerShortcutsEditorModule::GetAllISceneOutliners()
 {
-	TArray<ISceneOutliner*> Outliners;
-#if PRE_UE5_1
-	if (ISceneOutliner* SceneOutliner = GetISceneOutliner())
+	TArray<TSharedRef<ISceneOutliner>> Outliners;
+	for (const TSharedRef<SSceneOutliner>& SOutliner : GetAllSSceneOutliners())
 	{
-		Outliners.Add(SceneOutliner);
+		Outliners.Add(SOutliner);
 	}
-#else
-	const FLevelEditorModule* LevelEditorModule = FModuleManager::LoadModulePtr<FLevelEditorModule>("LevelEditor");
-	if (LevelEditorModule)
+	return Outliners;
+}
+
+TArray<TSharedRef<SSceneOutliner>> FOutlinerShortcutsEditorModule::GetAllSSceneOutliners()
+{
+	TArray<TSharedRef<SSceneOutliner>> SOutliners;
+
+	if (FSceneOutlinerTracker* Tracker = FSceneOutlinerTracker::Get())
+	{
+		SOutliners = Tracker->GetAllOutliners();
+	}
+	else if (const FLevelEditorModule* LevelEditorModule = FModuleManager::LoadModulePtr<FLevelEditorModule>("LevelEditor"))
 	{
 		if (const ILevelEditor* LevelEditor = LevelEditorModule->GetFirstLevelEditor().Get())
 		{
-			for (TWeakPtr<ISceneOutliner> SceneOutliner : LevelEditor->GetAllSceneOutliners())
+			for (const TWeakPtr<ISceneOutliner>& WeakOutliner : LevelEditor->GetAllSceneOutliners())
 			{
-				if (SceneOutliner.IsValid() && SceneOutliner.Pin().Get())
-				{
-					Outliners.Add(SceneOutliner.Pin().Get());
-				}
-				else
+				if (const TSharedPtr<ISceneOutliner> SceneOutliner = WeakOutliner.Pin())
 				{
-					OUTLINER_SHORTCUTS_ERROR_H("Not able to get `SceneOutliner`");
+					SOutliners.Add(StaticCastSharedRef<SSceneOutliner>(SceneOutliner.ToSharedRef()));
 				}
 			}
 		}
 		else
 		{
-			OUTLINER_SHORTCUTS_ERROR_H("Not able to get `LevelEditor`");
+			OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to get `LevelEditor`");
 		}
 	}
 	else
 	{
-		OUTLINER_SHORTCUTS_ERROR_H("Not able to load `LevelEditor` module");
-	}
-#endif
-	
-	return Outliners;
-}
-
-TArray<SSceneOutliner*> FOutlinerShortcutsEditorModule::GetAllSSceneOutliners()
-{
-	TArray<SSceneOutliner*> SOutliners;
-
-	TArray<ISceneOutliner*> SceneOutliners = GetAllISceneOutliners();
-	for (ISceneOutliner* SceneOutliner : SceneOutliners)
-	{
-		if (SSceneOutliner* SOutliner = static_cast<SSceneOutliner*>(SceneOutliner))
-		{
-			SOutliners.Add(SOutliner);
-		}
-		else
-		{
-			OUTLINER_SHORTCUTS_ERROR_H("Not able to convert `ISceneOutliner` to `SSceneOutliner`");
-		}
+		OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to load `LevelEditor` module");
 	}
 
 	if (SOutliners.Num() == 0)
 	{
-		OUTLINER_SHORTCUTS_ERROR_H("Not able to get any `SceneOutliner`");
+		OUTLINER_SHORTCUTS_ERROR_H_RL("Not able to get any `SceneOutliner`");
 	}
 
 	return SOutliners;
@@ -551,79 +1063,208 @@ FSceneOutlinerTreeItemPtr FOutlinerShortcutsEditorModule::GetWorldTreeItemPtr(SS
 		}
 		else
 		{
-			OUTLINER_SHORTCUTS_WARN_H("Editor World is null");
+			OUTLINER_SHORTCUTS_WARN_H_RL("Editor World is null");
 		}
 	}
 	else
 	{
-		OUTLINER_SHORTCUTS_WARN_H("`SceneOutliner` is null");
+		OUTLINER_SHORTCUTS_WARN_H_RL("`SceneOutliner` is null");
 	}
 	return FSceneOutlinerTreeItemPtr(nullptr);
 }
 
+ESceneOutlinerReadiness FOutlinerShortcutsEditorModule::GetSceneOutlinerReadiness(SSceneOutliner* SceneOutliner)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(GetSceneOutlinerReadiness);
+	if (!SceneOutliner)
+	{
+		OUTLINER_SHORTCUTS_WARN_H_RL("`SceneOutliner` is null");
+		return ESceneOutlinerReadiness::Unsupported;
+	}
+
+	// Without a hierarchy, nothing will ever populate the Outliner
+	ISceneOutlinerMode* Mode = const_cast<ISceneOutlinerMode*>(SceneOutliner->GetMode());
+	if (!Mode || !Mode->GetHierarchy())
+	{
+		return ESceneOutlinerReadiness::Unsupported;
+	}
+
+	// Actor modes: this is the only lookup needed, and the common case
+	if (GetWorldTreeItemPtr(SceneOutliner).IsValid())
+	{
+		return ESceneOutlinerReadiness::Ready;
+	}
+
+	// Other modes are ready once their roots are shown. A world item at the root is the one of the previous map, still waiting for the new one.
+	bool bHasRootItems = false;
+	const TArray<FSceneOutlinerTreeItemPtr>& Rows = SceneOutliner->GetTree().GetItems();
+	for (const FSceneOutlinerTreeItemPtr& Item : Rows)
+	{
+		if (Item && !Item->GetParent().IsValid())
+		{
+			if (Item->IsA<FWorldTreeItem>())
+			{
+				return ESceneOutlinerReadiness::Pending;
+			}
+			bHasRootItems = true;
+		}
+	}
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, Rows.Num());
+	return bHasRootItems ? ESceneOutlinerReadiness::Ready : ESceneOutlinerReadiness::Pending;
+}
+
 bool FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(SSceneOutliner* SceneOutliner)
 {
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(IsSceneOutlinerReady);
 	//OUTLINER_SHORTCUTS_HERE;
-	return GetWorldTreeItemPtr(SceneOutliner).IsValid();
+	return GetSceneOutlinerReadiness(SceneOutliner) == ESceneOutlinerReadiness::Ready;
+}
+
+
+SSceneOutliner* FOutlinerShortcutsEditorModule::GetReadySSceneOutliner()
+{
+	if (SSceneOutliner* SOutliner = GetSSceneOutliner())
+	{
+		const ESceneOutlinerReadiness Readiness = GetSceneOutlinerReadiness(SOutliner);
+		if (Readiness == ESceneOutlinerReadiness::Ready)
+		{
+			return SOutliner;
+		}
+		const TCHAR* Reason = Readiness == ESceneOutlinerReadiness::Unsupported ? TEXT("has no hierarchy to display") : TEXT("is not ready");
+#if PRE_UE5_1
+		OUTLINER_SHORTCUTS_WARN_H("SceneOutliner %s", Reason);
+#else
+		OUTLINER_SHORTCUTS_WARN_H("SceneOutliner `%s` %s", *SOutliner->GetOutlinerIdentifier().ToString(), Reason);
+#endif
+	}
+	else
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("Not able to get `SSceneOutliner`");
+	}
+	return nullptr;
 }
 
+void FOutlinerShortcutsEditorModule::WithExpansionFrontier(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, TFunctionRef<void(ISceneOutlinerTreeModel&, FSceneOutlinerExpansionFrontier&)> Function)
+{
+	FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get();
+	if (HierarchyIndex && HierarchyIndex->WithExpansionFrontier(SOutliner, Batch, Function))
+	{
+		return;
+	}
+
+	FSceneOutlinerWidgetTreeModel TransientModel(SOutliner, &Batch);
+	FSceneOutlinerExpansionFrontier TransientFrontier;
+	Function(TransientModel, TransientFrontier);
+}
 
 TArray<FSceneOutlinerTreeItemPtr> FOutlinerShortcutsEditorModule::GetSceneOutlinerRootItems(SSceneOutliner* SOutliner)
 {
-	TArray<FSceneOutlinerTreeItemPtr> RootItems;
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(GetSceneOutlinerRootItems);
+	if (!SOutliner)
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("`SSceneOutliner` given is null");
+		return TArray<FSceneOutlinerTreeItemPtr>();
+	}
+
+	// The roots are kept up to date from the hierarchy events of the Outliner, so we don't need to go through all the items.
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		return HierarchyIndex->GetRootItems(SOutliner);
+	}
+	return FSceneOutlinerHierarchyIndex::FindRootItems(SOutliner);
+}
+
+void FOutlinerShortcutsEditorModule::CollapseToRoot(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner)
+{
+	FSceneOutlinerWidgetTreeModel Model(SOutliner, &Batch);
+	FSceneOutlinerTreePolicies::CollapseToRoot(Model);
+}
 
-	if (SOutliner)
+void FOutlinerShortcutsEditorModule::ExpandMatchingFolders(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FFolderPathMatcher& Matcher)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ExpandMatchingFolders);
+	if (Matcher.IsEmpty())
 	{
-		// The only way so far to access all the items of the TreeView is via "SetSelection"
-		// So we are first saving the selection, then going through all of it via SetSelection, returning the same results
+		OUTLINER_SHORTCUTS_LOG_H("No folder expansion pattern set in the settings, collapsing to root");
+	}
 
-		TArray<FSceneOutlinerTreeItemPtr> Selection = SOutliner->GetSelectedItems();
+	FSceneOutlinerWidgetTreeModel Model(SOutliner, &Batch);
+	FSceneOutlinerTreePolicies::ExpandMatchingFolders(Model, Matcher);
+}
+
+int32 FOutlinerShortcutsEditorModule::SetSelectedSubtreesExpansion(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, bool bExpand)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(SetSelectedSubtreesExpansion);
+
+	// The Outliner selection also holds the selected folders, the selected actors are only needed when it is empty
+	TArray<FSceneOutlinerTreeItemPtr> SelectedItems = SOutliner.GetSelectedItems();
+	if (SelectedItems.Num() == 0)
+	{
+		SelectedItems = FSceneOutlinerSelectionReveal::GetSelectedItems(SOutliner);
+	}
+	if (SelectedItems.Num() == 0)
+	{
+		OUTLINER_SHORTCUTS_LOG_H("Nothing selected to %s", bExpand ? TEXT("expand") : TEXT("collapse"));
+		return 0;
+	}
 
-		// As we are not able to compare ISceneOutlinerTreeItems, we get their IDs.
-		TSet<FSceneOutlinerTreeItemID> SelectionID;
-		for (FSceneOutlinerTreeItemPtr SelectedItemPtr : Selection)
+	// Only the selected subtrees are interned, the rest of the tree is never reached
+	FSceneOutlinerWidgetTreeModel Model(SOutliner, &Batch);
+	TArray<int32> Items;
+	Items.Reserve(SelectedItems.Num());
+	for (const FSceneOutlinerTreeItemPtr& Item : SelectedItems)
+	{
+		if (Item)
 		{
-			if (const ISceneOutlinerTreeItem* SelectedItem = SelectedItemPtr.Get())
-			{
-				SelectionID.Add(SelectedItem->GetID());
-			}
+			Items.Add(Model.Intern(Item));
 		}
+	}
 
-		//OUTLINER_SHORTCUTS_WARN("Setting Selection");
+	const int32 NumVisited = FSceneOutlinerTreePolicies::SetSubtreesExpansion(Model, Items, bExpand);
+	OUTLINER_SHORTCUTS_LOG_D("%s %d items under %d selected items", bExpand ? TEXT("Expanded") : TEXT("Collapsed"), NumVisited, Items.Num());
+	return NumVisited;
+}
 
-		SOutliner->SetSelection([&RootItems, SOutliner, SelectionID](const ISceneOutlinerTreeItem& Item)
-			{
-				const FSceneOutlinerTreeItemID ItemID = Item.GetID();
+int32 FOutlinerShortcutsEditorModule::ExpandParentsOfClasses(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const TArray<UClass*>& Classes, bool bCollapseOthers)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ExpandParentsOfClasses);
+	if (Classes.Num() == 0)
+	{
+		OUTLINER_SHORTCUTS_WARN_H("No class set in `Focused Actor Classes`");
+		return 0;
+	}
 
-				//OUTLINER_SHORTCUTS_LOG(" - `%s`", *Item.GetDisplayString());
-				if (ISceneOutlinerTreeItem* Parent = Item.GetParent().Get())
-				{
-					//OUTLINER_SHORTCUTS_LOG("    Parent: `%s`", *Parent->GetDisplayString());
-				}
-				else
-				{
-					//OUTLINER_SHORTCUTS_LOG_H("  Root Item: `%s`", *Item.GetDisplayString());
-					const FSceneOutlinerTreeItemPtr ItemPtr = SOutliner->GetTreeItem(ItemID);
-					if (ItemPtr)
-					{
-						RootItems.Add(ItemPtr); // if the item does not have a parent, it is a root
-					}
-					else
-					{
-						OUTLINER_SHORTCUTS_ERROR_H("     => Impossible to find its reference");
-					}
-				}
+	// The actors come from the class index and their items from a map lookup, the rest of the tree is never visited
+	TArray<FObjectKey> ActorKeys;
+	if (FSceneOutlinerActorClassIndex* ClassIndex = FSceneOutlinerActorClassIndex::Get())
+	{
+		ClassIndex->GatherActors(Classes, ActorKeys);
+	}
 
-				return SelectionID.Contains(ItemID);
-			});
+	TArray<FSceneOutlinerTreeItemPtr> Items;
+	Items.Reserve(ActorKeys.Num());
+	for (const FObjectKey& ActorKey : ActorKeys)
+	{
+		if (FSceneOutlinerTreeItemPtr Item = SOutliner.GetTreeItem(FSceneOutlinerTreeItemID(ActorKey)))
+		{
+			Items.Add(MoveTemp(Item));
+		}
+	}
 
-		//SOutliner->SetItemSelection(Selection, true, ESelectInfo::Direct);
+	TMap<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>> Path;
+	FSceneOutlinerSelectionReveal::GatherParents(Items, Path);
+	if (bCollapseOthers)
+	{
+		FSceneOutlinerSelectionReveal::CollapseOutsidePath(Batch, SOutliner, Path);
 	}
-	else
+	for (const TPair<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>& Parent : Path)
 	{
-		OUTLINER_SHORTCUTS_ERROR_H("`SSceneOutliner` given is null");
+		Batch.SetItemExpansion(SOutliner, Parent.Value.Pin(), true);
 	}
-	return RootItems;
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, ActorKeys.Num() + Path.Num());
+	OUTLINER_SHORTCUTS_LOG_D("Found %d actors of %d classes in the Outliner, expanding %d parents", Items.Num(), Classes.Num(), Path.Num());
+	return Items.Num();
 }
 
 void OutlinerShortcutsCommands::RegisterCommands()
@@ -631,11 +1272,24 @@ void OutlinerShortcutsCommands::RegisterCommands()
 	UI_COMMAND(SceneOutlinerCollapseAll, "Collapse All", "Collapse all Actors and Folders in the current Scene Outliner", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(SceneOutlinerCollapseToRoot, "Collapse to Root", "Collapse all Actors and Folders in the current Scene Outliner but keep the root element expanded", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(SceneOutlinerExpandAll, "Expand All", "Expand all Actors and Folders in the current Scene Outliner", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerExpandToDepth, "Expand to Depth", "Expand the current Scene Outliner down to the depth set in the Outliner Shortcuts settings, and collapse the deeper items", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerExpandOneLevel, "Expand One More Level", "Expand one more level of Actors and Folders in the current Scene Outliner", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerCollapseOneLevel, "Collapse One Level", "Collapse the deepest expanded level of Actors and Folders in the current Scene Outliner", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerRevealSelection, "Reveal Selection", "Collapse the current Scene Outliner and expand only the parents of the selected Actors", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerExpandMatchingFolders, "Expand Matching Folders", "Collapse the current Scene Outliner and expand only the folders matching the Folder Expansion Patterns set in the Outliner Shortcuts settings", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerExpandFocusedClasses, "Expand Focused Classes", "Expand the parents of the actors of the Focused Actor Classes set in the Outliner Shortcuts settings in the current Scene Outliner", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerCollapseAllExceptFocusedClasses, "Collapse All Except Focused Classes", "Collapse the current Scene Outliner except the parents of the actors of the Focused Actor Classes set in the Outliner Shortcuts settings", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerExpandSelectedRecursively, "Expand Selected Recursively", "Expand the selected items and all the Actors and Folders under them in the current Scene Outliner", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerCollapseSelectedRecursively, "Collapse Selected Recursively", "Collapse the selected items and all the Actors and Folders under them in the current Scene Outliner", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerFindAndReveal, "Find and Reveal", "Open a popup finding the Actors and Folders of the current map by label, and expand only the parents of the one picked in the current Scene Outliner", EUserInterfaceActionType::Button, FInputChord());
 	
 #if UE5_1_ONWARDS
 	UI_COMMAND(SceneOutlinerCollapseAllOutliners, "Collapse All Outliners", "[UE 5.1 Onwards] Collapse all Actors and Folders in ALL Scene Outliners", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(SceneOutlinerCollapseAllOutlinersToRoot, "Collapse All Outliners to Root", "[UE 5.1 Onwards] Collapse all Actors and Folders in ALL Scene Outliners but keep their root element expanded", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(SceneOutlinerExpandAllOutliners, "Expand All Outliners", "[UE 5.1 Onwards] Expand all Actors and Folders in ALL Scene Outliners", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerExpandMatchingFoldersAllOutliners, "Expand Matching Folders in All Outliners", "[UE 5.1 Onwards] Collapse ALL Scene Outliners and expand only the folders matching the Folder Expansion Patterns set in the Outliner Shortcuts settings", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerMirrorExpansion, "Mirror Expansion to Other Outliners", "[UE 5.1 Onwards] Copy the expansion of the current Scene Outliner to the other opened Scene Outliners", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(SceneOutlinerToggleLiveExpansionMirror, "Toggle Live Expansion Mirror", "[UE 5.1 Onwards] Start or stop copying the expansion changes of the current Scene Outliner to the other opened Scene Outliners as they happen", EUserInterfaceActionType::Button, FInputChord());
 #endif
 
 	OUTLINER_SHORTCUTS_LOG("Commands Registered");
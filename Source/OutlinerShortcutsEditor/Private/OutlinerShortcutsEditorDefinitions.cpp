@@ -2,4 +2,61 @@
 
 #include "OutlinerShortcutsEditorDefinitions.h"
 
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
 DEFINE_LOG_CATEGORY(LogOutlinerShortcutsEditor);
+
+namespace
+{
+	// Call sites can log from any thread, the lock is only taken by the rate limited macros
+	FCriticalSection& GetLogLimiterLock()
+	{
+		static FCriticalSection Lock;
+		return Lock;
+	}
+
+	FOutlinerShortcutsLogLimiter*& GetLogLimiterHead()
+	{
+		static FOutlinerShortcutsLogLimiter* Head = nullptr;
+		return Head;
+	}
+}
+
+FOutlinerShortcutsLogLimiter::FOutlinerShortcutsLogLimiter(const ANSICHAR* InFunction, int32 InLine)
+	: Function(InFunction)
+	, Line(InLine)
+{
+	FScopeLock Lock(&GetLogLimiterLock());
+	Next = GetLogLimiterHead();
+	GetLogLimiterHead() = this;
+}
+
+bool FOutlinerShortcutsLogLimiter::ShouldLog(int32& OutNumSuppressed)
+{
+	const double Now = FPlatformTime::Seconds();
+	FScopeLock Lock(&GetLogLimiterLock());
+	if (Now < NextAllowedTime)
+	{
+		++NumSuppressed;
+		++TotalSuppressed;
+		return false;
+	}
+
+	NextAllowedTime = Now + OUTLINER_SHORTCUTS_LOG_RATE_LIMIT_SECONDS;
+	OutNumSuppressed = NumSuppressed;
+	NumSuppressed = 0;
+	return true;
+}
+
+void FOutlinerShortcutsLogLimiter::LogSummary()
+{
+	FScopeLock Lock(&GetLogLimiterLock());
+	for (FOutlinerShortcutsLogLimiter* Limiter = GetLogLimiterHead(); Limiter; Limiter = Limiter->Next)
+	{
+		if (Limiter->TotalSuppressed > 0)
+		{
+			UE_LOG(LogOutlinerShortcutsEditor, Display, TEXT("[%hs:%d]  %d messages suppressed during the session"), Limiter->Function, Limiter->Line, Limiter->TotalSuppressed);
+		}
+	}
+}
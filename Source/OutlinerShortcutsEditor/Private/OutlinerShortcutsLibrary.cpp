@@ -0,0 +1,282 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "OutlinerShortcutsLibrary.h"
+
+#include "OutlinerShortcutsEditor.h"
+#include "SSceneOutliner.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "SceneOutlinerExpansionFrontier.h"
+#include "SceneOutlinerExpansionCache.h"
+#include "SceneOutlinerFingerprints.h"
+#include "OutlinerShortcutsStats.h"
+#include "OutlinerShortcutsSettings.h"
+
+#include "Algo/AllOf.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	FOutlinerShortcutsOperation MakeOperation(EOutlinerShortcutsOperationType Type, int32 Depth = 1)
+	{
+		FOutlinerShortcutsOperation Operation;
+		Operation.Type = Type;
+		Operation.Depth = Depth;
+		return Operation;
+	}
+
+	// Returns the Outliners with the given identifiers, or the most recently used one if none is given
+	TArray<SSceneOutliner*> FindOutliners(const TArray<FName>& OutlinerIds, bool& bOutAllFound)
+	{
+		TArray<SSceneOutliner*> SOutliners;
+		bOutAllFound = true;
+
+#if UE5_1_ONWARDS
+		if (OutlinerIds.Num() > 0)
+		{
+			const TArray<TSharedRef<SSceneOutliner>> AllOutliners = FOutlinerShortcutsEditorModule::GetAllSSceneOutliners();
+			for (const FName& OutlinerId : OutlinerIds)
+			{
+				const TSharedRef<SSceneOutliner>* SOutliner = AllOutliners.FindByPredicate([&OutlinerId](const TSharedRef<SSceneOutliner>& Candidate) { return Candidate->GetOutlinerIdentifier() == OutlinerId; });
+				if (SOutliner)
+				{
+					SOutliners.AddUnique(&SOutliner->Get());
+				}
+				else
+				{
+					bOutAllFound = false;
+					OUTLINER_SHORTCUTS_WARN_H("No opened Outliner with the identifier `%s`", *OutlinerId.ToString());
+				}
+			}
+			return SOutliners;
+		}
+#endif
+
+		if (SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner())
+		{
+			SOutliners.Add(SOutliner);
+		}
+		else
+		{
+			bOutAllFound = false;
+		}
+		return SOutliners;
+	}
+
+	void AddOperation(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FOutlinerShortcutsOperation& Operation)
+	{
+		switch (Operation.Type)
+		{
+		case EOutlinerShortcutsOperationType::CollapseAll:
+			Batch.CollapseAll(SOutliner);
+			break;
+		case EOutlinerShortcutsOperationType::CollapseToRoot:
+			FOutlinerShortcutsEditorModule::CollapseToRoot(Batch, SOutliner);
+			break;
+		case EOutlinerShortcutsOperationType::ExpandAll:
+			Batch.ExpandAll(SOutliner);
+			break;
+		case EOutlinerShortcutsOperationType::ExpandToDepth:
+			FOutlinerShortcutsEditorModule::WithExpansionFrontier(Batch, SOutliner, [&Operation](ISceneOutlinerTreeModel& Model, FSceneOutlinerExpansionFrontier& Frontier)
+				{
+					Frontier.ExpandToDepth(Model, Operation.Depth);
+				});
+			break;
+		case EOutlinerShortcutsOperationType::RestoreLastState:
+		{
+			FSceneOutlinerExpansionCache* ExpansionCache = FSceneOutlinerExpansionCache::Get();
+			if (!ExpansionCache || !ExpansionCache->RestoreExpansion(Batch, SOutliner))
+			{
+				FOutlinerShortcutsEditorModule::CollapseToRoot(Batch, SOutliner);
+			}
+			break;
+		}
+		case EOutlinerShortcutsOperationType::ExpandMatchingFolders:
+			if (const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance())
+			{
+				FOutlinerShortcutsEditorModule::ExpandMatchingFolders(Batch, SOutliner, EditorSettings->GetFolderPatternMatcher());
+			}
+			break;
+		case EOutlinerShortcutsOperationType::ExpandFocusedClasses:
+		case EOutlinerShortcutsOperationType::CollapseAllExceptFocusedClasses:
+			if (const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance())
+			{
+				const bool bCollapseOthers = Operation.Type == EOutlinerShortcutsOperationType::CollapseAllExceptFocusedClasses;
+				FOutlinerShortcutsEditorModule::ExpandParentsOfClasses(Batch, SOutliner, EditorSettings->GetFocusedActorClasses(), bCollapseOthers);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Returns the fingerprint policy of the operations, or None if they can't be skipped
+	FName GetFingerprintPolicy(const TArray<FOutlinerShortcutsOperation>& Operations)
+	{
+		if (Operations.Num() != 1)
+		{
+			return NAME_None;
+		}
+		switch (Operations[0].Type)
+		{
+		case EOutlinerShortcutsOperationType::CollapseAll:
+			return FSceneOutlinerFingerprints::CollapseAllPolicy;
+		case EOutlinerShortcutsOperationType::CollapseToRoot:
+			return FSceneOutlinerFingerprints::CollapseToRootPolicy;
+		case EOutlinerShortcutsOperationType::ExpandAll:
+			return FSceneOutlinerFingerprints::ExpandAllPolicy;
+		case EOutlinerShortcutsOperationType::ExpandToDepth:
+			return FSceneOutlinerFingerprints::MakeExpandToDepthPolicy(Operations[0].Depth);
+		default:
+			// The result of the other operations depends on more than the hierarchy (saved state, settings)
+			return NAME_None;
+		}
+	}
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::ApplyOperations(const TArray<FOutlinerShortcutsOperation>& Operations, const TArray<FName>& OutlinerIds)
+{
+	OUTLINER_SHORTCUTS_HERE_D;
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(ApplyOperations);
+	FOutlinerShortcutsEditorModule::CancelTimeSlicedExpansion();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FOutlinerShortcutsBatchResult Result;
+	bool bAllFound = false;
+	const TArray<SSceneOutliner*> SOutliners = FindOutliners(OutlinerIds, bAllFound);
+	Result.bSuccess = bAllFound && SOutliners.Num() > 0;
+
+	const FName Policy = GetFingerprintPolicy(Operations);
+	TArray<SSceneOutliner*> AppliedOutliners;
+
+	FSceneOutlinerExpansionBatch Batch;
+	for (SSceneOutliner* SOutliner : SOutliners)
+	{
+		if (!FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(SOutliner))
+		{
+			Result.bSuccess = false;
+#if PRE_UE5_1
+			OUTLINER_SHORTCUTS_WARN_H("SceneOutliner is not ready");
+#else
+			OUTLINER_SHORTCUTS_WARN_H("SceneOutliner `%s` is not ready", *SOutliner->GetOutlinerIdentifier().ToString());
+#endif
+			continue;
+		}
+
+		if (!Policy.IsNone())
+		{
+			if (FSceneOutlinerFingerprints::ShouldSkip(*SOutliner, Policy))
+			{
+				continue;
+			}
+			AppliedOutliners.Add(SOutliner);
+		}
+
+		for (const FOutlinerShortcutsOperation& Operation : Operations)
+		{
+			AddOperation(Batch, *SOutliner, Operation);
+		}
+	}
+	Batch.Commit();
+
+	for (SSceneOutliner* SOutliner : AppliedOutliners)
+	{
+		FSceneOutlinerFingerprints::Record(*SOutliner, Policy);
+	}
+
+	const FSceneOutlinerExpansionBatch::FStats& Stats = Batch.GetStats();
+	Result.OutlinersTouched = Stats.OutlinersTouched;
+	Result.ItemsVisited = Stats.ItemsVisited;
+	Result.ItemsExpanded = Stats.ItemsExpanded;
+	Result.ItemsCollapsed = Stats.ItemsCollapsed;
+	Result.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.);
+	return Result;
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::CollapseAll(const TArray<FName>& OutlinerIds)
+{
+	return ApplyOperations({ MakeOperation(EOutlinerShortcutsOperationType::CollapseAll) }, OutlinerIds);
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::CollapseToRoot(const TArray<FName>& OutlinerIds)
+{
+	return ApplyOperations({ MakeOperation(EOutlinerShortcutsOperationType::CollapseToRoot) }, OutlinerIds);
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::ExpandAll(const TArray<FName>& OutlinerIds)
+{
+	return ApplyOperations({ MakeOperation(EOutlinerShortcutsOperationType::ExpandAll) }, OutlinerIds);
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::ExpandToDepth(int32 Depth, const TArray<FName>& OutlinerIds)
+{
+	return ApplyOperations({ MakeOperation(EOutlinerShortcutsOperationType::ExpandToDepth, Depth) }, OutlinerIds);
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::RestoreLastState(const TArray<FName>& OutlinerIds)
+{
+	return ApplyOperations({ MakeOperation(EOutlinerShortcutsOperationType::RestoreLastState) }, OutlinerIds);
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::ExpandMatchingFolders(const TArray<FName>& OutlinerIds)
+{
+	return ApplyOperations({ MakeOperation(EOutlinerShortcutsOperationType::ExpandMatchingFolders) }, OutlinerIds);
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::ExpandFocusedClasses(const TArray<FName>& OutlinerIds)
+{
+	return ApplyOperations({ MakeOperation(EOutlinerShortcutsOperationType::ExpandFocusedClasses) }, OutlinerIds);
+}
+
+FOutlinerShortcutsBatchResult UOutlinerShortcutsLibrary::CollapseAllExceptFocusedClasses(const TArray<FName>& OutlinerIds)
+{
+	return ApplyOperations({ MakeOperation(EOutlinerShortcutsOperationType::CollapseAllExceptFocusedClasses) }, OutlinerIds);
+}
+
+TArray<FName> UOutlinerShortcutsLibrary::GetOutlinerIds()
+{
+	TArray<FName> OutlinerIds;
+#if UE5_1_ONWARDS
+	for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+	{
+		OutlinerIds.Add(SOutliner->GetOutlinerIdentifier());
+	}
+#endif
+	return OutlinerIds;
+}
+
+bool UOutlinerShortcutsLibrary::ParseOperation(const FString& Text, FOutlinerShortcutsOperation& OutOperation)
+{
+	FString Name = Text;
+	FString Argument;
+	const bool bHasArgument = Text.Split(TEXT("="), &Name, &Argument);
+
+	const int64 Value = StaticEnum<EOutlinerShortcutsOperationType>()->GetValueByNameString(Name.TrimStartAndEnd());
+	if (Value == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutOperation.Type = static_cast<EOutlinerShortcutsOperationType>(Value);
+	if (OutOperation.Type == EOutlinerShortcutsOperationType::ExpandToDepth)
+	{
+		if (!bHasArgument)
+		{
+			// Same depth as the keyboard shortcut
+			if (const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance())
+			{
+				OutOperation.Depth = EditorSettings->ExpandToDepth;
+			}
+			return true;
+		}
+
+		// Only whole numbers, `IsNumeric` would also take negative and decimal ones
+		Argument.TrimStartAndEndInline();
+		if (Argument.IsEmpty() || !Algo::AllOf(Argument, [](TCHAR Char) { return FChar::IsDigit(Char); }))
+		{
+			return false;
+		}
+		OutOperation.Depth = FCString::Atoi(*Argument);
+	}
+	return true;
+}
@@ -1,3 +1,60 @@
 // Copyright Voulz 2021-2022. All Rights Reserved.
 
 #include "OutlinerShortcutsSettings.h"
+
+#include "OutlinerShortcutsEditorDefinitions.h"
+#include "SSceneOutliner.h"
+#include "GameFramework/Actor.h"
+
+
+EOutlinerExpansionBehaviorOnMapOpen UOutlinerShortcutsEditorSettings::GetExpansionBehaviorOnMapOpen(const SSceneOutliner& SOutliner) const
+{
+#if UE5_1_ONWARDS
+	if (const EOutlinerExpansionBehaviorOnMapOpen* Override = OutlinerExpansionBehaviorOverrides.Find(SOutliner.GetOutlinerIdentifier()))
+	{
+		return *Override;
+	}
+#endif
+	return DefaultOutlinerExpansionBehaviorOnMapOpen;
+}
+
+TArray<UClass*> UOutlinerShortcutsEditorSettings::GetFocusedActorClasses() const
+{
+	TArray<UClass*> Classes;
+	for (const TSoftClassPtr<AActor>& FocusedClass : FocusedActorClasses)
+	{
+		if (UClass* Class = FocusedClass.LoadSynchronous())
+		{
+			Classes.Add(Class);
+		}
+	}
+	return Classes;
+}
+
+const FFolderPathMatcher& UOutlinerShortcutsEditorSettings::GetFolderPatternMatcher() const
+{
+	// Compiled on first use, the config is not loaded yet when the default object is constructed
+	if (bFolderPatternMatcherDirty)
+	{
+		FolderPatternMatcher.Compile(FolderExpansionPatterns);
+		bFolderPatternMatcherDirty = false;
+	}
+	return FolderPatternMatcher;
+}
+
+void UOutlinerShortcutsEditorSettings::PostReloadConfig(FProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+	bFolderPatternMatcherDirty = true;
+}
+
+#if WITH_EDITOR
+void UOutlinerShortcutsEditorSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UOutlinerShortcutsEditorSettings, FolderExpansionPatterns))
+	{
+		bFolderPatternMatcherDirty = true;
+	}
+}
+#endif
@@ -0,0 +1,175 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "OutlinerShortcutsStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+
+DEFINE_STAT(STAT_OutlinerShortcuts_ItemsVisited);
+DEFINE_STAT(STAT_OutlinerShortcuts_ItemsExpanded);
+DEFINE_STAT(STAT_OutlinerShortcuts_ItemsCollapsed);
+DEFINE_STAT(STAT_OutlinerShortcuts_OutlinersTouched);
+DEFINE_STAT(STAT_OutlinerShortcuts_FingerprintsChecked);
+DEFINE_STAT(STAT_OutlinerShortcuts_OutlinersSkipped);
+
+UE_TRACE_CHANNEL_DEFINE(OutlinerShortcutsChannel);
+
+namespace
+{
+	// Enough runs to get meaningful percentiles for a session, without growing forever
+	constexpr int32 MaxLatenciesPerCommand = 1024;
+
+	float GetPercentile(const TArray<float>& SortedValues, float Percentile)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return 0.f;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+}
+
+FOutlinerShortcutsStats::FScopedCommand* FOutlinerShortcutsStats::RunningCommand = nullptr;
+FOutlinerShortcutsStats* FOutlinerShortcutsStats::Instance = nullptr;
+
+FOutlinerShortcutsStats::FScopedCommand::FScopedCommand(const TCHAR* InCommandName)
+	: CommandName(InCommandName)
+	, StartTime(FPlatformTime::Seconds())
+	, Parent(RunningCommand)
+{
+	check(IsInGameThread());
+	RunningCommand = this;
+}
+
+FOutlinerShortcutsStats::FScopedCommand::~FScopedCommand()
+{
+	RunningCommand = Parent;
+	if (Instance)
+	{
+		Instance->RecordCommand(CommandName, FPlatformTime::Seconds() - StartTime, Counters);
+	}
+}
+
+void FOutlinerShortcutsStats::OnStartupModule()
+{
+	Instance = this;
+
+	DumpStatsCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.DumpStats"),
+		TEXT("Prints the p50/p95/max latency and the counters of each Outliner Shortcuts command run during this session"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateRaw(this, &FOutlinerShortcutsStats::DumpStats),
+		ECVF_Default);
+
+	ResetStatsCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("OutlinerShortcuts.ResetStats"),
+		TEXT("Forgets the latency and the counters recorded for the Outliner Shortcuts commands"),
+		FConsoleCommandDelegate::CreateRaw(this, &FOutlinerShortcutsStats::ResetStats),
+		ECVF_Default);
+}
+
+void FOutlinerShortcutsStats::OnShutdownModule()
+{
+	IConsoleManager::Get().UnregisterConsoleObject(DumpStatsCommand);
+	IConsoleManager::Get().UnregisterConsoleObject(ResetStatsCommand);
+	DumpStatsCommand = nullptr;
+	ResetStatsCommand = nullptr;
+
+	Histories.Empty();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FOutlinerShortcutsStats* FOutlinerShortcutsStats::Get()
+{
+	return Instance;
+}
+
+void FOutlinerShortcutsStats::AddToRunningCommands(int64 FCounters::* Counter, int64 Amount)
+{
+	if (!IsInGameThread())
+	{
+		return;
+	}
+	for (FScopedCommand* Command = RunningCommand; Command; Command = Command->Parent)
+	{
+		Command->Counters.*Counter += Amount;
+	}
+}
+
+void FOutlinerShortcutsStats::DumpStats(FOutputDevice& Ar) const
+{
+	if (Histories.Num() == 0)
+	{
+		Ar.Logf(TEXT("No Outliner Shortcuts command was run during this session"));
+		return;
+	}
+
+	Ar.Logf(TEXT("%-40s %8s %10s %10s %10s %12s %12s %12s %10s %10s"), TEXT("Command"), TEXT("Runs"), TEXT("p50 (ms)"), TEXT("p95 (ms)"), TEXT("Max (ms)"), TEXT("Visited"), TEXT("Expanded"), TEXT("Collapsed"), TEXT("Outliners"), TEXT("Skipped"));
+
+	TArray<FName> CommandNames;
+	Histories.GetKeys(CommandNames);
+	CommandNames.Sort(FNameLexicalLess());
+
+	FCounters Totals;
+	for (const FName& CommandName : CommandNames)
+	{
+		const FCommandHistory& History = Histories.FindChecked(CommandName);
+		Totals.FingerprintsChecked += History.Totals.FingerprintsChecked;
+		Totals.OutlinersSkipped += History.Totals.OutlinersSkipped;
+
+		TArray<float> SortedLatencies = History.LatenciesMs;
+		SortedLatencies.Sort();
+
+		Ar.Logf(TEXT("%-40s %8lld %10.2f %10.2f %10.2f %12lld %12lld %12lld %10lld %10lld"),
+			*CommandName.ToString(),
+			History.NumRuns,
+			GetPercentile(SortedLatencies, 0.5f),
+			GetPercentile(SortedLatencies, 0.95f),
+			SortedLatencies.Num() > 0 ? SortedLatencies.Last() : 0.f,
+			History.Totals.ItemsVisited,
+			History.Totals.ItemsExpanded,
+			History.Totals.ItemsCollapsed,
+			History.Totals.OutlinersTouched,
+			History.Totals.OutlinersSkipped);
+	}
+
+	if (Totals.FingerprintsChecked > 0)
+	{
+		Ar.Logf(TEXT("Skipped %lld of the %lld Outliners checked against their fingerprint (%.1f%%)"),
+			Totals.OutlinersSkipped, Totals.FingerprintsChecked, 100. * Totals.OutlinersSkipped / Totals.FingerprintsChecked);
+	}
+}
+
+void FOutlinerShortcutsStats::ResetStats()
+{
+	Histories.Empty();
+}
+
+void FOutlinerShortcutsStats::RecordCommand(const TCHAR* CommandName, double LatencySeconds, const FCounters& Counters)
+{
+	FCommandHistory& History = Histories.FindOrAdd(FName(CommandName));
+
+	const float LatencyMs = static_cast<float>(LatencySeconds * 1000.);
+	if (History.LatenciesMs.Num() < MaxLatenciesPerCommand)
+	{
+		History.LatenciesMs.Add(LatencyMs);
+	}
+	else
+	{
+		History.LatenciesMs[History.NextIndex] = LatencyMs;
+		History.NextIndex = (History.NextIndex + 1) % MaxLatenciesPerCommand;
+	}
+
+	++History.NumRuns;
+	History.Totals.ItemsVisited += Counters.ItemsVisited;
+	History.Totals.ItemsExpanded += Counters.ItemsExpanded;
+	History.Totals.ItemsCollapsed += Counters.ItemsCollapsed;
+	History.Totals.OutlinersTouched += Counters.OutlinersTouched;
+	History.Totals.FingerprintsChecked += Counters.FingerprintsChecked;
+	History.Totals.OutlinersSkipped += Counters.OutlinersSkipped;
+}
@@ -0,0 +1,224 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SSceneOutlinerQuickFind.h"
+
+#include "SceneOutlinerSelectionReveal.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "SSceneOutliner.h"
+#include "Editor.h"
+#include "GameFramework/Actor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Application/IMenu.h"
+#include "Styling/AppStyle.h"
+#include "Styling/SlateIconFinder.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "SSceneOutlinerQuickFind"
+
+namespace
+{
+	// More results would not fit in the popup, and each one costs a row widget
+	constexpr int32 MaxQuickFindResults = 50;
+}
+
+void SSceneOutlinerQuickFind::Construct(const FArguments& InArgs, const TSharedRef<SSceneOutliner>& InOutliner)
+{
+	Outliner = InOutliner;
+
+	ChildSlot
+	[
+		SNew(SBorder)
+		.BorderImage(FAppStyle::GetBrush("Menu.Background"))
+		.Padding(4.f)
+		[
+			SNew(SBox)
+			.WidthOverride(420.f)
+			.MaxDesiredHeight(420.f)
+			[
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.f, 0.f, 0.f, 4.f)
+				[
+					SAssignNew(SearchBox, SSearchBox)
+					.HintText(LOCTEXT("QuickFindHint", "Find an Actor or Folder..."))
+					.OnTextChanged(this, &SSceneOutlinerQuickFind::OnSearchTextChanged)
+					.OnTextCommitted(this, &SSceneOutlinerQuickFind::OnSearchTextCommitted)
+					.OnKeyDownHandler(this, &SSceneOutlinerQuickFind::OnSearchKeyDown)
+				]
+				+ SVerticalBox::Slot()
+				.FillHeight(1.f)
+				[
+					SAssignNew(ResultsList, SListView<FResultPtr>)
+					.ListItemsSource(&Results)
+					.SelectionMode(ESelectionMode::Single)
+					.OnGenerateRow(this, &SSceneOutlinerQuickFind::OnGenerateRow)
+					.OnMouseButtonClick(this, &SSceneOutlinerQuickFind::OnResultClicked)
+				]
+			]
+		]
+	];
+}
+
+void SSceneOutlinerQuickFind::Open(SSceneOutliner& SOutliner)
+{
+	// Building the index on a large map takes a moment, better now than on the first key typed
+	if (FSceneOutlinerLabelIndex* LabelIndex = FSceneOutlinerLabelIndex::Get())
+	{
+		LabelIndex->BuildIfNeeded();
+	}
+
+	const TSharedRef<SSceneOutliner> OutlinerRef = StaticCastSharedRef<SSceneOutliner>(SOutliner.AsShared());
+	const TSharedRef<SSceneOutlinerQuickFind> Popup = SNew(SSceneOutlinerQuickFind, OutlinerRef);
+	Popup->Menu = FSlateApplication::Get().PushMenu(OutlinerRef, FWidgetPath(), Popup, FSlateApplication::Get().GetCursorPos(), FPopupTransitionEffect(FPopupTransitionEffect::TypeInPopup));
+	FSlateApplication::Get().SetKeyboardFocus(Popup->SearchBox, EFocusCause::SetDirectly);
+}
+
+void SSceneOutlinerQuickFind::OnSearchTextChanged(const FText& Text)
+{
+	SearchText = Text;
+	Results.Reset();
+
+	FSceneOutlinerLabelIndex* LabelIndex = FSceneOutlinerLabelIndex::Get();
+	const FString Query = Text.ToString().TrimStartAndEnd();
+	if (LabelIndex && !Query.IsEmpty())
+	{
+		TArray<FSceneOutlinerLabelIndex::FResult> Found;
+		LabelIndex->Find(Query, MaxQuickFindResults, Found);
+		for (FSceneOutlinerLabelIndex::FResult& Result : Found)
+		{
+			Results.Add(MakeShared<FSceneOutlinerLabelIndex::FResult>(MoveTemp(Result)));
+		}
+	}
+
+	ResultsList->RequestListRefresh();
+	if (Results.Num() > 0)
+	{
+		ResultsList->SetSelection(Results[0]);
+		ResultsList->RequestScrollIntoView(Results[0]);
+	}
+}
+
+void SSceneOutlinerQuickFind::OnSearchTextCommitted(const FText& Text, ETextCommit::Type CommitType)
+{
+	if (CommitType != ETextCommit::OnEnter)
+	{
+		return;
+	}
+	const TArray<FResultPtr> Selected = ResultsList->GetSelectedItems();
+	if (Selected.Num() > 0)
+	{
+		Pick(Selected[0]);
+	}
+	else if (Results.Num() > 0)
+	{
+		Pick(Results[0]);
+	}
+}
+
+FReply SSceneOutlinerQuickFind::OnSearchKeyDown(const FGeometry& Geometry, const FKeyEvent& KeyEvent)
+{
+	const FKey Key = KeyEvent.GetKey();
+	if (Key == EKeys::Escape)
+	{
+		Close();
+		return FReply::Handled();
+	}
+	if ((Key != EKeys::Up && Key != EKeys::Down) || Results.Num() == 0)
+	{
+		return FReply::Unhandled();
+	}
+
+	const TArray<FResultPtr> Selected = ResultsList->GetSelectedItems();
+	int32 Index = Selected.Num() > 0 ? Results.IndexOfByKey(Selected[0]) : INDEX_NONE;
+	Index = Key == EKeys::Up ? FMath::Max(Index - 1, 0) : FMath::Min(Index + 1, Results.Num() - 1);
+	ResultsList->SetSelection(Results[Index]);
+	ResultsList->RequestScrollIntoView(Results[Index]);
+	return FReply::Handled();
+}
+
+TSharedRef<ITableRow> SSceneOutlinerQuickFind::OnGenerateRow(FResultPtr Result, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const AActor* Actor = Result->Actor.Get();
+	const FSlateBrush* Icon = Actor ? FSlateIconFinder::FindIconBrushForClass(Actor->GetClass()) : FAppStyle::GetBrush("Icons.FolderClosed");
+
+	return SNew(STableRow<FResultPtr>, OwnerTable)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(2.f, 1.f)
+			[
+				SNew(SImage)
+				.Image(Icon)
+				.ColorAndOpacity(FSlateColor::UseForeground())
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(4.f, 1.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Result->Label))
+				.HighlightText(SearchText)
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Center)
+			.Padding(8.f, 1.f, 2.f, 1.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromName(Result->ParentPath))
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+			]
+		];
+}
+
+void SSceneOutlinerQuickFind::Pick(FResultPtr Result)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(QuickFindPick);
+	// Closing the popup releases it, only locals are used afterwards
+	const TSharedRef<SSceneOutlinerQuickFind> KeepAlive = SharedThis(this);
+	const TSharedPtr<SSceneOutliner> SOutliner = Outliner.Pin();
+	Close();
+	if (!Result || !SOutliner)
+	{
+		return;
+	}
+
+	FOutlinerShortcutsEditorModule::CancelTimeSlicedExpansion();
+	if (AActor* Actor = Result->Actor.Get())
+	{
+		if (GEditor)
+		{
+			GEditor->SelectNone(false, true);
+			GEditor->SelectActor(Actor, true, true);
+		}
+	}
+
+	const FSceneOutlinerTreeItemPtr Item = SOutliner->GetTreeItem(Result->ID);
+	if (!Item)
+	{
+		OUTLINER_SHORTCUTS_LOG_H("`%s` is not shown in the Outliner, it might be hidden by a filter", *Result->Label);
+		return;
+	}
+	FSceneOutlinerSelectionReveal::RevealItem(*SOutliner, Item);
+}
+
+void SSceneOutlinerQuickFind::Close()
+{
+	if (const TSharedPtr<IMenu> PinnedMenu = Menu.Pin())
+	{
+		PinnedMenu->Dismiss();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
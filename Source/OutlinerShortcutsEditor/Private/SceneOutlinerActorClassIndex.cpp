@@ -0,0 +1,99 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerActorClassIndex.h"
+
+#include "OutlinerShortcutsStats.h"
+
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+
+FSceneOutlinerActorClassIndex* FSceneOutlinerActorClassIndex::Instance = nullptr;
+
+void FSceneOutlinerActorClassIndex::OnStartupModule()
+{
+	Instance = this;
+	if (FSceneOutlinerWorldActorIndex* WorldActorIndex = FSceneOutlinerWorldActorIndex::Get())
+	{
+		WorldActorIndex->AddListener(*this);
+	}
+}
+
+void FSceneOutlinerActorClassIndex::OnShutdownModule()
+{
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(OnBlueprintCompiledHandle);
+	}
+	OnBlueprintCompiledHandle.Reset();
+	if (FSceneOutlinerWorldActorIndex* WorldActorIndex = FSceneOutlinerWorldActorIndex::Get())
+	{
+		WorldActorIndex->RemoveListener(*this);
+	}
+	ActorsByClass.Empty();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerActorClassIndex* FSceneOutlinerActorClassIndex::Get()
+{
+	return Instance;
+}
+
+void FSceneOutlinerActorClassIndex::GatherActors(const TArray<UClass*>& Classes, TArray<FObjectKey>& OutActors)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(GatherActorsOfClasses);
+	if (FSceneOutlinerWorldActorIndex* WorldActorIndex = FSceneOutlinerWorldActorIndex::Get())
+	{
+		WorldActorIndex->BuildIfNeeded(FOutlinerShortcutsEditorModule::GetCurrentEditorWorld());
+	}
+
+	for (const TPair<TWeakObjectPtr<UClass>, TSet<FObjectKey>>& Pair : ActorsByClass)
+	{
+		const UClass* ActorClass = Pair.Key.Get();
+		if (ActorClass && Classes.ContainsByPredicate([ActorClass](const UClass* Class) { return Class && ActorClass->IsChildOf(Class); }))
+		{
+			OutActors.Append(Pair.Value.Array());
+		}
+	}
+}
+
+void FSceneOutlinerActorClassIndex::MarkDirty()
+{
+	if (FSceneOutlinerWorldActorIndex* WorldActorIndex = FSceneOutlinerWorldActorIndex::Get())
+	{
+		WorldActorIndex->MarkDirty();
+	}
+}
+
+void FSceneOutlinerActorClassIndex::OnIndexReset(UWorld* World)
+{
+	ActorsByClass.Reset();
+
+	// Only listened to once built, like the actor events
+	if (!OnBlueprintCompiledHandle.IsValid() && GEditor)
+	{
+		OnBlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FSceneOutlinerActorClassIndex::OnBlueprintCompiled);
+	}
+}
+
+void FSceneOutlinerActorClassIndex::OnIndexActorAdded(AActor& Actor)
+{
+	ActorsByClass.FindOrAdd(Actor.GetClass()).Add(FObjectKey(&Actor));
+}
+
+void FSceneOutlinerActorClassIndex::OnIndexActorDeleted(AActor& Actor)
+{
+	if (TSet<FObjectKey>* Actors = ActorsByClass.Find(Actor.GetClass()))
+	{
+		Actors->Remove(FObjectKey(&Actor));
+		if (Actors->Num() == 0)
+		{
+			ActorsByClass.Remove(Actor.GetClass());
+		}
+	}
+}
@@ -4,10 +4,27 @@
 #include "SceneOutlinerEvents.h"
 
 #include "SSceneOutliner.h"
+#include "SceneOutlinerHierarchyIndex.h"
+#include "SceneOutlinerExpansionPlanner.h"
+#include "SceneOutlinerIncrementalExpansion.h"
+#include "SceneOutlinerTimeSlicedExpansion.h"
+#include "OutlinerShortcutsLibrary.h"
+#include "ISceneOutlinerHierarchy.h"
 
 #include "Containers/Ticker.h"
+#include "EditorActorFolders.h"
 #include "GameFramework/WorldSettings.h"
 #include "OutlinerShortcutsSettings.h"
+#include "HAL/PlatformTime.h"
+#include "OutlinerShortcutsStats.h"
+#include "FolderPathMatcher.h"
+
+namespace
+{
+	// Delays between two polls of the Outliner, doubled after each failed poll
+	constexpr float InitialPollDelay = 0.05f;
+	constexpr float MaxPollDelay = 1.f;
+}
 
 
 void FSceneOutlinerEvents::OnStartupModule()
@@ -30,36 +47,266 @@ void FSceneOutlinerEvents::OnShutdownModule()
 	//}
 	//EventReleasers.Empty();
 
-	FTSTicker::GetCoreTicker().RemoveTicker(TickUntilActorsLoadedHandle);
+	StopWaitingForOutliner();
 }
 
 void FSceneOutlinerEvents::OnMapOpened(const FString& Filename, bool bAsTemplate)
 {
 	OUTLINER_SHORTCUTS_LOG_D(" Map:  `%s`  bAsTemplate: `%s`", *Filename, OUTLINER_SHORTCUTS_BtoS(bAsTemplate));
 
-	FTSTicker::GetCoreTicker().RemoveTicker(TickUntilActorsLoadedHandle);
-	const FTickerDelegate TickDelegate = FTickerDelegate::CreateStatic(&FSceneOutlinerEvents::TickUntilActorsLoaded);
-	TickUntilActorsLoadedHandle = FTSTicker::GetCoreTicker().AddTicker(TickDelegate);
+	// An expansion still running on the previous map would fight with the settings
+	FOutlinerShortcutsEditorModule::CancelTimeSlicedExpansion();
 
+	StopWaitingForOutliner();
+	bWaitingForOutliner = true;
+	WaitStartTime = FPlatformTime::Seconds();
+	PollDelay = InitialPollDelay;
+
+	// Listen to the hierarchies of the opened Outliners. They are still the ones of the previous map, the index binds the new ones
+	// on the tick the Outliners rebuild them for the new map, and broadcasts it as a full refresh, which is what tells us the map is getting populated.
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		OnOutlinerHierarchyChangedHandle = HierarchyIndex->OnOutlinerHierarchyChanged().AddRaw(this, &FSceneOutlinerEvents::OnOutlinerHierarchyChanged);
+#if PRE_UE5_1
+		HierarchyIndex->TrackOutliner(FOutlinerShortcutsEditorModule::GetSSceneOutliner());
+#else
+		for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+		{
+			HierarchyIndex->TrackOutliner(&SOutliner.Get());
+		}
+#endif
+	}
+
+	// The folder items read their expansion from the world folders when they are created, on the next tick of the Outliners
+	PreseedFolderExpansion(FOutlinerShortcutsEditorModule::GetCurrentEditorWorld());
+
+	// The expansion can be computed while the Outliner gets populated, only applying it is left for when it's ready
+	if (FSceneOutlinerExpansionPlanner* Planner = FSceneOutlinerExpansionPlanner::Get())
+	{
+		Planner->StartMapOpenPlan(FOutlinerShortcutsEditorModule::GetCurrentEditorWorld());
+	}
+
+	// The Outliner might already be populated, in which case there is no event to wait for
+	ScheduleReadinessCheck(0.f);
 }
 
 bool FSceneOutlinerEvents::TickUntilActorsLoaded(float DeltaTime)
 {
-	// need to return true for the function to tick again
-	return !ApplyOutlinerActionsFromOnMapOpenedSettings();
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(TickUntilActorsLoaded);
+	const bool bIsFromEvent = bReadinessCheckScheduledFromEvent;
+	bReadinessCheckScheduledFromEvent = false;
+
+	const double WaitedTime = FPlatformTime::Seconds() - WaitStartTime;
+	ESceneOutlinerReadiness Readiness = ESceneOutlinerReadiness::Unsupported;
+	SSceneOutliner* SceneOutliner = FindOutlinerToWaitFor(Readiness);
+	if (SceneOutliner)
+	{
+		// Binds the hierarchy of the new world as soon as the Outliner has it, if the index didn't already
+		if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+		{
+			HierarchyIndex->TrackOutliner(SceneOutliner);
+		}
+	}
+	if (Readiness == ESceneOutlinerReadiness::Unsupported)
+	{
+		// The opened Outliners have no hierarchy, polling them until the timeout would not change anything
+		OUTLINER_SHORTCUTS_WARN_H("None of the opened Outliners can display the map, the settings were not applied");
+		StopWaitingForOutliner();
+		if (FSceneOutlinerExpansionPlanner* Planner = FSceneOutlinerExpansionPlanner::Get())
+		{
+			Planner->CancelMapOpenPlan();
+		}
+		return false;
+	}
+
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	const float Timeout = EditorSettings ? EditorSettings->OutlinerReadyTimeout : 30.f;
+	FSceneOutlinerExpansionPlanner* Planner = FSceneOutlinerExpansionPlanner::Get();
+	if (Readiness == ESceneOutlinerReadiness::Ready && Planner && Planner->IsMapOpenPlanRunning() && WaitedTime < Timeout)
+	{
+		// The Outliner got ready before the plan, check again next tick instead of blocking the game thread on it
+		ScheduleReadinessCheck(0.f);
+		return false;
+	}
+
+	if (Readiness == ESceneOutlinerReadiness::Ready && ApplyOutlinerExpansionFromOnMapOpenedSettings(SceneOutliner))
+	{
+		OUTLINER_SHORTCUTS_LOG_H("Outliner ready and settings applied after waiting %.3fs, checked %s", WaitedTime, bIsFromEvent ? TEXT("from a hierarchy event") : TEXT("by polling"));
+		StopWaitingForOutliner();
+		// The items added while the map was populated were covered by the settings, only the ones loaded from now on need to be processed
+		if (FSceneOutlinerIncrementalExpansion* IncrementalExpansion = FSceneOutlinerIncrementalExpansion::Get())
+		{
+			IncrementalExpansion->Reset();
+		}
+		return false;
+	}
+
+	if (WaitedTime >= Timeout)
+	{
+		OUTLINER_SHORTCUTS_WARN_H("Gave up waiting for the Outliner after %.2fs, the settings were not applied", WaitedTime);
+		StopWaitingForOutliner();
+		if (Planner)
+		{
+			Planner->CancelMapOpenPlan();
+		}
+		return false;
+	}
+
+	// Fallback polling in case no event comes, backing off so a closed Outliner does not cost anything every frame
+	ScheduleReadinessCheck(PollDelay);
+	PollDelay = FMath::Min(PollDelay * 2.f, MaxPollDelay);
+	return false;
 }
 
-bool FSceneOutlinerEvents::ApplyOutlinerActionsFromOnMapOpenedSettings()
+void FSceneOutlinerEvents::PreseedFolderExpansion(UWorld* World)
 {
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(PreseedFolderExpansion);
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!World || !EditorSettings || !EditorSettings->bPreseedFolderExpansion)
+	{
+		return;
+	}
 
-	SSceneOutliner* SceneOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
-	if (!SceneOutliner)
+	// The folders belong to the world and are shared by all its Outliners
+	EOutlinerExpansionBehaviorOnMapOpen Behavior = EditorSettings->DefaultOutlinerExpansionBehaviorOnMapOpen;
+#if UE5_1_ONWARDS
+	bool bFirstOutliner = true;
+	for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
 	{
-		// OUTLINER_SHORTCUTS_WARN_H("`Scene Outliner` returned null. Retrying next tick...");
-		return false;
+		const EOutlinerExpansionBehaviorOnMapOpen OutlinerBehavior = EditorSettings->GetExpansionBehaviorOnMapOpen(SOutliner.Get());
+		if (!bFirstOutliner && OutlinerBehavior != Behavior)
+		{
+			OUTLINER_SHORTCUTS_LOG_D("The Outliners have different behaviors, the folders are not preseeded");
+			return;
+		}
+		Behavior = OutlinerBehavior;
+		bFirstOutliner = false;
+	}
+#endif
+
+	TArray<FFolder> Folders;
+	FActorFolders::Get().ForEachFolder(*World, [&Folders](const FFolder& Folder)
+		{
+			Folders.Add(Folder);
+			return true;
+		});
+
+	// Folders are children of the world item, so a folder is at depth 1 plus its number of parent folders
+	TFunction<bool(const FString&)> ShouldExpand;
+	TSet<FString> MatchedPaths;
+	switch (Behavior)
+	{
+	case EOutlinerExpansionBehaviorOnMapOpen::CollapseAll:
+	case EOutlinerExpansionBehaviorOnMapOpen::CollapseToRoot:
+		ShouldExpand = [](const FString&) { return false; };
+		break;
+	case EOutlinerExpansionBehaviorOnMapOpen::ExpandAll:
+	{
+		// A time sliced expansion starts from collapsed folders and expands them over several frames
+		const bool bExpand = !FOutlinerShortcutsEditorModule::ShouldTimeSliceExpandAll();
+		ShouldExpand = [bExpand](const FString&) { return bExpand; };
+		break;
+	}
+	case EOutlinerExpansionBehaviorOnMapOpen::ExpandToDepth:
+		ShouldExpand = [Depth = EditorSettings->ExpandToDepth](const FString& Path)
+		{
+			int32 FolderDepth = 1;
+			for (const TCHAR Char : Path)
+			{
+				FolderDepth += Char == TEXT('/') ? 1 : 0;
+			}
+			return FolderDepth < Depth;
+		};
+		break;
+	case EOutlinerExpansionBehaviorOnMapOpen::ExpandMatchingFolders:
+	{
+		// The matched folders are expanded along with their parents, to be visible.
+		// Each folder is stepped from the states of its parent, so the segments of the parents are not matched again for each sub folder.
+		const FFolderPathMatcher& Matcher = EditorSettings->GetFolderPatternMatcher();
+		TMap<FName, FFolderPathMatcher::FStates> FolderStates;
+		for (const FFolder& Folder : Folders)
+		{
+			if (!Matcher.IsMatch(Matcher.GetFolderStates(Folder.GetPath(), FolderStates)))
+			{
+				continue;
+			}
+			FString Path = Folder.GetPath().ToString();
+			// Stop at the first parent already added, its own parents were added with it
+			bool bAlreadyInSet = false;
+			int32 SlashIndex = INDEX_NONE;
+			MatchedPaths.Add(Path, &bAlreadyInSet);
+			while (!bAlreadyInSet && Path.FindLastChar(TEXT('/'), SlashIndex))
+			{
+				Path.LeftInline(SlashIndex);
+				MatchedPaths.Add(Path, &bAlreadyInSet);
+			}
+		}
+		ShouldExpand = [&MatchedPaths](const FString& Path) { return MatchedPaths.Contains(Path); };
+		break;
+	}
+	case EOutlinerExpansionBehaviorOnMapOpen::RestoreLastState:
+	case EOutlinerExpansionBehaviorOnMapOpen::LeaveAlone:
+	default:
+		// The saved state is only read in the background, and leaving the Outliner alone means not touching its folders either
+		return;
+	}
+
+	int32 NumChanged = 0;
+	for (const FFolder& Folder : Folders)
+	{
+		const bool bExpand = ShouldExpand(Folder.GetPath().ToString());
+		if (FActorFolders::Get().IsFolderExpanded(*World, Folder) != bExpand)
+		{
+			FActorFolders::Get().SetIsFolderExpanded(*World, Folder, bExpand);
+			++NumChanged;
+		}
+	}
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, Folders.Num());
+	OUTLINER_SHORTCUTS_LOG_D("Preseeded %d folders out of %d for %s", NumChanged, Folders.Num(), *UEnum::GetValueAsString(Behavior));
+}
+
+void FSceneOutlinerEvents::OnOutlinerHierarchyChanged(SSceneOutliner* SOutliner, const FSceneOutlinerHierarchyChangedData& Data)
+{
+	if (!bWaitingForOutliner || bReadinessCheckScheduledFromEvent)
+	{
+		return;
 	}
 
-	if (!FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(SceneOutliner))
+	if (Data.Type == FSceneOutlinerHierarchyChangedData::FullRefresh || Data.Type == FSceneOutlinerHierarchyChangedData::Added)
+	{
+		// The Outliner processes the change on its next tick, check right after it
+		bReadinessCheckScheduledFromEvent = true;
+		ScheduleReadinessCheck(0.f);
+	}
+}
+
+void FSceneOutlinerEvents::ScheduleReadinessCheck(float Delay)
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickUntilActorsLoadedHandle);
+	const FTickerDelegate TickDelegate = FTickerDelegate::CreateRaw(this, &FSceneOutlinerEvents::TickUntilActorsLoaded);
+	TickUntilActorsLoadedHandle = FTSTicker::GetCoreTicker().AddTicker(TickDelegate, Delay);
+}
+
+void FSceneOutlinerEvents::StopWaitingForOutliner()
+{
+	bWaitingForOutliner = false;
+	bReadinessCheckScheduledFromEvent = false;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickUntilActorsLoadedHandle);
+	TickUntilActorsLoadedHandle.Reset();
+
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		HierarchyIndex->OnOutlinerHierarchyChanged().Remove(OnOutlinerHierarchyChangedHandle);
+	}
+	OnOutlinerHierarchyChangedHandle.Reset();
+}
+
+bool FSceneOutlinerEvents::ApplyOutlinerActionsFromOnMapOpenedSettings()
+{
+	ESceneOutlinerReadiness Readiness = ESceneOutlinerReadiness::Unsupported;
+	SSceneOutliner* SceneOutliner = FindOutlinerToWaitFor(Readiness);
+	if (Readiness != ESceneOutlinerReadiness::Ready)
 	{
 		// OUTLINER_SHORTCUTS_WARN_H("`Scene Outliner` is not ready. Retrying next tick...");
 		return false;
@@ -70,6 +317,31 @@ bool FSceneOutlinerEvents::ApplyOutlinerActionsFromOnMapOpenedSettings()
 	return ApplyOutlinerExpansionFromOnMapOpenedSettings(SceneOutliner);
 }
 
+SSceneOutliner* FSceneOutlinerEvents::FindOutlinerToWaitFor(ESceneOutlinerReadiness& OutReadiness)
+{
+	// No Outliner opened yet, one might be while the map loads
+	OutReadiness = ESceneOutlinerReadiness::Pending;
+#if PRE_UE5_1
+	SSceneOutliner* SceneOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+	if (SceneOutliner)
+	{
+		OutReadiness = FOutlinerShortcutsEditorModule::GetSceneOutlinerReadiness(SceneOutliner);
+	}
+	return OutReadiness == ESceneOutlinerReadiness::Unsupported ? nullptr : SceneOutliner;
+#else
+	// The other Outliners are expanded along with this one, only the first one able to get ready is waited for
+	for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+	{
+		OutReadiness = FOutlinerShortcutsEditorModule::GetSceneOutlinerReadiness(&SOutliner.Get());
+		if (OutReadiness != ESceneOutlinerReadiness::Unsupported)
+		{
+			return &SOutliner.Get();
+		}
+	}
+	return nullptr;
+#endif
+}
+
 bool FSceneOutlinerEvents::ApplyOutlinerExpansionFromOnMapOpenedSettings(const SSceneOutliner* SceneOutliner)
 {
 	if (!SceneOutliner)
@@ -78,8 +350,22 @@ bool FSceneOutlinerEvents::ApplyOutlinerExpansionFromOnMapOpenedSettings(const S
 	}
 	OUTLINER_SHORTCUTS_HERE_D;
 
+	FSceneOutlinerExpansionPlanner* Planner = FSceneOutlinerExpansionPlanner::Get();
+	if (Planner && Planner->ApplyMapOpenPlan())
+	{
+		OUTLINER_SHORTCUTS_LOG_H(" Editor Settings: Applied the expansion planned when the map opened");
+		return true;
+	}
+
 	if (const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance())
 	{
+#if UE5_1_ONWARDS
+		if (EditorSettings->OutlinerExpansionBehaviorOverrides.Num() > 0)
+		{
+			return ApplyOutlinerExpansionPerOutliner(*EditorSettings);
+		}
+#endif
+
 		bool bSuccess = false;
 		switch (EditorSettings->DefaultOutlinerExpansionBehaviorOnMapOpen)
 		{
@@ -110,6 +396,33 @@ bool FSceneOutlinerEvents::ApplyOutlinerExpansionFromOnMapOpenedSettings(const S
 			bSuccess = FOutlinerShortcutsEditorModule::SceneOutlinerCollapseAllOutlinersToRoot();
 #endif
 			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::RestoreLastState:
+#if PRE_UE5_1
+			OUTLINER_SHORTCUTS_LOG_H(" Editor Settings: Restore Last State...");
+			bSuccess = FOutlinerShortcutsEditorModule::SceneOutlinerRestoreLastState();
+#else
+			OUTLINER_SHORTCUTS_LOG_H(" Editor Settings: Restore Last State of All Outliners...");
+			bSuccess = FOutlinerShortcutsEditorModule::SceneOutlinerRestoreLastStateAllOutliners();
+#endif
+			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::ExpandToDepth:
+			// Applies to all the Outliners from UE 5.1, to the only one before
+			OUTLINER_SHORTCUTS_LOG_H(" Editor Settings: Expand To Depth %d...", EditorSettings->ExpandToDepth);
+			bSuccess = UOutlinerShortcutsLibrary::ExpandToDepth(EditorSettings->ExpandToDepth, UOutlinerShortcutsLibrary::GetOutlinerIds()).bSuccess;
+			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::ExpandMatchingFolders:
+#if PRE_UE5_1
+			OUTLINER_SHORTCUTS_LOG_H(" Editor Settings: Expand Matching Folders...");
+			bSuccess = FOutlinerShortcutsEditorModule::SceneOutlinerExpandMatchingFolders();
+#else
+			OUTLINER_SHORTCUTS_LOG_H(" Editor Settings: Expand Matching Folders of All Outliners...");
+			bSuccess = FOutlinerShortcutsEditorModule::SceneOutlinerExpandMatchingFoldersAllOutliners();
+#endif
+			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::LeaveAlone:
+			OUTLINER_SHORTCUTS_LOG_H(" Editor Settings: Leave Alone");
+			bSuccess = true;
+			break;
 		default:
 			break;
 		}
@@ -121,4 +434,73 @@ bool FSceneOutlinerEvents::ApplyOutlinerExpansionFromOnMapOpenedSettings(const S
 		OUTLINER_SHORTCUTS_WARN_H("Unable to get `UOutlinerShortcutsEditorSettings`...");
 	}
 	return false;
-}
\ No newline at end of file
+}
+#if UE5_1_ONWARDS
+bool FSceneOutlinerEvents::ApplyOutlinerExpansionPerOutliner(const UOutlinerShortcutsEditorSettings& EditorSettings)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ApplyOutlinerExpansionPerOutliner);
+
+	// Outliners sharing a behavior are processed in the same pass, and the ones left alone are not touched at all
+	TMap<EOutlinerExpansionBehaviorOnMapOpen, TArray<FName>> OutlinerIdsByBehavior;
+	for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+	{
+		const EOutlinerExpansionBehaviorOnMapOpen Behavior = EditorSettings.GetExpansionBehaviorOnMapOpen(SOutliner.Get());
+		if (Behavior != EOutlinerExpansionBehaviorOnMapOpen::LeaveAlone)
+		{
+			OutlinerIdsByBehavior.FindOrAdd(Behavior).Add(SOutliner->GetOutlinerIdentifier());
+		}
+	}
+
+	// `Expand All` might start a time sliced expansion, which the other behaviors would cancel
+	OutlinerIdsByBehavior.KeySort([](EOutlinerExpansionBehaviorOnMapOpen A, EOutlinerExpansionBehaviorOnMapOpen B)
+		{
+			return (A != EOutlinerExpansionBehaviorOnMapOpen::ExpandAll) && (B == EOutlinerExpansionBehaviorOnMapOpen::ExpandAll);
+		});
+
+	bool bSuccess = true;
+	for (const TPair<EOutlinerExpansionBehaviorOnMapOpen, TArray<FName>>& Pair : OutlinerIdsByBehavior)
+	{
+		OUTLINER_SHORTCUTS_LOG_H(" Editor Settings: %s for %d Outliners", *UEnum::GetValueAsString(Pair.Key), Pair.Value.Num());
+
+		FOutlinerShortcutsOperation Operation;
+		switch (Pair.Key)
+		{
+		case EOutlinerExpansionBehaviorOnMapOpen::ExpandAll:
+			if (FOutlinerShortcutsEditorModule::ShouldTimeSliceExpandAll())
+			{
+				TArray<SSceneOutliner*> SOutliners;
+				for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+				{
+					if (Pair.Value.Contains(SOutliner->GetOutlinerIdentifier()))
+					{
+						SOutliners.Add(&SOutliner.Get());
+					}
+				}
+				bSuccess &= FSceneOutlinerTimeSlicedExpansion::Get()->Start(SOutliners);
+				continue;
+			}
+			Operation.Type = EOutlinerShortcutsOperationType::ExpandAll;
+			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::CollapseAll:
+			Operation.Type = EOutlinerShortcutsOperationType::CollapseAll;
+			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::RestoreLastState:
+			Operation.Type = EOutlinerShortcutsOperationType::RestoreLastState;
+			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::ExpandToDepth:
+			Operation.Type = EOutlinerShortcutsOperationType::ExpandToDepth;
+			Operation.Depth = EditorSettings.ExpandToDepth;
+			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::ExpandMatchingFolders:
+			Operation.Type = EOutlinerShortcutsOperationType::ExpandMatchingFolders;
+			break;
+		case EOutlinerExpansionBehaviorOnMapOpen::CollapseToRoot:
+		default:
+			Operation.Type = EOutlinerShortcutsOperationType::CollapseToRoot;
+			break;
+		}
+		bSuccess &= UOutlinerShortcutsLibrary::ApplyOperations({ Operation }, Pair.Value).bSuccess;
+	}
+	return bSuccess;
+}
+#endif
@@ -0,0 +1,162 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerExpansionBatch.h"
+
+#include "OutlinerShortcutsEditor.h"
+#include "SceneOutlinerTreeModel.h"
+#include "SceneOutlinerTreePolicies.h"
+#include "SceneOutlinerFingerprints.h"
+#include "SSceneOutliner.h"
+#include "OutlinerShortcutsStats.h"
+
+
+FSceneOutlinerExpansionBatch::~FSceneOutlinerExpansionBatch()
+{
+	Commit();
+}
+
+void FSceneOutlinerExpansionBatch::CollapseAll(SSceneOutliner& SOutliner)
+{
+	FOutlinerChanges& Changes = FindOrAddChanges(SOutliner);
+	Changes.BaseState = EBaseState::Collapsed;
+	Changes.Items.Reset();
+}
+
+void FSceneOutlinerExpansionBatch::ExpandAll(SSceneOutliner& SOutliner)
+{
+	FOutlinerChanges& Changes = FindOrAddChanges(SOutliner);
+	Changes.BaseState = EBaseState::Expanded;
+	Changes.Items.Reset();
+}
+
+void FSceneOutlinerExpansionBatch::SetItemExpansion(SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemPtr& Item, bool bIsExpanded)
+{
+	if (Item)
+	{
+		FindOrAddChanges(SOutliner).Items.Add(Item->GetID(), TPair<TWeakPtr<ISceneOutlinerTreeItem>, bool>(Item, bIsExpanded));
+	}
+}
+
+bool FSceneOutlinerExpansionBatch::IsItemExpanded(const SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemPtr& Item) const
+{
+	if (!Item)
+	{
+		return false;
+	}
+
+	if (const FOutlinerChanges* Changes = FindChanges(SOutliner))
+	{
+		if (const TPair<TWeakPtr<ISceneOutlinerTreeItem>, bool>* Requested = Changes->Items.Find(Item->GetID()))
+		{
+			return Requested->Value;
+		}
+		switch (Changes->BaseState)
+		{
+		case EBaseState::Collapsed:
+			return false;
+		case EBaseState::Expanded:
+			return Item->GetChildren().Num() > 0;
+		default:
+			break;
+		}
+	}
+	return Item->Flags.bIsExpanded;
+}
+
+void FSceneOutlinerExpansionBatch::Commit()
+{
+	for (FOutlinerChanges& Changes : OutlinerChanges)
+	{
+		Apply(Changes);
+	}
+	OutlinerChanges.Reset();
+}
+
+FSceneOutlinerExpansionBatch::FOutlinerChanges& FSceneOutlinerExpansionBatch::FindOrAddChanges(SSceneOutliner& SOutliner)
+{
+	for (FOutlinerChanges& Changes : OutlinerChanges)
+	{
+		if (Changes.Outliner.Pin().Get() == &SOutliner)
+		{
+			return Changes;
+		}
+	}
+
+	FOutlinerChanges& Changes = OutlinerChanges.AddDefaulted_GetRef();
+	Changes.Outliner = StaticCastSharedRef<SSceneOutliner>(SOutliner.AsShared());
+	return Changes;
+}
+
+const FSceneOutlinerExpansionBatch::FOutlinerChanges* FSceneOutlinerExpansionBatch::FindChanges(const SSceneOutliner& SOutliner) const
+{
+	return OutlinerChanges.FindByPredicate([&SOutliner](const FOutlinerChanges& Changes) { return Changes.Outliner.Pin().Get() == &SOutliner; });
+}
+
+void FSceneOutlinerExpansionBatch::Apply(FOutlinerChanges& Changes)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ApplyExpansionBatch);
+	const TSharedPtr<SSceneOutliner> SOutliner = Changes.Outliner.Pin();
+	if (!SOutliner)
+	{
+		return;
+	}
+
+	const FStats StatsBefore = Stats;
+	int32 NumChanged = 0;
+
+	if (Changes.BaseState == EBaseState::Unchanged)
+	{
+		for (const TPair<FSceneOutlinerTreeItemID, TPair<TWeakPtr<ISceneOutlinerTreeItem>, bool>>& Requested : Changes.Items)
+		{
+			const FSceneOutlinerTreeItemPtr Item = Requested.Value.Key.Pin();
+			if (!Item)
+			{
+				continue;
+			}
+
+			++Stats.ItemsVisited;
+			const bool bIsExpanded = Requested.Value.Value;
+			if (Item->Flags.bIsExpanded != bIsExpanded)
+			{
+				SOutliner->SetItemExpansion(Item, bIsExpanded);
+				FSceneOutlinerFingerprints::ReportItemExpansionChanged(*SOutliner, Requested.Key, bIsExpanded);
+				++NumChanged;
+				if (bIsExpanded)
+				{
+					++Stats.ItemsExpanded;
+				}
+				else
+				{
+					++Stats.ItemsCollapsed;
+				}
+			}
+		}
+	}
+	else
+	{
+		// Reading the expansion flags of the whole tree is cheap, only the items that change go through the Outliner.
+		// The model has no batch, so it expands the items right away and updates the fingerprint hash as it goes.
+		FSceneOutlinerWidgetTreeModel Model(*SOutliner);
+		Stats.ItemsVisited += FSceneOutlinerTreePolicies::SetAllExpanded(Model, Changes.BaseState == EBaseState::Expanded, [&Changes, &Model](int32 Item)
+			{
+				const TPair<TWeakPtr<ISceneOutlinerTreeItem>, bool>* Requested = Changes.Items.Find(Model.GetID(Item));
+				return Requested ? TOptional<bool>(Requested->Value) : TOptional<bool>();
+			});
+
+		NumChanged = Model.GetNumExpanded() + Model.GetNumCollapsed();
+		Stats.ItemsExpanded += Model.GetNumExpanded();
+		Stats.ItemsCollapsed += Model.GetNumCollapsed();
+	}
+
+	if (NumChanged > 0)
+	{
+		++Stats.OutlinersTouched;
+		SOutliner->Refresh();
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, Stats.ItemsVisited - StatsBefore.ItemsVisited);
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsExpanded, Stats.ItemsExpanded - StatsBefore.ItemsExpanded);
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsCollapsed, Stats.ItemsCollapsed - StatsBefore.ItemsCollapsed);
+	OUTLINER_SHORTCUTS_INC_COUNTER(OutlinersTouched, Stats.OutlinersTouched - StatsBefore.OutlinersTouched);
+	OUTLINER_SHORTCUTS_LOG_D("Batch applied %d expansion changes", NumChanged);
+}
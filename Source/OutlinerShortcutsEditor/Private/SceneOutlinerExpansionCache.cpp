@@ -0,0 +1,394 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerExpansionCache.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "SSceneOutliner.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "ActorTreeItem.h"
+#include "FolderTreeItem.h"
+#include "WorldTreeItem.h"
+
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "UObject/SoftObjectPath.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Containers/BitArray.h"
+
+namespace
+{
+	constexpr uint32 ExpansionCacheMagic = 0x4345534F; // "OSEC"
+	constexpr uint32 ExpansionCacheVersion = 1;
+
+	void SerializeExpansionCache(FArchive& Ar, TArray<FString>& Keys, TBitArray<>& Expanded)
+	{
+		uint32 Magic = ExpansionCacheMagic;
+		uint32 Version = ExpansionCacheVersion;
+		Ar << Magic;
+		Ar << Version;
+		if (Ar.IsLoading() && (Magic != ExpansionCacheMagic || Version != ExpansionCacheVersion))
+		{
+			Ar.SetError();
+			return;
+		}
+		Ar << Keys;
+		Ar << Expanded;
+		if (Ar.IsLoading() && Expanded.Num() != Keys.Num())
+		{
+			Ar.SetError();
+		}
+	}
+}
+
+FSceneOutlinerExpansionCache* FSceneOutlinerExpansionCache::Instance = nullptr;
+
+void FSceneOutlinerExpansionCache::OnStartupModule()
+{
+	Instance = this;
+	OnWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FSceneOutlinerExpansionCache::OnWorldCleanup);
+}
+
+void FSceneOutlinerExpansionCache::OnShutdownModule()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(OnWorldCleanupHandle);
+	WaitForPendingWrites();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerExpansionCache* FSceneOutlinerExpansionCache::Get()
+{
+	return Instance;
+}
+
+bool FSceneOutlinerExpansionCache::RestoreExpansion(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(RestoreExpansion);
+	const UWorld* World = FOutlinerShortcutsEditorModule::GetCurrentEditorWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	// The file might still be written if the map is reopened right after being closed
+	WaitForPendingWrites();
+
+	FSceneOutlinerSavedExpansion SavedExpansion;
+	if (!LoadExpandedKeys(GetCacheFilename(World->GetOutermost()->GetName()), SavedExpansion.ExpandedKeys))
+	{
+		return false;
+	}
+
+	SavedExpansion.Resolve();
+	ApplySavedExpansion(Batch, SOutliner, SavedExpansion);
+	return true;
+}
+
+UE::Tasks::TTask<TOptional<FSceneOutlinerSavedExpansion>> FSceneOutlinerExpansionCache::LoadSavedExpansionAsync(const FString& MapPackageName)
+{
+	PendingWrites.RemoveAllSwap([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+
+	// The file might still be written if the map is reopened right after being closed
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Filename = GetCacheFilename(MapPackageName)]()
+		{
+			// The keys are resolved later on the game thread, as objects can't be looked up here
+			FSceneOutlinerSavedExpansion SavedExpansion;
+			return LoadExpandedKeys(Filename, SavedExpansion.ExpandedKeys) ? TOptional<FSceneOutlinerSavedExpansion>(MoveTemp(SavedExpansion)) : TOptional<FSceneOutlinerSavedExpansion>();
+		}, UE::Tasks::Prerequisites(PendingWrites));
+}
+
+void FSceneOutlinerExpansionCache::ApplySavedExpansion(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FSceneOutlinerSavedExpansion& SavedExpansion)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ApplySavedExpansion);
+	if (!ensureMsgf(SavedExpansion.IsResolved(), TEXT("The saved expansion must be resolved before being applied")))
+	{
+		return;
+	}
+
+	// Setting them through the batch only changes the items whose expansion differs from the keys given
+	Batch.CollapseAll(SOutliner);
+
+	TArray<FSceneOutlinerTreeItemPtr> Stack = FOutlinerShortcutsEditorModule::GetSceneOutlinerRootItems(&SOutliner);
+	int32 NumExpanded = 0;
+	while (Stack.Num() > 0)
+	{
+		const FSceneOutlinerTreeItemPtr Item = Stack.Pop(EAllowShrinking::No);
+		if (!Item || Item->GetChildren().Num() == 0 || !SavedExpansion.Contains(*Item))
+		{
+			continue;
+		}
+
+		Batch.SetItemExpansion(SOutliner, Item, true);
+		++NumExpanded;
+		for (const TWeakPtr<ISceneOutlinerTreeItem>& Child : Item->GetChildren())
+		{
+			Stack.Add(Child.Pin());
+		}
+	}
+
+	OUTLINER_SHORTCUTS_LOG_D("Expanded %d items out of %d keys", NumExpanded, SavedExpansion.Num());
+}
+
+void FSceneOutlinerExpansionCache::SaveExpansion()
+{
+	SaveExpansion(FOutlinerShortcutsEditorModule::GetCurrentEditorWorld());
+}
+
+void FSceneOutlinerExpansionCache::SaveExpansion(UWorld* World)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(SaveExpansion);
+	if (!World)
+	{
+		return;
+	}
+
+	const FString MapPackageName = World->GetOutermost()->GetName();
+	if (FPackageName::IsTempPackage(MapPackageName))
+	{
+		// Untitled maps can't be found again
+		return;
+	}
+
+	SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+	if (!SOutliner || !FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(SOutliner))
+	{
+		return;
+	}
+	SaveExpansion(*SOutliner, MapPackageName);
+}
+
+void FSceneOutlinerExpansionCache::SaveExpansion(SSceneOutliner& SOutliner, const FString& MapPackageName)
+{
+	// Gather the visible items with children on the game thread, the items under a collapsed one are not visible and don't need to be saved.
+	// The items are interned so the table has a single key per item, and the bitset is indexed like the table.
+	FSceneOutlinerItemInterner Interner;
+	FSceneOutlinerExpansionSet ExpandedItems;
+	TArray<FString> Keys;
+
+	TArray<FSceneOutlinerTreeItemPtr> Stack = FOutlinerShortcutsEditorModule::GetSceneOutlinerRootItems(&SOutliner);
+	while (Stack.Num() > 0)
+	{
+		const FSceneOutlinerTreeItemPtr Item = Stack.Pop(EAllowShrinking::No);
+		if (!Item || Item->GetChildren().Num() == 0)
+		{
+			continue;
+		}
+
+		if (Interner.Find(Item->GetID()) != INDEX_NONE)
+		{
+			// Already saved
+			continue;
+		}
+		FString Key = GetStableItemKey(*Item);
+		if (Key.IsEmpty())
+		{
+			continue;
+		}
+
+		// Only the items with a key are interned, so their index is their index in the table
+		const bool bIsExpanded = Item->Flags.bIsExpanded;
+		const int32 Index = Interner.Intern(Item->GetID());
+		Keys.Add(MoveTemp(Key));
+		if (bIsExpanded)
+		{
+			ExpandedItems.Add(Index);
+		}
+
+		if (bIsExpanded)
+		{
+			for (const TWeakPtr<ISceneOutlinerTreeItem>& Child : Item->GetChildren())
+			{
+				Stack.Add(Child.Pin());
+			}
+		}
+	}
+
+	// The trailing collapsed items are not in the set, the file has a bit for each key
+	TBitArray<> Expanded = ExpandedItems.GetBits();
+	Expanded.SetNum(Keys.Num(), false);
+
+	// Serialize and write the file in the background
+	PendingWrites.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [Filename = GetCacheFilename(MapPackageName), Keys = MoveTemp(Keys), Expanded = MoveTemp(Expanded)]() mutable
+		{
+			TArray<uint8> Data;
+			FMemoryWriter Writer(Data);
+			SerializeExpansionCache(Writer, Keys, Expanded);
+
+			// Write next to the file and swap, so a file being read is never half written
+			const FString TempFilename = Filename + TEXT(".tmp");
+			if (FFileHelper::SaveArrayToFile(Data, *TempFilename))
+			{
+				IFileManager::Get().Move(*Filename, *TempFilename, true, true);
+			}
+		}));
+}
+
+FString FSceneOutlinerExpansionCache::GetStableItemKey(const ISceneOutlinerTreeItem& Item)
+{
+	if (const FActorTreeItem* ActorItem = Item.CastTo<FActorTreeItem>())
+	{
+		if (const AActor* Actor = ActorItem->Actor.Get())
+		{
+			return TEXT("A:") + Actor->GetPathName();
+		}
+		return FString();
+	}
+	if (const FFolderTreeItem* FolderItem = Item.CastTo<FFolderTreeItem>())
+	{
+		return TEXT("F:") + FolderItem->GetPath().ToString();
+	}
+	if (Item.IsA<FWorldTreeItem>())
+	{
+		return TEXT("W:");
+	}
+	return TEXT("I:") + Item.GetDisplayString();
+}
+
+FString FSceneOutlinerExpansionCache::GetCacheFilename(const FString& MapPackageName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("OutlinerShortcuts") / TEXT("ExpansionState") / FPaths::MakeValidFileName(MapPackageName.Replace(TEXT("/"), TEXT("_")), TEXT('_')) + TEXT(".bin");
+}
+
+void FSceneOutlinerExpansionCache::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	// The Outliner still displays the map being closed at this point
+	if (World && World == FOutlinerShortcutsEditorModule::GetCurrentEditorWorld())
+	{
+		SaveExpansion(World);
+	}
+}
+
+void FSceneOutlinerExpansionCache::WaitForPendingWrites()
+{
+	if (PendingWrites.Num() > 0)
+	{
+		UE::Tasks::Wait(PendingWrites);
+		PendingWrites.Empty();
+	}
+}
+
+bool FSceneOutlinerExpansionCache::LoadExpandedKeys(const FString& Filename, TArray<FString>& OutExpandedKeys)
+{
+	TArray<FString> Keys;
+	TBitArray<> Expanded;
+	bool bLoaded = false;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const int64 FileSize = PlatformFile.FileSize(*Filename);
+	if (FileSize < 0)
+	{
+		return false;
+	}
+	if (FileSize > MAX_int32)
+	{
+		// The readers only take 32 bits sizes, and no Outliner has enough rows to write such a file
+		OUTLINER_SHORTCUTS_WARN_H("The expansion cache `%s` is too large to be read (%lld bytes)", *Filename, FileSize);
+		return false;
+	}
+
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Filename));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+	if (MappedRegion && MappedRegion->GetMappedSize() <= MAX_int32)
+	{
+		FMemoryReaderView Reader(MakeArrayView(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()));
+		SerializeExpansionCache(Reader, Keys, Expanded);
+		bLoaded = !Reader.IsError();
+	}
+	else
+	{
+		// Not all platforms support memory mapping
+		TArray<uint8> Data;
+		if (FFileHelper::LoadFileToArray(Data, *Filename))
+		{
+			FMemoryReader Reader(Data);
+			SerializeExpansionCache(Reader, Keys, Expanded);
+			bLoaded = !Reader.IsError();
+		}
+	}
+
+	if (!bLoaded)
+	{
+		OUTLINER_SHORTCUTS_WARN_H("Not able to read the expansion cache `%s`", *Filename);
+		return false;
+	}
+
+	OutExpandedKeys.Reserve(Expanded.CountSetBits());
+	for (TConstSetBitIterator<> It(Expanded); It; ++It)
+	{
+		OutExpandedKeys.Add(MoveTemp(Keys[It.GetIndex()]));
+	}
+	return true;
+}
+
+void FSceneOutlinerSavedExpansion::Resolve()
+{
+	check(IsInGameThread());
+	if (bIsResolved)
+	{
+		return;
+	}
+	bIsResolved = true;
+
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ResolveSavedExpansion);
+	int32 NumUnresolved = 0;
+	for (const FString& Key : ExpandedKeys)
+	{
+		// Keys are built by `FSceneOutlinerExpansionCache::GetStableItemKey`
+		const FString Value = Key.Mid(2);
+		if (Key.StartsWith(TEXT("A:"), ESearchCase::CaseSensitive))
+		{
+			// Actors deleted since are not in the Outliner either
+			if (const AActor* Actor = Cast<AActor>(FSoftObjectPath(Value).ResolveObject()))
+			{
+				ExpandedItems.Add(Interner.Intern(FSceneOutlinerTreeItemID(Actor)));
+			}
+			else
+			{
+				++NumUnresolved;
+			}
+		}
+		else if (Key.StartsWith(TEXT("F:"), ESearchCase::CaseSensitive))
+		{
+			ExpandedFolders.Add(FName(*Value));
+		}
+		else if (Key.StartsWith(TEXT("W:"), ESearchCase::CaseSensitive))
+		{
+			bIsWorldExpanded = true;
+		}
+		else if (Key.StartsWith(TEXT("I:"), ESearchCase::CaseSensitive))
+		{
+			ExpandedOtherKeys.Add(Value);
+		}
+	}
+
+	OUTLINER_SHORTCUTS_LOG_D("Resolved %d expanded keys, %d actors not found", ExpandedKeys.Num(), NumUnresolved);
+}
+
+bool FSceneOutlinerSavedExpansion::Contains(const ISceneOutlinerTreeItem& Item) const
+{
+	if (Item.IsA<FActorTreeItem>())
+	{
+		return ExpandedItems.Contains(Interner.Find(Item.GetID()));
+	}
+	if (const FFolderTreeItem* FolderItem = Item.CastTo<FFolderTreeItem>())
+	{
+		return ExpandedFolders.Contains(FolderItem->GetPath());
+	}
+	if (Item.IsA<FWorldTreeItem>())
+	{
+		return bIsWorldExpanded;
+	}
+	return ExpandedOtherKeys.Num() > 0 && ExpandedOtherKeys.Contains(Item.GetDisplayString());
+}
@@ -0,0 +1,316 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerExpansionFrontier.h"
+
+#include "OutlinerShortcutsEditor.h"
+#include "SceneOutlinerTreeModel.h"
+#include "SceneOutlinerTreePolicies.h"
+#include "OutlinerShortcutsStats.h"
+
+
+int32 FSceneOutlinerExpansionFrontier::ExpandToDepth(ISceneOutlinerTreeModel& Model, int32 Depth)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(FrontierExpandToDepth);
+	Depth = FMath::Max(Depth, 0);
+	NumVisited = 0;
+
+	if (!Validate(Model))
+	{
+		Rebuild(Model, Depth);
+	}
+	else
+	{
+		while (GetDepth() > Depth && CollapseOneLevel(Model))
+		{
+		}
+		while (GetDepth() < Depth && ExpandOneLevel(Model))
+		{
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	return NumVisited;
+}
+
+bool FSceneOutlinerExpansionFrontier::ExpandOneLevel(ISceneOutlinerTreeModel& Model)
+{
+	if (!Validate(Model))
+	{
+		Rebuild(Model, FindVisibleDepth(Model));
+	}
+
+	TSet<int32> ExpandedLevel;
+	TSet<int32> NextFrontier;
+	TArray<int32> Children;
+	for (const int32 Item : Frontier)
+	{
+		++NumVisited;
+		// The item might have been removed from the tree
+		if (!Model.HasChildren(Item))
+		{
+			continue;
+		}
+
+		Model.SetExpanded(Item, true);
+		ExpandedLevel.Add(Item);
+
+		Children.Reset();
+		Model.GetChildren(Item, Children);
+		for (const int32 Child : Children)
+		{
+			++NumVisited;
+			if (Model.HasChildren(Child))
+			{
+				// Children might still be expanded from before, keep the levels even
+				Model.SetExpanded(Child, false);
+				NextFrontier.Add(Child);
+			}
+		}
+	}
+
+	if (ExpandedLevel.Num() == 0)
+	{
+		return false;
+	}
+
+	ExpandedLevels.Add(MoveTemp(ExpandedLevel));
+	Frontier = MoveTemp(NextFrontier);
+	return true;
+}
+
+bool FSceneOutlinerExpansionFrontier::CollapseOneLevel(ISceneOutlinerTreeModel& Model)
+{
+	if (!Validate(Model))
+	{
+		Rebuild(Model, FindVisibleDepth(Model));
+	}
+
+	if (ExpandedLevels.Num() == 0)
+	{
+		return false;
+	}
+
+	TSet<int32> CollapsedLevel = ExpandedLevels.Pop();
+	for (const int32 Item : CollapsedLevel)
+	{
+		++NumVisited;
+		Model.SetExpanded(Item, false);
+	}
+	Frontier = MoveTemp(CollapsedLevel);
+	return true;
+}
+
+void FSceneOutlinerExpansionFrontier::UpdateItems(ISceneOutlinerTreeModel& Model, const TArray<int32>& Items)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(FrontierUpdateItems);
+	if (!bIsValid)
+	{
+		return;
+	}
+
+	const int32 Depth = GetDepth();
+	int32 NumUpdated = 0;
+	TArray<TPair<int32, int32>> Stack;
+	TArray<int32> Children;
+	for (const int32 Item : Items)
+	{
+		// The subtree moved along with the item, forget the levels its items were in
+		Stack.Reset();
+		Stack.Emplace(Item, 0);
+		while (Stack.Num() > 0)
+		{
+			const TPair<int32, int32> Entry = Stack.Pop(EAllowShrinking::No);
+			++NumUpdated;
+			Untrack(Entry.Key);
+			if (Entry.Value < Depth)
+			{
+				Children.Reset();
+				Model.GetChildren(Entry.Key, Children);
+				for (const int32 Child : Children)
+				{
+					Stack.Emplace(Child, Entry.Value + 1);
+				}
+			}
+		}
+
+		// The parents might have had no children before, and need to be tracked now
+		const int32 ItemDepth = FSceneOutlinerTreePolicies::GetDepth(Model, Item);
+		int32 ParentDepth = ItemDepth - 1;
+		for (int32 Parent = Model.GetParent(Item); Parent != INDEX_NONE; Parent = Model.GetParent(Parent), --ParentDepth)
+		{
+			if (ParentDepth <= Depth && !Track(Model, Parent, ParentDepth))
+			{
+				break;
+			}
+		}
+
+		// Items below the frontier are hidden, they are collapsed when their parent is expanded
+		if (ItemDepth > Depth)
+		{
+			continue;
+		}
+		Stack.Reset();
+		Stack.Emplace(Item, ItemDepth);
+		while (Stack.Num() > 0)
+		{
+			const TPair<int32, int32> Entry = Stack.Pop(EAllowShrinking::No);
+			++NumUpdated;
+			if (!Model.HasChildren(Entry.Key))
+			{
+				continue;
+			}
+
+			Track(Model, Entry.Key, Entry.Value);
+			if (Entry.Value < Depth)
+			{
+				Children.Reset();
+				Model.GetChildren(Entry.Key, Children);
+				for (const int32 Child : Children)
+				{
+					Stack.Emplace(Child, Entry.Value + 1);
+				}
+			}
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumUpdated);
+	OUTLINER_SHORTCUTS_LOG_D("Updated the expansion frontier from %d items, %d items visited", Items.Num(), NumUpdated);
+}
+
+void FSceneOutlinerExpansionFrontier::RemoveItems(const TArray<int32>& Items)
+{
+	for (const int32 Item : Items)
+	{
+		Untrack(Item);
+	}
+}
+
+bool FSceneOutlinerExpansionFrontier::Track(ISceneOutlinerTreeModel& Model, int32 Item, int32 ItemDepth)
+{
+	const bool bExpanded = ItemDepth < GetDepth();
+	bool bIsAlreadyTracked = false;
+	if (bExpanded)
+	{
+		ExpandedLevels[ItemDepth].Add(Item, &bIsAlreadyTracked);
+	}
+	else
+	{
+		Frontier.Add(Item, &bIsAlreadyTracked);
+	}
+
+	if (Model.IsExpanded(Item) != bExpanded)
+	{
+		Model.SetExpanded(Item, bExpanded);
+	}
+	return !bIsAlreadyTracked;
+}
+
+void FSceneOutlinerExpansionFrontier::Untrack(int32 Item)
+{
+	Frontier.Remove(Item);
+	for (TSet<int32>& Level : ExpandedLevels)
+	{
+		Level.Remove(Item);
+	}
+}
+
+void FSceneOutlinerExpansionFrontier::Invalidate()
+{
+	ExpandedLevels.Empty();
+	Frontier.Empty();
+	bIsValid = false;
+}
+
+void FSceneOutlinerExpansionFrontier::Rebuild(ISceneOutlinerTreeModel& Model, int32 Depth)
+{
+	OUTLINER_SHORTCUTS_LOG_D("Rebuilding the expansion frontier to depth %d", Depth);
+	Invalidate();
+
+	NumVisited += Model.SetAllExpanded(false);
+	TArray<int32> Roots;
+	Model.GetRootItems(Roots);
+	for (const int32 Root : Roots)
+	{
+		++NumVisited;
+		if (Model.HasChildren(Root))
+		{
+			Frontier.Add(Root);
+		}
+	}
+	bIsValid = true;
+
+	while (GetDepth() < Depth && ExpandOneLevel(Model))
+	{
+	}
+}
+
+bool FSceneOutlinerExpansionFrontier::Validate(const ISceneOutlinerTreeModel& Model)
+{
+	if (!bIsValid)
+	{
+		return false;
+	}
+
+	// Only the two levels we are about to touch are checked, so this stays in the cost of a single step
+	auto IsLevelInState = [&Model](const TSet<int32>& Level, bool bExpanded)
+	{
+		for (const int32 Item : Level)
+		{
+			// Items removed from the tree, or left without children, can't be expanded anymore
+			if (Model.IsExpanded(Item) != bExpanded && Model.HasChildren(Item))
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	if (!IsLevelInState(Frontier, false) || (ExpandedLevels.Num() > 0 && !IsLevelInState(ExpandedLevels.Last(), true)))
+	{
+		Invalidate();
+		return false;
+	}
+	return true;
+}
+
+int32 FSceneOutlinerExpansionFrontier::FindVisibleDepth(const ISceneOutlinerTreeModel& Model)
+{
+	// Walk down the expanded items only, so this costs the number of visible rows
+	int32 VisibleDepth = MAX_int32;
+	int32 ExpandedDepth = 0;
+
+	TArray<TPair<int32, int32>> Stack;
+	TArray<int32> Children;
+	Model.GetRootItems(Children);
+	for (const int32 Root : Children)
+	{
+		Stack.Emplace(Root, 0);
+	}
+
+	while (Stack.Num() > 0)
+	{
+		const TPair<int32, int32> Entry = Stack.Pop(EAllowShrinking::No);
+		++NumVisited;
+		if (Entry.Value >= VisibleDepth || !Model.HasChildren(Entry.Key))
+		{
+			continue;
+		}
+
+		if (!Model.IsExpanded(Entry.Key))
+		{
+			VisibleDepth = Entry.Value;
+			continue;
+		}
+
+		ExpandedDepth = FMath::Max(ExpandedDepth, Entry.Value + 1);
+		Children.Reset();
+		Model.GetChildren(Entry.Key, Children);
+		for (const int32 Child : Children)
+		{
+			Stack.Emplace(Child, Entry.Value + 1);
+		}
+	}
+
+	// Nothing left to expand, the tree is fully expanded
+	return VisibleDepth == MAX_int32 ? ExpandedDepth : VisibleDepth;
+}
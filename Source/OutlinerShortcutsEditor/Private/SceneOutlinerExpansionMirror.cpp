@@ -0,0 +1,318 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerExpansionMirror.h"
+
+#if UE5_1_ONWARDS
+
+#include "SSceneOutliner.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "SceneOutlinerFingerprints.h"
+#include "SceneOutlinerHierarchyIndex.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "Editor.h"
+#include "Framework/Application/SlateApplication.h"
+
+namespace
+{
+	// Delay between two checks of the other Outliners in live mode, the changes of the source are sent on the next check
+	constexpr float LiveMirrorInterval = 0.1f;
+}
+
+FSceneOutlinerExpansionMirror* FSceneOutlinerExpansionMirror::Instance = nullptr;
+
+void FSceneOutlinerExpansionMirror::OnStartupModule()
+{
+	Instance = this;
+}
+
+void FSceneOutlinerExpansionMirror::OnShutdownModule()
+{
+	StopLiveMirror();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerExpansionMirror* FSceneOutlinerExpansionMirror::Get()
+{
+	return Instance;
+}
+
+bool FSceneOutlinerExpansionMirror::MirrorFrom(SSceneOutliner& Source)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(MirrorExpansion);
+	const TArray<TSharedRef<SSceneOutliner>> Targets = GetTargets(Source);
+	if (Targets.Num() == 0)
+	{
+		return false;
+	}
+
+	if (!IsLiveMirrorRunning())
+	{
+		// The indices are only kept while they are used by the live mode
+		Interner.Reset();
+	}
+
+	const FSceneOutlinerExpansionSet SourceSet = FSceneOutlinerExpansionSet::Capture(Source, Interner);
+	FSceneOutlinerExpansionBatch Batch;
+	for (const TSharedRef<SSceneOutliner>& Target : Targets)
+	{
+		TArray<int32> Expanded;
+		TArray<int32> Collapsed;
+		FSceneOutlinerExpansionSet::Diff(FSceneOutlinerExpansionSet::Capture(Target.Get(), Interner), SourceSet, Expanded, Collapsed);
+		ApplyChanges(Batch, Target.Get(), Expanded, Collapsed);
+		OUTLINER_SHORTCUTS_LOG_D("Mirroring `%s` to `%s`: %d items to expand, %d to collapse", *Source.GetOutlinerIdentifier().ToString(), *Target->GetOutlinerIdentifier().ToString(), Expanded.Num(), Collapsed.Num());
+	}
+	return true;
+}
+
+void FSceneOutlinerExpansionMirror::StartLiveMirror(SSceneOutliner& Source)
+{
+	StopLiveMirror();
+
+	LiveSource = StaticCastSharedRef<SSceneOutliner>(Source.AsShared());
+	ResetLiveState();
+
+	// The changes of the source are reported by the batches, the hierarchy events and the input, the ticker only sends them
+	if (FSceneOutlinerFingerprints* Fingerprints = FSceneOutlinerFingerprints::Get())
+	{
+		OnItemExpansionChangedHandle = Fingerprints->OnItemExpansionChanged().AddRaw(this, &FSceneOutlinerExpansionMirror::OnItemExpansionChanged);
+	}
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		HierarchyIndex->TrackOutliner(&Source);
+		OnOutlinerHierarchyChangedHandle = HierarchyIndex->OnOutlinerHierarchyChanged().AddRaw(this, &FSceneOutlinerExpansionMirror::OnOutlinerHierarchyChanged);
+	}
+	OnMapChangeHandle = FEditorDelegates::MapChange.AddRaw(this, &FSceneOutlinerExpansionMirror::OnMapChange);
+	if (FSlateApplication::IsInitialized())
+	{
+		OnMousePreInputButtonDownHandle = FSlateApplication::Get().OnApplicationMousePreInputButtonDownListener().AddRaw(this, &FSceneOutlinerExpansionMirror::OnMousePreInputButtonDown);
+		OnPreInputKeyDownHandle = FSlateApplication::Get().OnApplicationPreInputKeyDownListener().AddRaw(this, &FSceneOutlinerExpansionMirror::OnPreInputKeyDown);
+	}
+
+	LiveMirrorHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSceneOutlinerExpansionMirror::TickLiveMirror), LiveMirrorInterval);
+	OUTLINER_SHORTCUTS_LOG_H("Started mirroring the expansion of `%s`", *Source.GetOutlinerIdentifier().ToString());
+
+	// The first tick brings all the Outliners in sync
+	TickLiveMirror(0.f);
+}
+
+void FSceneOutlinerExpansionMirror::StopLiveMirror()
+{
+	if (LiveMirrorHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(LiveMirrorHandle);
+		LiveMirrorHandle.Reset();
+		OUTLINER_SHORTCUTS_LOG_H("Stopped mirroring the expansion");
+	}
+
+	if (FSceneOutlinerFingerprints* Fingerprints = FSceneOutlinerFingerprints::Get())
+	{
+		Fingerprints->OnItemExpansionChanged().Remove(OnItemExpansionChangedHandle);
+	}
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		HierarchyIndex->OnOutlinerHierarchyChanged().Remove(OnOutlinerHierarchyChangedHandle);
+	}
+	FEditorDelegates::MapChange.Remove(OnMapChangeHandle);
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnApplicationMousePreInputButtonDownListener().Remove(OnMousePreInputButtonDownHandle);
+		FSlateApplication::Get().OnApplicationPreInputKeyDownListener().Remove(OnPreInputKeyDownHandle);
+	}
+	OnItemExpansionChangedHandle.Reset();
+	OnOutlinerHierarchyChangedHandle.Reset();
+	OnMapChangeHandle.Reset();
+	OnMousePreInputButtonDownHandle.Reset();
+	OnPreInputKeyDownHandle.Reset();
+
+	LiveSource.Reset();
+	ResetLiveState();
+	bSourceNeedsCapture = false;
+	Interner.Reset();
+}
+
+void FSceneOutlinerExpansionMirror::ResetLiveState()
+{
+	LiveSourceSet.Reset();
+	PendingChanges.Empty();
+	SyncedTargets.Empty();
+	bSourceNeedsCapture = true;
+}
+
+bool FSceneOutlinerExpansionMirror::TickLiveMirror(float DeltaTime)
+{
+	const TSharedPtr<SSceneOutliner> Source = LiveSource.Pin();
+	if (!Source)
+	{
+		OUTLINER_SHORTCUTS_LOG_D("The mirrored Outliner was closed");
+		// Returning false removes the ticker, the handle only has to be forgotten
+		LiveMirrorHandle.Reset();
+		StopLiveMirror();
+		return false;
+	}
+	if (!FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(Source.Get()))
+	{
+		return true;
+	}
+
+	const TArray<TSharedRef<SSceneOutliner>> Targets = GetTargets(*Source);
+	for (auto It = SyncedTargets.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (!bSourceNeedsCapture && PendingChanges.Num() == 0 && SyncedTargets.Num() == Targets.Num())
+	{
+		return true;
+	}
+
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(LiveMirrorExpansion);
+	if (bSourceNeedsCapture)
+	{
+		// Any visible item might have been flipped, what differs from the last known state is sent along with the reported changes
+		FSceneOutlinerExpansionSet SourceSet = FSceneOutlinerExpansionSet::Capture(*Source, Interner);
+		TArray<int32> CapturedExpanded;
+		TArray<int32> CapturedCollapsed;
+		FSceneOutlinerExpansionSet::Diff(LiveSourceSet, SourceSet, CapturedExpanded, CapturedCollapsed);
+		for (const int32 Index : CapturedExpanded)
+		{
+			PendingChanges.Add(Index, true);
+		}
+		for (const int32 Index : CapturedCollapsed)
+		{
+			PendingChanges.Add(Index, false);
+		}
+		LiveSourceSet = MoveTemp(SourceSet);
+		bSourceNeedsCapture = false;
+	}
+
+	// The Outliners already in sync only receive what changed in the source since the last tick
+	TArray<int32> SourceExpanded;
+	TArray<int32> SourceCollapsed;
+	for (const TPair<int32, bool>& Change : PendingChanges)
+	{
+		(Change.Value ? SourceExpanded : SourceCollapsed).Add(Change.Key);
+	}
+	PendingChanges.Reset();
+
+	FSceneOutlinerExpansionBatch Batch;
+	for (const TSharedRef<SSceneOutliner>& Target : Targets)
+	{
+		if (SyncedTargets.Contains(&Target.Get()))
+		{
+			ApplyChanges(Batch, Target.Get(), SourceExpanded, SourceCollapsed);
+			continue;
+		}
+
+		TArray<int32> Expanded;
+		TArray<int32> Collapsed;
+		FSceneOutlinerExpansionSet::Diff(FSceneOutlinerExpansionSet::Capture(Target.Get(), Interner), LiveSourceSet, Expanded, Collapsed);
+		ApplyChanges(Batch, Target.Get(), Expanded, Collapsed);
+		SyncedTargets.Add(&Target.Get(), Target);
+	}
+	return true;
+}
+
+void FSceneOutlinerExpansionMirror::OnItemExpansionChanged(const SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemID& ID, bool bIsExpanded)
+{
+	// The changes sent to the targets are reported too, only the ones of the source are kept
+	if (!LiveSource.HasSameObject(&SOutliner))
+	{
+		return;
+	}
+
+	const int32 Index = Interner.Intern(ID);
+	if (bIsExpanded)
+	{
+		LiveSourceSet.Add(Index);
+	}
+	else
+	{
+		LiveSourceSet.Remove(Index);
+	}
+	PendingChanges.Add(Index, bIsExpanded);
+}
+
+void FSceneOutlinerExpansionMirror::OnOutlinerHierarchyChanged(SSceneOutliner* SOutliner, const FSceneOutlinerHierarchyChangedData& Data)
+{
+	// New items can come expanded
+	if (LiveSource.HasSameObject(SOutliner))
+	{
+		bSourceNeedsCapture = true;
+	}
+}
+
+void FSceneOutlinerExpansionMirror::OnMapChange(uint32 MapChangeFlags)
+{
+	ResetLiveState();
+	Interner.Reset();
+}
+
+void FSceneOutlinerExpansionMirror::OnMousePreInputButtonDown(const FPointerEvent& MouseEvent)
+{
+	// Clicking in the source might expand or collapse its items, rows included as double-clicking a folder expands it
+	const TSharedPtr<SSceneOutliner> Source = LiveSource.Pin();
+	if (Source && Source->GetTree().GetTickSpaceGeometry().IsUnderLocation(MouseEvent.GetScreenSpacePosition()))
+	{
+		bSourceNeedsCapture = true;
+	}
+}
+
+void FSceneOutlinerExpansionMirror::OnPreInputKeyDown(const FKeyEvent& KeyEvent)
+{
+	// The tree view expands and collapses its selected items with the left and right arrows
+	const FKey Key = KeyEvent.GetKey();
+	if (Key != EKeys::Left && Key != EKeys::Right)
+	{
+		return;
+	}
+	const TSharedPtr<SSceneOutliner> Source = LiveSource.Pin();
+	if (Source && (Source->GetTree().HasKeyboardFocus() || Source->GetTree().HasFocusedDescendants()))
+	{
+		bSourceNeedsCapture = true;
+	}
+}
+
+int32 FSceneOutlinerExpansionMirror::ApplyChanges(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& Target, const TArray<int32>& Expanded, const TArray<int32>& Collapsed) const
+{
+	int32 NumFound = 0;
+	auto Apply = [this, &Batch, &Target, &NumFound](const TArray<int32>& Indices, bool bIsExpanded)
+	{
+		for (const int32 Index : Indices)
+		{
+			// Items that are not in this Outliner (ex: filtered out) are simply skipped
+			if (const FSceneOutlinerTreeItemPtr Item = Target.GetTreeItem(Interner.GetID(Index)))
+			{
+				Batch.SetItemExpansion(Target, Item, bIsExpanded);
+				++NumFound;
+			}
+		}
+	};
+	Apply(Expanded, true);
+	Apply(Collapsed, false);
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, Expanded.Num() + Collapsed.Num());
+	return NumFound;
+}
+
+TArray<TSharedRef<SSceneOutliner>> FSceneOutlinerExpansionMirror::GetTargets(const SSceneOutliner& Source)
+{
+	TArray<TSharedRef<SSceneOutliner>> Targets;
+	for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+	{
+		if (&SOutliner.Get() != &Source && FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(&SOutliner.Get()))
+		{
+			Targets.Add(SOutliner);
+		}
+	}
+	return Targets;
+}
+
+#endif
@@ -0,0 +1,213 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerExpansionPlanner.h"
+
+#include "SSceneOutliner.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "SceneOutlinerExpansionCache.h"
+#include "SceneOutlinerHierarchySnapshot.h"
+#include "OutlinerShortcutsSettings.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+
+FSceneOutlinerExpansionPlanner* FSceneOutlinerExpansionPlanner::Instance = nullptr;
+
+void FSceneOutlinerExpansionPlanner::OnStartupModule()
+{
+	Instance = this;
+}
+
+void FSceneOutlinerExpansionPlanner::OnShutdownModule()
+{
+	CancelMapOpenPlan();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerExpansionPlanner* FSceneOutlinerExpansionPlanner::Get()
+{
+	return Instance;
+}
+
+bool FSceneOutlinerExpansionPlanner::StartMapOpenPlan(UWorld* World)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(StartMapOpenPlan);
+	CancelMapOpenPlan();
+
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!World || !EditorSettings)
+	{
+		return false;
+	}
+
+#if UE5_1_ONWARDS
+	// The plan is shared by all the Outliners, the ones with their own behavior are applied directly
+	if (EditorSettings->OutlinerExpansionBehaviorOverrides.Num() > 0)
+	{
+		return false;
+	}
+#endif
+
+	switch (EditorSettings->DefaultOutlinerExpansionBehaviorOnMapOpen)
+	{
+	case EOutlinerExpansionBehaviorOnMapOpen::ExpandToDepth:
+	{
+		const TSharedRef<FSceneOutlinerHierarchySnapshot> Snapshot = FSceneOutlinerHierarchySnapshot::Capture(*World);
+		PlanTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot, Depth = EditorSettings->ExpandToDepth]()
+			{
+				Snapshot->Build();
+				FPlan Plan;
+				Plan.ExpandedItems = Snapshot->ComputeExpandToDepthItems(Depth);
+				return Plan;
+			});
+		break;
+	}
+	case EOutlinerExpansionBehaviorOnMapOpen::ExpandMatchingFolders:
+	{
+		// The matcher is copied as the settings can change while the task runs
+		const TSharedRef<FSceneOutlinerHierarchySnapshot> Snapshot = FSceneOutlinerHierarchySnapshot::Capture(*World);
+		PlanTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot, Matcher = EditorSettings->GetFolderPatternMatcher()]()
+			{
+				Snapshot->Build();
+				FPlan Plan;
+				Plan.ExpandedItems = Snapshot->ComputeMatchingFolderItems(Matcher);
+				return Plan;
+			});
+		break;
+	}
+	case EOutlinerExpansionBehaviorOnMapOpen::RestoreLastState:
+		if (FSceneOutlinerExpansionCache* ExpansionCache = FSceneOutlinerExpansionCache::Get())
+		{
+			const UE::Tasks::TTask<TOptional<FSceneOutlinerSavedExpansion>> LoadTask = ExpansionCache->LoadSavedExpansionAsync(World->GetOutermost()->GetName());
+			PlanTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [LoadTask]()
+				{
+					FPlan Plan;
+					Plan.SavedExpansion = LoadTask.GetResult();
+					return Plan;
+				}, UE::Tasks::Prerequisites(LoadTask));
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (!PlanTask.IsValid())
+	{
+		return false;
+	}
+
+	PlanWorld = World;
+	PlanStartTime = FPlatformTime::Seconds();
+	OUTLINER_SHORTCUTS_LOG_D("Started planning the expansion of `%s`", *World->GetName());
+	return true;
+}
+
+bool FSceneOutlinerExpansionPlanner::IsMapOpenPlanRunning() const
+{
+	return PlanTask.IsValid() && !PlanTask.IsCompleted() && PlanWorld.IsValid() && PlanWorld.Get() == FOutlinerShortcutsEditorModule::GetCurrentEditorWorld();
+}
+
+bool FSceneOutlinerExpansionPlanner::ApplyMapOpenPlan()
+{
+	if (!PlanTask.IsValid() || !PlanWorld.IsValid() || PlanWorld.Get() != FOutlinerShortcutsEditorModule::GetCurrentEditorWorld())
+	{
+		CancelMapOpenPlan();
+		return false;
+	}
+
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(ApplyMapOpenPlan);
+	const bool bWasCompleted = PlanTask.IsCompleted();
+	FPlan& Plan = PlanTask.GetResult();
+	OUTLINER_SHORTCUTS_LOG_D("Expansion plan %s after %.3fs", bWasCompleted ? TEXT("ready") : TEXT("waited for"), FPlatformTime::Seconds() - PlanStartTime);
+
+	if (!Plan.ExpandedItems.IsSet() && !Plan.SavedExpansion.IsSet())
+	{
+		// Nothing saved for this map, the settings know what to do instead
+		CancelMapOpenPlan();
+		return false;
+	}
+	if (Plan.SavedExpansion.IsSet())
+	{
+		// Once for all the Outliners
+		Plan.SavedExpansion->Resolve();
+	}
+
+	bool bAllApplied = true;
+	{
+		FSceneOutlinerExpansionBatch Batch;
+#if PRE_UE5_1
+		SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+		if (SOutliner && FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(SOutliner))
+		{
+			ApplyPlan(Batch, *SOutliner, Plan);
+		}
+		else
+		{
+			bAllApplied = false;
+		}
+#else
+		for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+		{
+			if (FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(&SOutliner.Get()))
+			{
+				ApplyPlan(Batch, SOutliner.Get(), Plan);
+			}
+			else
+			{
+				bAllApplied = false;
+				OUTLINER_SHORTCUTS_WARN_H_RL("SceneOutliner `%s` is not ready", *SOutliner->GetOutlinerIdentifier().ToString());
+			}
+		}
+#endif
+	}
+
+	CancelMapOpenPlan();
+	return bAllApplied;
+}
+
+void FSceneOutlinerExpansionPlanner::CancelMapOpenPlan()
+{
+	// Tasks can't be cancelled, the result of a running one is simply dropped once it finishes
+	PlanTask = UE::Tasks::TTask<FPlan>();
+	PlanWorld.Reset();
+}
+
+void FSceneOutlinerExpansionPlanner::ApplyExpandedItems(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const TArray<FSceneOutlinerTreeItemID>& ExpandedItems)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ApplyExpandedItems);
+
+	// Setting them through the batch only changes the items whose expansion differs from the items given
+	Batch.CollapseAll(SOutliner);
+
+	int32 NumExpanded = 0;
+	for (const FSceneOutlinerTreeItemID& ID : ExpandedItems)
+	{
+		// Items hidden by a filter are not in the tree
+		const FSceneOutlinerTreeItemPtr Item = SOutliner.GetTreeItem(ID);
+		if (Item && Item->GetChildren().Num() > 0)
+		{
+			Batch.SetItemExpansion(SOutliner, Item, true);
+			++NumExpanded;
+		}
+	}
+
+	OUTLINER_SHORTCUTS_LOG_D("Expanded %d items out of %d planned", NumExpanded, ExpandedItems.Num());
+}
+
+void FSceneOutlinerExpansionPlanner::ApplyPlan(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FPlan& Plan)
+{
+	if (Plan.ExpandedItems.IsSet())
+	{
+		ApplyExpandedItems(Batch, SOutliner, Plan.ExpandedItems.GetValue());
+	}
+	else if (Plan.SavedExpansion.IsSet())
+	{
+		FSceneOutlinerExpansionCache::ApplySavedExpansion(Batch, SOutliner, Plan.SavedExpansion.GetValue());
+	}
+}
@@ -0,0 +1,151 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerExpansionSet.h"
+
+#include "OutlinerShortcutsEditor.h"
+#include "SSceneOutliner.h"
+#include "OutlinerShortcutsStats.h"
+
+
+int32 FSceneOutlinerItemInterner::Intern(const FSceneOutlinerTreeItemID& ID)
+{
+	return IDs.Add(ID).AsInteger();
+}
+
+int32 FSceneOutlinerItemInterner::Find(const FSceneOutlinerTreeItemID& ID) const
+{
+	const FSetElementId ElementId = IDs.FindId(ID);
+	return ElementId.IsValidId() ? ElementId.AsInteger() : INDEX_NONE;
+}
+
+void FSceneOutlinerItemInterner::Reset()
+{
+	IDs.Reset();
+}
+
+void FSceneOutlinerExpansionSet::Add(int32 Index)
+{
+	if (Index >= Bits.Num())
+	{
+		Bits.Add(false, Index + 1 - Bits.Num());
+	}
+	Bits[Index] = true;
+}
+
+void FSceneOutlinerExpansionSet::Remove(int32 Index)
+{
+	if (Bits.IsValidIndex(Index))
+	{
+		Bits[Index] = false;
+	}
+}
+
+void FSceneOutlinerExpansionSet::Union(const FSceneOutlinerExpansionSet& Other)
+{
+	Bits.CombineWithBitwiseOR(Other.Bits, EBitwiseOperatorFlags::MaxSize);
+}
+
+void FSceneOutlinerExpansionSet::Intersect(const FSceneOutlinerExpansionSet& Other)
+{
+	Bits.CombineWithBitwiseAND(Other.Bits, EBitwiseOperatorFlags::MinSize);
+}
+
+void FSceneOutlinerExpansionSet::Subtract(const FSceneOutlinerExpansionSet& Other)
+{
+	// AND with the complement of the other set, the items past its end are kept
+	TBitArray<> Mask = Other.Bits;
+	Mask.BitwiseNOT();
+	if (Mask.Num() < Bits.Num())
+	{
+		Mask.Add(true, Bits.Num() - Mask.Num());
+	}
+	Bits.CombineWithBitwiseAND(Mask, EBitwiseOperatorFlags::MaintainSize);
+}
+
+bool FSceneOutlinerExpansionSet::Includes(const FSceneOutlinerExpansionSet& Other) const
+{
+	FSceneOutlinerExpansionSet Missing = Other;
+	Missing.Subtract(*this);
+	return Missing.IsEmpty();
+}
+
+void FSceneOutlinerExpansionSet::Trim()
+{
+	Bits.SetNum(Bits.FindLast(true) + 1, false);
+}
+
+bool FSceneOutlinerExpansionSet::operator==(const FSceneOutlinerExpansionSet& Other) const
+{
+	// The sets can have a different number of trailing unset bits
+	return Bits.CompareSetBits(Other.Bits, false);
+}
+
+FSceneOutlinerExpansionSet FSceneOutlinerExpansionSet::Capture(SSceneOutliner& SOutliner, FSceneOutlinerItemInterner& Interner)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(CaptureExpansionSet);
+	FSceneOutlinerExpansionSet Set;
+
+	TArray<FSceneOutlinerTreeItemPtr> Stack = FOutlinerShortcutsEditorModule::GetSceneOutlinerRootItems(&SOutliner);
+	int32 NumVisited = 0;
+	while (Stack.Num() > 0)
+	{
+		const FSceneOutlinerTreeItemPtr Item = Stack.Pop(EAllowShrinking::No);
+		++NumVisited;
+		if (!Item || !Item->Flags.bIsExpanded || Item->GetChildren().Num() == 0)
+		{
+			continue;
+		}
+
+		Set.Add(Interner.Intern(Item->GetID()));
+		for (const TWeakPtr<ISceneOutlinerTreeItem>& Child : Item->GetChildren())
+		{
+			Stack.Add(Child.Pin());
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	return Set;
+}
+
+FSceneOutlinerExpansionSet FSceneOutlinerExpansionSet::CaptureAll(SSceneOutliner& SOutliner, FSceneOutlinerItemInterner& Interner)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(CaptureAllItemsSet);
+	FSceneOutlinerExpansionSet Set;
+
+	TArray<FSceneOutlinerTreeItemPtr> Stack = FOutlinerShortcutsEditorModule::GetSceneOutlinerRootItems(&SOutliner);
+	int32 NumVisited = 0;
+	while (Stack.Num() > 0)
+	{
+		const FSceneOutlinerTreeItemPtr Item = Stack.Pop(EAllowShrinking::No);
+		if (!Item)
+		{
+			continue;
+		}
+
+		++NumVisited;
+		Set.Add(Interner.Intern(Item->GetID()));
+		for (const TWeakPtr<ISceneOutlinerTreeItem>& Child : Item->GetChildren())
+		{
+			Stack.Add(Child.Pin());
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	return Set;
+}
+
+void FSceneOutlinerExpansionSet::Diff(const FSceneOutlinerExpansionSet& From, const FSceneOutlinerExpansionSet& To, TArray<int32>& OutExpanded, TArray<int32>& OutCollapsed)
+{
+	const TBitArray<> Changed = TBitArray<>::BitwiseXOR(From.Bits, To.Bits, EBitwiseOperatorFlags::MaxSize);
+	for (TConstSetBitIterator<> It(Changed); It; ++It)
+	{
+		if (To.Contains(It.GetIndex()))
+		{
+			OutExpanded.Add(It.GetIndex());
+		}
+		else
+		{
+			OutCollapsed.Add(It.GetIndex());
+		}
+	}
+}
@@ -0,0 +1,296 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerFingerprints.h"
+
+#include "SSceneOutliner.h"
+#include "SceneOutlinerHierarchyIndex.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "Editor.h"
+#include "Framework/Application/SlateApplication.h"
+
+
+const FName FSceneOutlinerFingerprints::CollapseAllPolicy(TEXT("CollapseAll"));
+const FName FSceneOutlinerFingerprints::CollapseToRootPolicy(TEXT("CollapseToRoot"));
+const FName FSceneOutlinerFingerprints::ExpandAllPolicy(TEXT("ExpandAll"));
+
+FSceneOutlinerFingerprints* FSceneOutlinerFingerprints::Instance = nullptr;
+
+FName FSceneOutlinerFingerprints::MakeExpandToDepthPolicy(int32 Depth)
+{
+	return FName(TEXT("ExpandToDepth"), NAME_EXTERNAL_TO_INTERNAL(FMath::Max(Depth, 0)));
+}
+
+void FSceneOutlinerFingerprints::OnStartupModule()
+{
+	Instance = this;
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		OnOutlinerHierarchyChangedHandle = HierarchyIndex->OnOutlinerHierarchyChanged().AddRaw(this, &FSceneOutlinerFingerprints::OnOutlinerHierarchyChanged);
+	}
+	OnMapChangeHandle = FEditorDelegates::MapChange.AddRaw(this, &FSceneOutlinerFingerprints::OnMapChange);
+	// The expansion changes made by the user don't go through the batches
+	if (FSlateApplication::IsInitialized())
+	{
+		OnMousePreInputButtonDownHandle = FSlateApplication::Get().OnApplicationMousePreInputButtonDownListener().AddRaw(this, &FSceneOutlinerFingerprints::OnMousePreInputButtonDown);
+		OnPreInputKeyDownHandle = FSlateApplication::Get().OnApplicationPreInputKeyDownListener().AddRaw(this, &FSceneOutlinerFingerprints::OnPreInputKeyDown);
+	}
+}
+
+void FSceneOutlinerFingerprints::OnShutdownModule()
+{
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		HierarchyIndex->OnOutlinerHierarchyChanged().Remove(OnOutlinerHierarchyChangedHandle);
+	}
+	OnOutlinerHierarchyChangedHandle.Reset();
+	FEditorDelegates::MapChange.Remove(OnMapChangeHandle);
+	OnMapChangeHandle.Reset();
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnApplicationMousePreInputButtonDownListener().Remove(OnMousePreInputButtonDownHandle);
+		FSlateApplication::Get().OnApplicationPreInputKeyDownListener().Remove(OnPreInputKeyDownHandle);
+	}
+	OnMousePreInputButtonDownHandle.Reset();
+	OnPreInputKeyDownHandle.Reset();
+	ItemExpansionChangedEvent.Clear();
+	Reset();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerFingerprints* FSceneOutlinerFingerprints::Get()
+{
+	return Instance;
+}
+
+bool FSceneOutlinerFingerprints::ShouldSkip(SSceneOutliner& SOutliner, const FName Policy)
+{
+	if (!Instance)
+	{
+		return false;
+	}
+
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(CheckFingerprint);
+	OUTLINER_SHORTCUTS_INC_COUNTER(FingerprintsChecked, 1);
+
+	// Binds the live hierarchy of the Outliner if it was rebuilt, which bumps the generation
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		HierarchyIndex->TrackOutliner(&SOutliner);
+	}
+	else
+	{
+		return false;
+	}
+
+	const FFingerprint* Fingerprint = Instance->Fingerprints.Find(&SOutliner);
+	if (!Fingerprint || Fingerprint->Outliner.Pin().Get() != &SOutliner || Fingerprint->Policy != Policy)
+	{
+		return false;
+	}
+	if (Fingerprint->Generation != Instance->Generations.FindRef(&SOutliner) || Fingerprint->ExpansionHash != Instance->GetExpansionHash(SOutliner))
+	{
+		return false;
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(OutlinersSkipped, 1);
+	OUTLINER_SHORTCUTS_LOG_D("`%s` already applied and unchanged, skipped", *Policy.ToString());
+	return true;
+}
+
+void FSceneOutlinerFingerprints::Record(SSceneOutliner& SOutliner, const FName Policy)
+{
+	if (!Instance)
+	{
+		return;
+	}
+
+	// The generation only moves if the hierarchy of the Outliner is listened to
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		HierarchyIndex->TrackOutliner(&SOutliner);
+	}
+	else
+	{
+		return;
+	}
+
+	for (auto It = Instance->Fingerprints.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Outliner.IsValid())
+		{
+			Instance->Generations.Remove(It.Key());
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = Instance->ExpansionHashes.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Outliner.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FFingerprint& Fingerprint = Instance->Fingerprints.FindOrAdd(&SOutliner);
+	Fingerprint.Outliner = StaticCastSharedRef<SSceneOutliner>(SOutliner.AsShared());
+	Fingerprint.Policy = Policy;
+	Fingerprint.Generation = Instance->Generations.FindRef(&SOutliner);
+	Fingerprint.ExpansionHash = Instance->GetExpansionHash(SOutliner);
+}
+
+void FSceneOutlinerFingerprints::ReportItemExpansionChanged(const SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemID& ID, bool bIsExpanded)
+{
+	if (!Instance)
+	{
+		return;
+	}
+	Instance->ItemExpansionChangedEvent.Broadcast(SOutliner, ID, bIsExpanded);
+
+	// Kept up to date even when the items are to be checked again, so the check finds the hidden items flipped meanwhile
+	FExpansionHash* Hash = Instance->ExpansionHashes.Find(&SOutliner);
+	if (!Hash)
+	{
+		return;
+	}
+
+	if (bIsExpanded)
+	{
+		Hash->Add(ID);
+	}
+	else
+	{
+		Hash->Remove(ID);
+	}
+}
+
+void FSceneOutlinerFingerprints::FExpansionHash::Add(const FSceneOutlinerTreeItemID& ID)
+{
+	bool bIsAlreadyInSet = false;
+	ExpandedIDs.Add(ID, &bIsAlreadyInSet);
+	if (!bIsAlreadyInSet)
+	{
+		Sum += MixItemHash(ID);
+	}
+}
+
+void FSceneOutlinerFingerprints::FExpansionHash::Remove(const FSceneOutlinerTreeItemID& ID)
+{
+	if (ExpandedIDs.Remove(ID) > 0)
+	{
+		Sum -= MixItemHash(ID);
+	}
+}
+
+void FSceneOutlinerFingerprints::Reset()
+{
+	Fingerprints.Empty();
+	Generations.Empty();
+	ExpansionHashes.Empty();
+}
+
+void FSceneOutlinerFingerprints::OnOutlinerHierarchyChanged(SSceneOutliner* SOutliner, const FSceneOutlinerHierarchyChangedData& Data)
+{
+	if (SOutliner)
+	{
+		++Generations.FindOrAdd(SOutliner);
+	}
+}
+
+void FSceneOutlinerFingerprints::OnMapChange(uint32 MapChangeFlags)
+{
+	for (const TPair<const SSceneOutliner*, FFingerprint>& Pair : Fingerprints)
+	{
+		++Generations.FindOrAdd(Pair.Key);
+	}
+}
+
+void FSceneOutlinerFingerprints::OnMousePreInputButtonDown(const FPointerEvent& MouseEvent)
+{
+	// Clicking in an Outliner might expand or collapse its items, rows included as double-clicking a folder expands it
+	for (TPair<const SSceneOutliner*, FExpansionHash>& Pair : ExpansionHashes)
+	{
+		const TSharedPtr<SSceneOutliner> SOutliner = Pair.Value.Outliner.Pin();
+		if (SOutliner && SOutliner->GetTree().GetTickSpaceGeometry().IsUnderLocation(MouseEvent.GetScreenSpacePosition()))
+		{
+			Pair.Value.bIsValid = false;
+		}
+	}
+}
+
+void FSceneOutlinerFingerprints::OnPreInputKeyDown(const FKeyEvent& KeyEvent)
+{
+	// The tree view expands and collapses its selected items with the left and right arrows
+	const FKey Key = KeyEvent.GetKey();
+	if (Key != EKeys::Left && Key != EKeys::Right)
+	{
+		return;
+	}
+	for (TPair<const SSceneOutliner*, FExpansionHash>& Pair : ExpansionHashes)
+	{
+		const TSharedPtr<SSceneOutliner> SOutliner = Pair.Value.Outliner.Pin();
+		if (SOutliner && (SOutliner->GetTree().HasKeyboardFocus() || SOutliner->GetTree().HasFocusedDescendants()))
+		{
+			Pair.Value.bIsValid = false;
+		}
+	}
+}
+
+uint32 FSceneOutlinerFingerprints::GetExpansionHash(SSceneOutliner& SOutliner)
+{
+	FExpansionHash& Hash = ExpansionHashes.FindOrAdd(&SOutliner);
+	const uint32 Generation = Generations.FindRef(&SOutliner);
+	if (Hash.Outliner.Pin().Get() != &SOutliner)
+	{
+		// Another Outliner at the same address, nothing known about it
+		Hash = FExpansionHash();
+		Hash.Outliner = StaticCastSharedRef<SSceneOutliner>(SOutliner.AsShared());
+	}
+	if (!Hash.bIsValid || Hash.Generation != Generation)
+	{
+		CheckExpansion(SOutliner, Hash);
+		Hash.Generation = Generation;
+		Hash.bIsValid = true;
+	}
+	return HashCombine(Hash.Sum, GetTypeHash(Hash.ExpandedIDs.Num()));
+}
+
+void FSceneOutlinerFingerprints::CheckExpansion(SSceneOutliner& SOutliner, FExpansionHash& Hash)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(HashExpansion);
+	int32 NumVisited = 0;
+
+	for (auto It = Hash.ExpandedIDs.CreateIterator(); It; ++It)
+	{
+		++NumVisited;
+		const FSceneOutlinerTreeItemPtr Item = SOutliner.GetTreeItem(*It);
+		if (!Item || !Item->Flags.bIsExpanded)
+		{
+			Hash.Sum -= MixItemHash(*It);
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<FSceneOutlinerTreeItemPtr> Stack = FOutlinerShortcutsEditorModule::GetSceneOutlinerRootItems(&SOutliner);
+	while (Stack.Num() > 0)
+	{
+		const FSceneOutlinerTreeItemPtr Item = Stack.Pop(EAllowShrinking::No);
+		++NumVisited;
+		if (!Item || !Item->Flags.bIsExpanded)
+		{
+			continue;
+		}
+
+		Hash.Add(Item->GetID());
+		for (const TWeakPtr<ISceneOutlinerTreeItem>& Child : Item->GetChildren())
+		{
+			Stack.Add(Child.Pin());
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	OUTLINER_SHORTCUTS_LOG_D("Checked the expansion of %d items, %d expanded", NumVisited, Hash.ExpandedIDs.Num());
+}
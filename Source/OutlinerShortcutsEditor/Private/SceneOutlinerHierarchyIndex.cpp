@@ -0,0 +1,404 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerHierarchyIndex.h"
+
+#include "SSceneOutliner.h"
+#include "ISceneOutlinerMode.h"
+#include "ISceneOutlinerHierarchy.h"
+#include "Widgets/Views/STreeView.h"
+#include "OutlinerShortcutsStats.h"
+
+
+FSceneOutlinerHierarchyIndex* FSceneOutlinerHierarchyIndex::Instance = nullptr;
+
+void FSceneOutlinerHierarchyIndex::OnStartupModule()
+{
+	Instance = this;
+}
+
+void FSceneOutlinerHierarchyIndex::OnShutdownModule()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(RebindTickerHandle);
+	RebindTickerHandle.Reset();
+	for (TPair<const SSceneOutliner*, FOutlinerEntry>& Pair : Entries)
+	{
+		UnbindEntry(Pair.Value);
+	}
+	Entries.Empty();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerHierarchyIndex* FSceneOutlinerHierarchyIndex::Get()
+{
+	return Instance;
+}
+
+void FSceneOutlinerHierarchyIndex::TrackOutliner(SSceneOutliner* SOutliner)
+{
+	FindOrAddEntry(SOutliner);
+}
+
+TArray<FSceneOutlinerTreeItemPtr> FSceneOutlinerHierarchyIndex::GetRootItems(SSceneOutliner* SOutliner)
+{
+	TArray<FSceneOutlinerTreeItemPtr> RootItems;
+
+	FOutlinerEntry* Entry = FindOrAddEntry(SOutliner);
+	if (!Entry)
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("`SSceneOutliner` given is null");
+		return RootItems;
+	}
+
+	if (Entry->bNeedsRebuild)
+	{
+		OUTLINER_SHORTCUTS_LOG_D("Rebuilding the root index");
+		Entry->RootIDs.Reset();
+		Entry->PendingIDs.Reset();
+
+		RootItems = FindRootItems(SOutliner);
+		for (const FSceneOutlinerTreeItemPtr& Item : RootItems)
+		{
+			Entry->RootIDs.Add(Item->GetID());
+		}
+		Entry->bNeedsRebuild = false;
+		return RootItems;
+	}
+
+	// Resolve the items added or moved since the last lookup. The ones not yet in the tree stay pending.
+	for (auto It = Entry->PendingIDs.CreateIterator(); It; ++It)
+	{
+		if (const FSceneOutlinerTreeItemPtr Item = SOutliner->GetTreeItem(*It))
+		{
+			if (Item->GetParent().IsValid())
+			{
+				Entry->RootIDs.Remove(*It);
+			}
+			else
+			{
+				Entry->RootIDs.Add(*It);
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	RootItems.Reserve(Entry->RootIDs.Num());
+	for (auto It = Entry->RootIDs.CreateIterator(); It; ++It)
+	{
+		const FSceneOutlinerTreeItemPtr Item = SOutliner->GetTreeItem(*It);
+		if (Item && !Item->GetParent().IsValid())
+		{
+			RootItems.Add(Item);
+		}
+		else
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return RootItems;
+}
+
+bool FSceneOutlinerHierarchyIndex::WithExpansionFrontier(SSceneOutliner& SOutliner, FSceneOutlinerExpansionBatch& Batch, TFunctionRef<void(ISceneOutlinerTreeModel&, FSceneOutlinerExpansionFrontier&)> Function)
+{
+	FOutlinerEntry* Entry = FindOrAddEntry(&SOutliner);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	if (!Entry->TreeModel)
+	{
+		Entry->TreeModel = MakeUnique<FSceneOutlinerWidgetTreeModel>(SOutliner);
+		Entry->ExpansionFrontier.Invalidate();
+	}
+
+	// The model is kept across commands, it must not keep pointing to this batch
+	Entry->TreeModel->SetBatch(&Batch);
+	ResolveFrontierPendingItems(*Entry, SOutliner);
+	Function(*Entry->TreeModel, Entry->ExpansionFrontier);
+	Entry->TreeModel->SetBatch(nullptr);
+	return true;
+}
+
+TArray<FSceneOutlinerTreeItemPtr> FSceneOutlinerHierarchyIndex::FindRootItems(SSceneOutliner* SOutliner)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(FindRootItems);
+	TArray<FSceneOutlinerTreeItemPtr> RootItems;
+
+	if (SOutliner)
+	{
+		// Root items do not have any ancestor to be collapsed under, so they are always part of the rows of the tree.
+		// This only costs the number of visible rows, which is small when the Outliner is collapsed.
+		const TArray<FSceneOutlinerTreeItemPtr>& Rows = SOutliner->GetTree().GetItems();
+		for (const FSceneOutlinerTreeItemPtr& Item : Rows)
+		{
+			if (Item && !Item->GetParent().IsValid())
+			{
+				RootItems.Add(Item);
+			}
+		}
+		OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, Rows.Num());
+
+		// The rows are only linearized on the next tick of the tree, so make sure a freshly populated world is not missed
+		if (const FSceneOutlinerTreeItemPtr WorldItem = FOutlinerShortcutsEditorModule::GetWorldTreeItemPtr(SOutliner))
+		{
+			if (!WorldItem->GetParent().IsValid())
+			{
+				const FSceneOutlinerTreeItemID WorldID = WorldItem->GetID();
+				if (!RootItems.ContainsByPredicate([&WorldID](const FSceneOutlinerTreeItemPtr& Item) { return Item->GetID() == WorldID; }))
+				{
+					RootItems.Add(WorldItem);
+				}
+			}
+		}
+	}
+	else
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("`SSceneOutliner` given is null");
+	}
+	return RootItems;
+}
+
+FSceneOutlinerHierarchyIndex::FOutlinerEntry* FSceneOutlinerHierarchyIndex::FindOrAddEntry(SSceneOutliner* SOutliner)
+{
+	if (!SOutliner)
+	{
+		return nullptr;
+	}
+
+	RemoveStaleEntries();
+
+	FOutlinerEntry& Entry = Entries.FindOrAdd(SOutliner);
+	if (!Entry.Outliner.IsValid())
+	{
+		Entry.Outliner = StaticCastSharedRef<SSceneOutliner>(SOutliner->AsShared());
+		ScheduleRebind();
+	}
+
+	// The hierarchy might have been replaced without any event, ex: when the mode of the Outliner is swapped
+	if (BindEntryIfNeeded(Entry, *SOutliner))
+	{
+		// Looked up through the map, the entry might have moved if a listener tracked another Outliner
+		return Entries.Find(SOutliner);
+	}
+	return &Entry;
+}
+
+ISceneOutlinerHierarchy* FSceneOutlinerHierarchyIndex::GetLiveHierarchy(const SSceneOutliner& SOutliner)
+{
+	ISceneOutlinerMode* Mode = const_cast<ISceneOutlinerMode*>(SOutliner.GetMode());
+	return Mode ? Mode->GetHierarchy() : nullptr;
+}
+
+bool FSceneOutlinerHierarchyIndex::BindEntryIfNeeded(FOutlinerEntry& Entry, SSceneOutliner& SOutliner)
+{
+	// A new hierarchy might reuse the address of the destroyed one, only its own delegate tells if it is the one bound
+	ISceneOutlinerHierarchy* Hierarchy = GetLiveHierarchy(SOutliner);
+	if (!Hierarchy || Hierarchy->OnHierarchyChanged().IsBoundToObject(this))
+	{
+		return false;
+	}
+
+	// The previous hierarchy took its binding with it when destroyed
+	Entry.HierarchyChangedHandle = Hierarchy->OnHierarchyChanged().AddRaw(this, &FSceneOutlinerHierarchyIndex::OnHierarchyChanged, static_cast<const SSceneOutliner*>(&SOutliner));
+	Entry.bNeedsRebuild = true;
+	Entry.ExpansionFrontier.Invalidate();
+	Entry.TreeModel.Reset();
+	Entry.FrontierPendingIDs.Reset();
+	OUTLINER_SHORTCUTS_LOG_D("Bound to the hierarchy of `%s`", *SOutliner.GetOutlinerIdentifier().ToString());
+
+	// The items of the new hierarchy are all new, the listeners treat it as a full refresh
+	if (OutlinerHierarchyChangedEvent.IsBound())
+	{
+		FSceneOutlinerHierarchyChangedData Data;
+		Data.Type = FSceneOutlinerHierarchyChangedData::FullRefresh;
+		OutlinerHierarchyChangedEvent.Broadcast(&SOutliner, Data);
+	}
+	return true;
+}
+
+void FSceneOutlinerHierarchyIndex::UnbindEntry(FOutlinerEntry& Entry)
+{
+	// Only the live hierarchy is touched, the one bound might already be destroyed
+	if (const TSharedPtr<SSceneOutliner> SOutliner = Entry.Outliner.Pin())
+	{
+		if (ISceneOutlinerHierarchy* Hierarchy = GetLiveHierarchy(*SOutliner))
+		{
+			Hierarchy->OnHierarchyChanged().Remove(Entry.HierarchyChangedHandle);
+		}
+	}
+	Entry.HierarchyChangedHandle.Reset();
+}
+
+void FSceneOutlinerHierarchyIndex::RemoveStaleEntries()
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Outliner.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FSceneOutlinerHierarchyIndex::ScheduleRebind()
+{
+	if (!RebindTickerHandle.IsValid())
+	{
+		RebindTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSceneOutlinerHierarchyIndex::TickRebind));
+	}
+}
+
+bool FSceneOutlinerHierarchyIndex::TickRebind(float DeltaTime)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(RebindHierarchies);
+	RemoveStaleEntries();
+
+	// Copied, a re-bind is broadcast and its listeners might track other Outliners
+	TArray<const SSceneOutliner*> Keys;
+	Entries.GetKeys(Keys);
+	for (const SSceneOutliner* Key : Keys)
+	{
+		FOutlinerEntry* Entry = Entries.Find(Key);
+		if (const TSharedPtr<SSceneOutliner> SOutliner = Entry ? Entry->Outliner.Pin() : nullptr)
+		{
+			BindEntryIfNeeded(*Entry, *SOutliner);
+		}
+	}
+
+	if (Entries.Num() == 0)
+	{
+		RebindTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FSceneOutlinerHierarchyIndex::OnHierarchyChanged(FSceneOutlinerHierarchyChangedData Data, const SSceneOutliner* Key)
+{
+	FOutlinerEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	UpdateExpansionFrontier(*Entry, Data);
+	if (!Entry->bNeedsRebuild)
+	{
+		UpdateRootIDs(*Entry, Data);
+	}
+
+	if (OutlinerHierarchyChangedEvent.IsBound())
+	{
+		if (TSharedPtr<SSceneOutliner> SOutliner = Entry->Outliner.Pin())
+		{
+			OutlinerHierarchyChangedEvent.Broadcast(SOutliner.Get(), Data);
+		}
+	}
+}
+
+void FSceneOutlinerHierarchyIndex::UpdateRootIDs(FOutlinerEntry& Entry, const FSceneOutlinerHierarchyChangedData& Data)
+{
+	switch (Data.Type)
+	{
+	case FSceneOutlinerHierarchyChangedData::Added:
+	case FSceneOutlinerHierarchyChangedData::Moved:
+		for (const FSceneOutlinerTreeItemPtr& Item : Data.Items)
+		{
+			if (Item)
+			{
+				Entry.PendingIDs.Add(Item->GetID());
+			}
+		}
+		Entry.PendingIDs.Append(Data.ItemIDs);
+		break;
+	case FSceneOutlinerHierarchyChangedData::Removed:
+		for (const FSceneOutlinerTreeItemID& ItemID : Data.ItemIDs)
+		{
+			Entry.RootIDs.Remove(ItemID);
+			Entry.PendingIDs.Remove(ItemID);
+		}
+		break;
+	case FSceneOutlinerHierarchyChangedData::FolderMoved:
+	case FSceneOutlinerHierarchyChangedData::FullRefresh:
+	default:
+		Entry.bNeedsRebuild = true;
+		break;
+	}
+}
+
+void FSceneOutlinerHierarchyIndex::UpdateExpansionFrontier(FOutlinerEntry& Entry, const FSceneOutlinerHierarchyChangedData& Data)
+{
+	FSceneOutlinerExpansionFrontier& Frontier = Entry.ExpansionFrontier;
+	switch (Data.Type)
+	{
+	case FSceneOutlinerHierarchyChangedData::Added:
+	case FSceneOutlinerHierarchyChangedData::Moved:
+		// Only their depth is needed, which is only known once the Outliner added them to its tree
+		if (Frontier.IsValid())
+		{
+			for (const FSceneOutlinerTreeItemPtr& Item : Data.Items)
+			{
+				if (Item)
+				{
+					Entry.FrontierPendingIDs.Add(Item->GetID());
+				}
+			}
+			Entry.FrontierPendingIDs.Append(Data.ItemIDs);
+		}
+		break;
+	case FSceneOutlinerHierarchyChangedData::Removed:
+		if (Frontier.IsValid() && Entry.TreeModel)
+		{
+			TArray<int32> RemovedItems;
+			for (const FSceneOutlinerTreeItemID& ItemID : Data.ItemIDs)
+			{
+				Entry.FrontierPendingIDs.Remove(ItemID);
+				const int32 Item = Entry.TreeModel->Find(ItemID);
+				if (Item != INDEX_NONE)
+				{
+					RemovedItems.Add(Item);
+				}
+			}
+			Frontier.RemoveItems(RemovedItems);
+		}
+		break;
+	case FSceneOutlinerHierarchyChangedData::FullRefresh:
+		// Every item is recreated, start over instead of keeping the IDs of the removed ones
+		Entry.TreeModel.Reset();
+		[[fallthrough]];
+	case FSceneOutlinerHierarchyChangedData::FolderMoved:
+	default:
+		// Folders are identified by their path, moving one changes the IDs of all its sub folders
+		Frontier.Invalidate();
+		Entry.FrontierPendingIDs.Reset();
+		break;
+	}
+}
+
+void FSceneOutlinerHierarchyIndex::ResolveFrontierPendingItems(FOutlinerEntry& Entry, SSceneOutliner& SOutliner)
+{
+	if (!Entry.ExpansionFrontier.IsValid())
+	{
+		Entry.FrontierPendingIDs.Reset();
+		return;
+	}
+
+	TArray<int32> Items;
+	for (auto It = Entry.FrontierPendingIDs.CreateIterator(); It; ++It)
+	{
+		if (const FSceneOutlinerTreeItemPtr Item = SOutliner.GetTreeItem(*It))
+		{
+			Items.Add(Entry.TreeModel->Intern(Item));
+			It.RemoveCurrent();
+		}
+	}
+	if (Items.Num() > 0)
+	{
+		Entry.ExpansionFrontier.UpdateItems(*Entry.TreeModel, Items);
+	}
+}
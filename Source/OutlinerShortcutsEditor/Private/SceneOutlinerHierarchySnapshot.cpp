@@ -0,0 +1,231 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerHierarchySnapshot.h"
+
+#include "FolderPathMatcher.h"
+#include "OutlinerShortcutsEditorDefinitions.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+
+TSharedRef<FSceneOutlinerHierarchySnapshot> FSceneOutlinerHierarchySnapshot::Capture(const UWorld& World)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(CaptureHierarchySnapshot);
+	check(IsInGameThread());
+
+	TSharedRef<FSceneOutlinerHierarchySnapshot> Snapshot = MakeShared<FSceneOutlinerHierarchySnapshot>();
+	Snapshot->World = FObjectKey(&World);
+	TMap<const AActor*, int32> ActorIndices;
+	TArray<const AActor*> AttachParents;
+
+	for (TActorIterator<AActor> It(&World); It; ++It)
+	{
+		const AActor* Actor = *It;
+		if (!Actor || !Actor->IsListedInSceneOutliner())
+		{
+			continue;
+		}
+
+		ActorIndices.Add(Actor, Snapshot->CapturedActors.Num());
+		FCapturedActor& Captured = Snapshot->CapturedActors.AddDefaulted_GetRef();
+		Captured.Actor = FObjectKey(Actor);
+		Captured.Folder = Actor->GetFolder();
+		AttachParents.Add(Actor->GetAttachParentActor());
+	}
+
+	for (int32 Index = 0; Index < AttachParents.Num(); ++Index)
+	{
+		if (const int32* ParentIndex = AttachParents[Index] ? ActorIndices.Find(AttachParents[Index]) : nullptr)
+		{
+			Snapshot->CapturedActors[Index].AttachParent = *ParentIndex;
+		}
+	}
+
+	OUTLINER_SHORTCUTS_LOG_D("Captured %d actors", Snapshot->CapturedActors.Num());
+	return Snapshot;
+}
+
+void FSceneOutlinerHierarchySnapshot::Build()
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(BuildHierarchySnapshot);
+
+	Nodes.Reset(CapturedActors.Num() + 1);
+	Nodes.AddDefaulted_GetRef().ID = FSceneOutlinerTreeItemID(World);
+
+	// Actor nodes come first so their index is the index of the captured actor plus one
+	for (const FCapturedActor& Captured : CapturedActors)
+	{
+		Nodes.AddDefaulted_GetRef().ID = FSceneOutlinerTreeItemID(Captured.Actor);
+	}
+
+	// An attached actor is displayed under its parent actor whatever its folder
+	TMap<FFolder, int32> FolderNodes;
+	for (int32 Index = 0; Index < CapturedActors.Num(); ++Index)
+	{
+		const FCapturedActor& Captured = CapturedActors[Index];
+		int32 Parent = 0;
+		if (Captured.AttachParent != INDEX_NONE)
+		{
+			Parent = Captured.AttachParent + 1;
+		}
+		else if (!Captured.Folder.IsNone())
+		{
+			Parent = FindOrAddFolder(Captured.Folder, FolderNodes);
+		}
+		Nodes[Index + 1].Parent = Parent;
+	}
+
+	// Parents can come after their children, so the depths are resolved by walking up to the first node already resolved.
+	// The nodes of the chain being walked are flagged, so coming back to one of them is a cycle, found without searching the chain.
+	enum class EDepthState : uint8
+	{
+		Unresolved,
+		Visiting,
+		Resolved,
+	};
+	TArray<EDepthState> States;
+	States.Init(EDepthState::Unresolved, Nodes.Num());
+	States[0] = EDepthState::Resolved;
+	TArray<int32> Chain;
+	for (int32 Index = 1; Index < Nodes.Num(); ++Index)
+	{
+		int32 Current = Index;
+		while (States[Current] == EDepthState::Unresolved)
+		{
+			States[Current] = EDepthState::Visiting;
+			Chain.Add(Current);
+			Current = Nodes[Current].Parent;
+		}
+
+		int32 Depth = 0;
+		if (States[Current] == EDepthState::Resolved)
+		{
+			Depth = Nodes[Current].Depth;
+		}
+		else
+		{
+			// A cycle in the attachments is not displayed by the Outliner either, put it under the world
+			Nodes[Chain.Last()].Parent = 0;
+		}
+		while (Chain.Num() > 0)
+		{
+			const int32 Node = Chain.Pop(EAllowShrinking::No);
+			Nodes[Node].Depth = ++Depth;
+			States[Node] = EDepthState::Resolved;
+		}
+
+		Nodes[Nodes[Index].Parent].bHasChildren = true;
+	}
+
+	// Only the nodes are needed from now on
+	CapturedActors.Empty();
+	OUTLINER_SHORTCUTS_LOG_D("Built a snapshot of %d nodes, %d of them folders", Nodes.Num(), FolderNodes.Num());
+}
+
+TArray<FSceneOutlinerTreeItemID> FSceneOutlinerHierarchySnapshot::ComputeExpandToDepthItems(int32 Depth) const
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ComputeExpandToDepthItems);
+
+	// A flag per node is too little work to be worth spreading over threads, the plan already runs on a worker thread
+	TArray<bool> Flags;
+	Flags.SetNumUninitialized(Nodes.Num());
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Flags[Index] = Nodes[Index].bHasChildren && Nodes[Index].Depth < Depth;
+	}
+	return GatherItems(Flags);
+}
+
+TArray<FSceneOutlinerTreeItemID> FSceneOutlinerHierarchySnapshot::ComputeMatchingFolderItems(const FFolderPathMatcher& Matcher) const
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(ComputeMatchingFolderItems);
+
+	TArray<bool> Flags;
+	Flags.SetNumZeroed(Nodes.Num());
+	if (Nodes.Num() == 0)
+	{
+		return TArray<FSceneOutlinerTreeItemID>();
+	}
+	// The root stays expanded, as with `Collapse to Root`
+	Flags[0] = true;
+	if (Matcher.IsEmpty())
+	{
+		return GatherItems(Flags);
+	}
+
+	// Folder nodes are added after their parent folder, so each one is stepped from the states of its parent
+	TMap<int32, FFolderPathMatcher::FStates> FolderStates;
+	const FFolderPathMatcher::FStates InitialStates = Matcher.GetInitialStates();
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FNode& Node = Nodes[Index];
+		if (Node.FolderPath.IsNone())
+		{
+			continue;
+		}
+
+		const FFolderPathMatcher::FStates* ParentStates = FolderStates.Find(Node.Parent);
+		if (!ParentStates && Node.Parent != 0)
+		{
+			continue;
+		}
+
+		const FString Path = Node.FolderPath.ToString();
+		int32 SlashIndex = INDEX_NONE;
+		FFolderPathMatcher::FStates States = Matcher.Step(ParentStates ? *ParentStates : InitialStates, Path.FindLastChar(TEXT('/'), SlashIndex) ? FStringView(Path).RightChop(SlashIndex + 1) : FStringView(Path));
+		Flags[Index] = Matcher.IsMatch(States);
+		// A folder without states can't have matching sub folders
+		if (States.Num() > 0)
+		{
+			FolderStates.Add(Index, MoveTemp(States));
+		}
+	}
+
+	// A folder is only displayed if all its parents are expanded
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		if (!Flags[Index])
+		{
+			continue;
+		}
+		for (int32 Parent = Nodes[Index].Parent; Parent != INDEX_NONE && !Flags[Parent]; Parent = Nodes[Parent].Parent)
+		{
+			Flags[Parent] = true;
+		}
+	}
+	return GatherItems(Flags);
+}
+
+int32 FSceneOutlinerHierarchySnapshot::FindOrAddFolder(const FFolder& Folder, TMap<FFolder, int32>& FolderNodes)
+{
+	if (const int32* Existing = FolderNodes.Find(Folder))
+	{
+		return *Existing;
+	}
+
+	const FFolder ParentFolder = Folder.GetParent();
+	const int32 Parent = ParentFolder.IsNone() ? 0 : FindOrAddFolder(ParentFolder, FolderNodes);
+
+	const int32 Index = Nodes.AddDefaulted();
+	Nodes[Index].ID = FSceneOutlinerTreeItemID(Folder);
+	Nodes[Index].FolderPath = Folder.GetPath();
+	Nodes[Index].Parent = Parent;
+	FolderNodes.Add(Folder, Index);
+	return Index;
+}
+
+TArray<FSceneOutlinerTreeItemID> FSceneOutlinerHierarchySnapshot::GatherItems(const TArray<bool>& Flags) const
+{
+	TArray<FSceneOutlinerTreeItemID> Items;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		if (Flags[Index])
+		{
+			Items.Add(Nodes[Index].ID);
+		}
+	}
+	return Items;
+}
@@ -0,0 +1,322 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerIncrementalExpansion.h"
+
+#include "SSceneOutliner.h"
+#include "ISceneOutlinerHierarchy.h"
+#include "FolderTreeItem.h"
+#include "SceneOutlinerHierarchyIndex.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "SceneOutlinerExpansionCache.h"
+#include "OutlinerShortcutsSettings.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	// Passes retried while the Outliner is not ready or the new items are not in its tree yet
+	constexpr int32 MaxRetries = 10;
+}
+
+FSceneOutlinerIncrementalExpansion* FSceneOutlinerIncrementalExpansion::Instance = nullptr;
+
+void FSceneOutlinerIncrementalExpansion::OnStartupModule()
+{
+	Instance = this;
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		OnOutlinerHierarchyChangedHandle = HierarchyIndex->OnOutlinerHierarchyChanged().AddRaw(this, &FSceneOutlinerIncrementalExpansion::OnOutlinerHierarchyChanged);
+	}
+	OnLevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FSceneOutlinerIncrementalExpansion::OnLevelAddedToWorld);
+}
+
+void FSceneOutlinerIncrementalExpansion::OnShutdownModule()
+{
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		HierarchyIndex->OnOutlinerHierarchyChanged().Remove(OnOutlinerHierarchyChangedHandle);
+	}
+	OnOutlinerHierarchyChangedHandle.Reset();
+	FWorldDelegates::LevelAddedToWorld.Remove(OnLevelAddedToWorldHandle);
+	OnLevelAddedToWorldHandle.Reset();
+	Reset();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerIncrementalExpansion* FSceneOutlinerIncrementalExpansion::Get()
+{
+	return Instance;
+}
+
+void FSceneOutlinerIncrementalExpansion::Reset()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(PassHandle);
+	PassHandle.Reset();
+	States.Empty();
+	SavedExpansionMap.Reset();
+	SavedExpansion.Reset();
+}
+
+void FSceneOutlinerIncrementalExpansion::OnOutlinerHierarchyChanged(SSceneOutliner* SOutliner, const FSceneOutlinerHierarchyChangedData& Data)
+{
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!SOutliner || !EditorSettings || !EditorSettings->bApplyBehaviorToLoadedItems || Data.Type != FSceneOutlinerHierarchyChangedData::Added)
+	{
+		return;
+	}
+
+	FOutlinerState& State = FindOrAddState(*SOutliner);
+	for (const FSceneOutlinerTreeItemPtr& Item : Data.Items)
+	{
+		if (Item)
+		{
+			State.PendingIDs.Add(Item->GetID());
+		}
+	}
+	State.PendingIDs.Append(Data.ItemIDs);
+	SchedulePass();
+}
+
+void FSceneOutlinerIncrementalExpansion::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!Level || !World || World != FOutlinerShortcutsEditorModule::GetCurrentEditorWorld() || !EditorSettings || !EditorSettings->bApplyBehaviorToLoadedItems)
+	{
+		return;
+	}
+
+	// The Outliners fully refresh to show the level, its actors are the only new items
+	TArray<FSceneOutlinerTreeItemID> ActorIDs;
+	ActorIDs.Reserve(Level->Actors.Num());
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor && Actor->IsListedInSceneOutliner())
+		{
+			ActorIDs.Add(FSceneOutlinerTreeItemID(Actor));
+		}
+	}
+	if (ActorIDs.Num() == 0)
+	{
+		return;
+	}
+
+#if PRE_UE5_1
+	if (SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner())
+	{
+		FindOrAddState(*SOutliner).PendingIDs.Append(ActorIDs);
+	}
+#else
+	for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+	{
+		FindOrAddState(SOutliner.Get()).PendingIDs.Append(ActorIDs);
+	}
+#endif
+	SchedulePass();
+}
+
+FSceneOutlinerIncrementalExpansion::FOutlinerState& FSceneOutlinerIncrementalExpansion::FindOrAddState(SSceneOutliner& SOutliner)
+{
+	FOutlinerState& State = States.FindOrAdd(&SOutliner);
+	State.Outliner = StaticCastSharedRef<SSceneOutliner>(SOutliner.AsShared());
+	return State;
+}
+
+void FSceneOutlinerIncrementalExpansion::SchedulePass()
+{
+	if (PassHandle.IsValid())
+	{
+		// Arrivals during the window are processed by the pass already scheduled
+		return;
+	}
+
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	const float Delay = EditorSettings ? EditorSettings->LoadedItemsCoalesceWindow : 0.25f;
+	PassHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSceneOutlinerIncrementalExpansion::TickPass), Delay);
+}
+
+bool FSceneOutlinerIncrementalExpansion::TickPass(float DeltaTime)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(IncrementalExpansion);
+	PassHandle.Reset();
+
+	bool bNeedsRetry = false;
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		for (auto It = States.CreateIterator(); It; ++It)
+		{
+			FOutlinerState& State = It.Value();
+			const TSharedPtr<SSceneOutliner> SOutliner = State.Outliner.Pin();
+			if (!SOutliner)
+			{
+				It.RemoveCurrent();
+				continue;
+			}
+
+			if (ApplyToNewItems(Batch, *SOutliner, State) || ++State.NumRetries > MaxRetries)
+			{
+				It.RemoveCurrent();
+				continue;
+			}
+			bNeedsRetry = true;
+		}
+	}
+
+	if (bNeedsRetry)
+	{
+		SchedulePass();
+	}
+	return false;
+}
+
+bool FSceneOutlinerIncrementalExpansion::ApplyToNewItems(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, FOutlinerState& State)
+{
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!EditorSettings)
+	{
+		return true;
+	}
+	const EOutlinerExpansionBehaviorOnMapOpen Behavior = EditorSettings->GetExpansionBehaviorOnMapOpen(SOutliner);
+	if (Behavior == EOutlinerExpansionBehaviorOnMapOpen::LeaveAlone)
+	{
+		return true;
+	}
+	if (!FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(&SOutliner))
+	{
+		return false;
+	}
+
+	// The parents are only known to be new once all the new items of the pass are known
+	TArray<FSceneOutlinerTreeItemPtr> NewItems;
+	TSet<FSceneOutlinerTreeItemID> NewIDs;
+	for (auto It = State.PendingIDs.CreateIterator(); It; ++It)
+	{
+		if (const FSceneOutlinerTreeItemPtr Item = SOutliner.GetTreeItem(*It))
+		{
+			NewItems.Add(Item);
+			NewIDs.Add(*It);
+			It.RemoveCurrent();
+		}
+	}
+
+	// Walks up from each new item while its parents are new, stopping at the parents already processed
+	int32 NumApplied = 0;
+	for (int32 Index = 0; Index < NewItems.Num(); ++Index)
+	{
+		const FSceneOutlinerTreeItemPtr Item = NewItems[Index];
+		++NumApplied;
+
+		bool bExpandParents = false;
+		const bool bExpand = ShouldExpand(*Item, Behavior, bExpandParents);
+		if (Item->GetChildren().Num() > 0)
+		{
+			Batch.SetItemExpansion(SOutliner, Item, bExpand);
+		}
+		if (bExpandParents)
+		{
+			for (FSceneOutlinerTreeItemPtr Parent = Item->GetParent(); Parent && !Batch.IsItemExpanded(SOutliner, Parent); Parent = Parent->GetParent())
+			{
+				Batch.SetItemExpansion(SOutliner, Parent, true);
+			}
+		}
+
+		const FSceneOutlinerTreeItemPtr Parent = Item->GetParent();
+		if (Parent && !NewIDs.Contains(Parent->GetID()) && AreAllChildrenNew(*Parent, NewIDs))
+		{
+			NewIDs.Add(Parent->GetID());
+			NewItems.Add(Parent);
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumApplied);
+	if (NumApplied > 0)
+	{
+		OUTLINER_SHORTCUTS_LOG_D("Applied the map open behavior to %d new items, %d still pending", NumApplied, State.PendingIDs.Num());
+	}
+	return State.PendingIDs.Num() == 0;
+}
+
+bool FSceneOutlinerIncrementalExpansion::AreAllChildrenNew(const ISceneOutlinerTreeItem& Parent, const TSet<FSceneOutlinerTreeItemID>& NewIDs)
+{
+	// Stops at the first child already there, which is usually the first one for the parents that were not new
+	for (const TWeakPtr<ISceneOutlinerTreeItem>& WeakChild : Parent.GetChildren())
+	{
+		const FSceneOutlinerTreeItemPtr Child = WeakChild.Pin();
+		if (Child && !NewIDs.Contains(Child->GetID()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FSceneOutlinerIncrementalExpansion::ShouldExpand(const ISceneOutlinerTreeItem& Item, EOutlinerExpansionBehaviorOnMapOpen Behavior, bool& bOutExpandParents)
+{
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	const bool bIsRoot = !Item.GetParent().IsValid();
+	bOutExpandParents = false;
+
+	switch (Behavior)
+	{
+	case EOutlinerExpansionBehaviorOnMapOpen::ExpandAll:
+		return true;
+	case EOutlinerExpansionBehaviorOnMapOpen::CollapseAll:
+		return false;
+	case EOutlinerExpansionBehaviorOnMapOpen::ExpandToDepth:
+		return GetItemDepth(Item) < EditorSettings->ExpandToDepth;
+	case EOutlinerExpansionBehaviorOnMapOpen::RestoreLastState:
+		if (const FSceneOutlinerSavedExpansion* Saved = GetSavedExpansion())
+		{
+			return Saved->Contains(Item);
+		}
+		return bIsRoot;
+	case EOutlinerExpansionBehaviorOnMapOpen::ExpandMatchingFolders:
+		if (const FFolderTreeItem* FolderItem = Item.CastTo<FFolderTreeItem>())
+		{
+			bOutExpandParents = EditorSettings->GetFolderPatternMatcher().Matches(FolderItem->GetPath().ToString());
+			return bOutExpandParents;
+		}
+		return bIsRoot;
+	case EOutlinerExpansionBehaviorOnMapOpen::CollapseToRoot:
+	default:
+		return bIsRoot;
+	}
+}
+
+const FSceneOutlinerSavedExpansion* FSceneOutlinerIncrementalExpansion::GetSavedExpansion()
+{
+	const UWorld* World = FOutlinerShortcutsEditorModule::GetCurrentEditorWorld();
+	FSceneOutlinerExpansionCache* ExpansionCache = FSceneOutlinerExpansionCache::Get();
+	if (!World || !ExpansionCache)
+	{
+		return nullptr;
+	}
+
+	const FString MapPackageName = World->GetOutermost()->GetName();
+	if (SavedExpansionMap != MapPackageName)
+	{
+		SavedExpansionMap = MapPackageName;
+		SavedExpansion = ExpansionCache->LoadSavedExpansionAsync(MapPackageName).GetResult();
+		if (SavedExpansion.IsSet())
+		{
+			SavedExpansion->Resolve();
+		}
+	}
+	return SavedExpansion.GetPtrOrNull();
+}
+
+int32 FSceneOutlinerIncrementalExpansion::GetItemDepth(const ISceneOutlinerTreeItem& Item)
+{
+	int32 Depth = 0;
+	for (FSceneOutlinerTreeItemPtr Parent = Item.GetParent(); Parent; Parent = Parent->GetParent())
+	{
+		++Depth;
+	}
+	return Depth;
+}
@@ -0,0 +1,345 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerLabelIndex.h"
+
+#include "OutlinerShortcutsStats.h"
+
+#include "Editor.h"
+#include "EditorActorFolders.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+
+namespace
+{
+	// Removed entries are only dropped from the lists once there are enough of them to be worth a rebuild
+	constexpr int32 MinRemovedEntriesToCompact = 1024;
+}
+
+FSceneOutlinerLabelIndex* FSceneOutlinerLabelIndex::Instance = nullptr;
+
+void FSceneOutlinerLabelIndex::OnStartupModule()
+{
+	Instance = this;
+	if (FSceneOutlinerWorldActorIndex* WorldActorIndex = FSceneOutlinerWorldActorIndex::Get())
+	{
+		WorldActorIndex->AddListener(*this);
+	}
+}
+
+void FSceneOutlinerLabelIndex::OnShutdownModule()
+{
+	UnbindEvents();
+	if (FSceneOutlinerWorldActorIndex* WorldActorIndex = FSceneOutlinerWorldActorIndex::Get())
+	{
+		WorldActorIndex->RemoveListener(*this);
+	}
+	Entries.Empty();
+	EntryIndices.Empty();
+	EntriesByTrigram.Empty();
+	IndexedWorld.Reset();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerLabelIndex* FSceneOutlinerLabelIndex::Get()
+{
+	return Instance;
+}
+
+void FSceneOutlinerLabelIndex::Find(const FString& Query, int32 MaxResults, TArray<FResult>& OutResults)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(FindLabel);
+	BuildIfNeeded();
+	if (Query.IsEmpty() || MaxResults <= 0)
+	{
+		return;
+	}
+
+	const int32 NumResultsBefore = OutResults.Num();
+	int32 NumVisited = 0;
+	TSet<int32> FoundEntries;
+	const auto AddResult = [this, &OutResults, &FoundEntries](int32 EntryIndex)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+		FResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.ID = Entry.ID;
+		Result.Label = Entry.Label;
+		Result.Actor = Entry.Actor;
+		Result.bIsFolder = Entry.bIsFolder;
+		const AActor* Actor = Entry.Actor.Get();
+		Result.ParentPath = Actor ? Actor->GetFolderPath() : Entry.ParentPath;
+		FoundEntries.Add(EntryIndex);
+	};
+
+	// The padded trigrams of the query only match the labels starting with it
+	TArray<FTrigram> Trigrams;
+	GetTrigrams(Query, true, Trigrams);
+	if (const TArray<int32>* Candidates = FindShortestList(Trigrams))
+	{
+		for (int32 Index = 0; Index < Candidates->Num() && OutResults.Num() - NumResultsBefore < MaxResults; ++Index)
+		{
+			const int32 EntryIndex = (*Candidates)[Index];
+			++NumVisited;
+			if (!Entries[EntryIndex].bRemoved && Entries[EntryIndex].Label.StartsWith(Query, ESearchCase::IgnoreCase))
+			{
+				AddResult(EntryIndex);
+			}
+		}
+	}
+
+	// Then the labels containing it, which need at least one full trigram
+	GetTrigrams(Query, false, Trigrams);
+	if (const TArray<int32>* Candidates = Trigrams.Num() > 0 ? FindShortestList(Trigrams) : nullptr)
+	{
+		for (int32 Index = 0; Index < Candidates->Num() && OutResults.Num() - NumResultsBefore < MaxResults; ++Index)
+		{
+			const int32 EntryIndex = (*Candidates)[Index];
+			++NumVisited;
+			if (!Entries[EntryIndex].bRemoved && !FoundEntries.Contains(EntryIndex) && Entries[EntryIndex].Label.Contains(Query, ESearchCase::IgnoreCase))
+			{
+				AddResult(EntryIndex);
+			}
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+}
+
+void FSceneOutlinerLabelIndex::GetTrigrams(const FString& Text, bool bPadded, TArray<FTrigram>& OutTrigrams)
+{
+	OutTrigrams.Reset();
+	FTrigram Trigram = 0;
+	int32 NumChars = bPadded ? 2 : 0;
+	for (const TCHAR Char : Text)
+	{
+		// 21 bits hold any code point, the padding character being 0
+		Trigram = ((Trigram << 21) | (static_cast<uint32>(FChar::ToLower(Char)) & 0x1FFFFF)) & ((FTrigram(1) << 63) - 1);
+		if (++NumChars >= 3)
+		{
+			OutTrigrams.Add(Trigram);
+		}
+	}
+
+	// A label repeating a trigram is only listed once under it
+	OutTrigrams.Sort();
+	int32 NumUnique = 0;
+	for (int32 Index = 0; Index < OutTrigrams.Num(); ++Index)
+	{
+		if (NumUnique == 0 || OutTrigrams[Index] != OutTrigrams[NumUnique - 1])
+		{
+			OutTrigrams[NumUnique++] = OutTrigrams[Index];
+		}
+	}
+	OutTrigrams.SetNum(NumUnique, EAllowShrinking::No);
+}
+
+const TArray<int32>* FSceneOutlinerLabelIndex::FindShortestList(const TArray<FTrigram>& Trigrams) const
+{
+	const TArray<int32>* Shortest = nullptr;
+	for (const FTrigram Trigram : Trigrams)
+	{
+		const TArray<int32>* List = EntriesByTrigram.Find(Trigram);
+		if (!List)
+		{
+			return nullptr;
+		}
+		if (!Shortest || List->Num() < Shortest->Num())
+		{
+			Shortest = List;
+		}
+	}
+	return Shortest;
+}
+
+void FSceneOutlinerLabelIndex::BuildIfNeeded()
+{
+	if (FSceneOutlinerWorldActorIndex* WorldActorIndex = FSceneOutlinerWorldActorIndex::Get())
+	{
+		WorldActorIndex->BuildIfNeeded(FOutlinerShortcutsEditorModule::GetCurrentEditorWorld());
+	}
+}
+
+void FSceneOutlinerLabelIndex::MarkDirty()
+{
+	if (FSceneOutlinerWorldActorIndex* WorldActorIndex = FSceneOutlinerWorldActorIndex::Get())
+	{
+		WorldActorIndex->MarkDirty();
+	}
+}
+
+void FSceneOutlinerLabelIndex::OnIndexReset(UWorld* World)
+{
+	Entries.Reset();
+	EntryIndices.Reset();
+	EntriesByTrigram.Reset();
+	NumRemoved = 0;
+	IndexedWorld = World;
+	if (!World)
+	{
+		return;
+	}
+
+	// The actors are added after, as they are walked
+	FActorFolders::Get().ForEachFolder(*World, [this](const FFolder& Folder)
+		{
+			AddFolder(Folder);
+			return true;
+		});
+
+	// Only listened to once built, like the actor events
+	BindEvents();
+}
+
+void FSceneOutlinerLabelIndex::AddEntry(FEntry&& Entry)
+{
+	const int32 EntryIndex = Entries.Num();
+	EntryIndices.Add(Entry.ID, EntryIndex);
+
+	TArray<FTrigram> Trigrams;
+	GetTrigrams(Entry.Label, true, Trigrams);
+	for (const FTrigram Trigram : Trigrams)
+	{
+		EntriesByTrigram.FindOrAdd(Trigram).Add(EntryIndex);
+	}
+	Entries.Add(MoveTemp(Entry));
+}
+
+void FSceneOutlinerLabelIndex::RemoveEntry(const FSceneOutlinerTreeItemID& ID)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!EntryIndices.RemoveAndCopyValue(ID, EntryIndex))
+	{
+		return;
+	}
+
+	// The lists still hold the entry, lookups skip it until they are rebuilt
+	Entries[EntryIndex].bRemoved = true;
+	Entries[EntryIndex].Actor.Reset();
+	++NumRemoved;
+	if (NumRemoved > FMath::Max(MinRemovedEntriesToCompact, Num()))
+	{
+		Compact();
+	}
+}
+
+void FSceneOutlinerLabelIndex::AddActor(AActor* Actor)
+{
+	if (!Actor || !Actor->IsListedInSceneOutliner())
+	{
+		return;
+	}
+
+	FEntry Entry;
+	Entry.ID = FSceneOutlinerTreeItemID(Actor);
+	if (EntryIndices.Contains(Entry.ID))
+	{
+		return;
+	}
+	Entry.Label = Actor->GetActorLabel();
+	Entry.Actor = Actor;
+	AddEntry(MoveTemp(Entry));
+}
+
+void FSceneOutlinerLabelIndex::AddFolder(const FFolder& Folder)
+{
+	FEntry Entry;
+	Entry.ID = FSceneOutlinerTreeItemID(Folder);
+	if (EntryIndices.Contains(Entry.ID))
+	{
+		return;
+	}
+	Entry.Label = Folder.GetLeafName().ToString();
+	Entry.ParentPath = Folder.GetParent().GetPath();
+	Entry.bIsFolder = true;
+	AddEntry(MoveTemp(Entry));
+}
+
+void FSceneOutlinerLabelIndex::Compact()
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(CompactLabelIndex);
+	TArray<FEntry> LiveEntries;
+	LiveEntries.Reserve(Num());
+	for (FEntry& Entry : Entries)
+	{
+		if (!Entry.bRemoved)
+		{
+			LiveEntries.Add(MoveTemp(Entry));
+		}
+	}
+
+	Entries.Reset();
+	EntryIndices.Reset();
+	EntriesByTrigram.Reset();
+	NumRemoved = 0;
+	for (FEntry& Entry : LiveEntries)
+	{
+		AddEntry(MoveTemp(Entry));
+	}
+	OUTLINER_SHORTCUTS_LOG_D("Compacted the label index to %d entries", Entries.Num());
+}
+
+void FSceneOutlinerLabelIndex::BindEvents()
+{
+	if (OnActorLabelChangedHandle.IsValid())
+	{
+		return;
+	}
+	OnActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FSceneOutlinerLabelIndex::OnActorLabelChanged);
+	OnPostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FSceneOutlinerLabelIndex::OnUndoRedo);
+	OnFolderCreatedHandle = FActorFolders::OnFolderCreated.AddRaw(this, &FSceneOutlinerLabelIndex::OnFolderCreated);
+	OnFolderDeletedHandle = FActorFolders::OnFolderDeleted.AddRaw(this, &FSceneOutlinerLabelIndex::OnFolderDeleted);
+	OnFolderMovedHandle = FActorFolders::OnFolderMoved.AddRaw(this, &FSceneOutlinerLabelIndex::OnFolderMoved);
+}
+
+void FSceneOutlinerLabelIndex::UnbindEvents()
+{
+	FCoreDelegates::OnActorLabelChanged.Remove(OnActorLabelChangedHandle);
+	FEditorDelegates::PostUndoRedo.Remove(OnPostUndoRedoHandle);
+	FActorFolders::OnFolderCreated.Remove(OnFolderCreatedHandle);
+	FActorFolders::OnFolderDeleted.Remove(OnFolderDeletedHandle);
+	FActorFolders::OnFolderMoved.Remove(OnFolderMovedHandle);
+	OnActorLabelChangedHandle.Reset();
+	OnPostUndoRedoHandle.Reset();
+	OnFolderCreatedHandle.Reset();
+	OnFolderDeletedHandle.Reset();
+	OnFolderMovedHandle.Reset();
+}
+
+void FSceneOutlinerLabelIndex::OnActorLabelChanged(AActor* Actor)
+{
+	if (Actor && Actor->GetWorld() == IndexedWorld.Get())
+	{
+		// The trigrams of the old label are unknown once renamed, so the entry is replaced
+		RemoveEntry(FSceneOutlinerTreeItemID(Actor));
+		AddActor(Actor);
+	}
+}
+
+void FSceneOutlinerLabelIndex::OnFolderCreated(UWorld& World, const FFolder& Folder)
+{
+	if (&World == IndexedWorld.Get())
+	{
+		AddFolder(Folder);
+	}
+}
+
+void FSceneOutlinerLabelIndex::OnFolderDeleted(UWorld& World, const FFolder& Folder)
+{
+	if (&World == IndexedWorld.Get())
+	{
+		RemoveEntry(FSceneOutlinerTreeItemID(Folder));
+	}
+}
+
+void FSceneOutlinerLabelIndex::OnFolderMoved(UWorld& World, const FFolder& Source, const FFolder& Destination)
+{
+	if (&World == IndexedWorld.Get())
+	{
+		RemoveEntry(FSceneOutlinerTreeItemID(Source));
+		AddFolder(Destination);
+	}
+}
@@ -0,0 +1,252 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerSelectionReveal.h"
+
+#include "SSceneOutliner.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "OutlinerShortcutsSettings.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "Editor.h"
+#include "Engine/Selection.h"
+#include "GameFramework/Actor.h"
+#include "Widgets/Views/STreeView.h"
+
+
+FSceneOutlinerSelectionReveal* FSceneOutlinerSelectionReveal::Instance = nullptr;
+
+void FSceneOutlinerSelectionReveal::OnStartupModule()
+{
+	Instance = this;
+	OnSelectionChangedHandle = USelection::SelectionChangedEvent.AddRaw(this, &FSceneOutlinerSelectionReveal::OnSelectionChanged);
+}
+
+void FSceneOutlinerSelectionReveal::OnShutdownModule()
+{
+	USelection::SelectionChangedEvent.Remove(OnSelectionChangedHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(FollowSelectionHandle);
+	FollowSelectionHandle.Reset();
+	States.Empty();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerSelectionReveal* FSceneOutlinerSelectionReveal::Get()
+{
+	return Instance;
+}
+
+bool FSceneOutlinerSelectionReveal::RevealSelection(SSceneOutliner& SOutliner)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(RevealSelection);
+
+	const TArray<FSceneOutlinerTreeItemPtr> SelectedItems = GetSelectedItems(SOutliner);
+	if (SelectedItems.Num() == 0)
+	{
+		OUTLINER_SHORTCUTS_LOG_H("Nothing selected to reveal");
+		return false;
+	}
+
+	FOutlinerState& State = FindOrAddState(SOutliner);
+	State.Path.Reset();
+	GatherParents(SelectedItems, State.Path);
+
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		CollapseOutsidePath(Batch, SOutliner, State.Path);
+		for (const TPair<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>& Parent : State.Path)
+		{
+			Batch.SetItemExpansion(SOutliner, Parent.Value.Pin(), true);
+		}
+	}
+
+	ScrollToFirstItem(SOutliner, SelectedItems);
+	OUTLINER_SHORTCUTS_LOG_D("Revealed %d selected items through %d parents", SelectedItems.Num(), State.Path.Num());
+	return true;
+}
+
+void FSceneOutlinerSelectionReveal::RevealItem(SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemPtr& Item)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(RevealItem);
+
+	FRevealedPath Path;
+	GatherParents({ Item }, Path);
+	{
+		FSceneOutlinerExpansionBatch Batch;
+		for (const TPair<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>& Parent : Path)
+		{
+			Batch.SetItemExpansion(SOutliner, Parent.Value.Pin(), true);
+		}
+	}
+	ScrollToFirstItem(SOutliner, { Item });
+}
+
+TArray<FSceneOutlinerTreeItemPtr> FSceneOutlinerSelectionReveal::GetSelectedItems(SSceneOutliner& SOutliner)
+{
+	TArray<FSceneOutlinerTreeItemPtr> Items;
+
+	// Finding the item of an actor is a map lookup, this doesn't depend on the size of the tree
+	if (USelection* SelectedActors = GEditor ? GEditor->GetSelectedActors() : nullptr)
+	{
+		for (FSelectionIterator It(*SelectedActors); It; ++It)
+		{
+			if (const AActor* Actor = Cast<AActor>(*It))
+			{
+				if (FSceneOutlinerTreeItemPtr Item = SOutliner.GetTreeItem(FSceneOutlinerTreeItemID(Actor)))
+				{
+					Items.Add(MoveTemp(Item));
+				}
+			}
+		}
+	}
+
+	// Folders can only be selected in the Outliner
+	if (Items.Num() == 0)
+	{
+		Items = SOutliner.GetSelectedItems();
+	}
+	return Items;
+}
+
+void FSceneOutlinerSelectionReveal::GatherParents(const TArray<FSceneOutlinerTreeItemPtr>& Items, FRevealedPath& OutPath)
+{
+	for (const FSceneOutlinerTreeItemPtr& Item : Items)
+	{
+		for (FSceneOutlinerTreeItemPtr Parent = Item ? Item->GetParent() : nullptr; Parent; Parent = Parent->GetParent())
+		{
+			// The rest of the chain was already added by a sibling
+			if (OutPath.Contains(Parent->GetID()))
+			{
+				break;
+			}
+			OutPath.Add(Parent->GetID(), Parent);
+		}
+	}
+}
+
+void FSceneOutlinerSelectionReveal::CollapseOutsidePath(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FRevealedPath& Path)
+{
+	// Items under a collapsed parent are not displayed, so collapsing the visible rows is enough to collapse everything
+	const TArray<FSceneOutlinerTreeItemPtr>& Rows = SOutliner.GetTree().GetItems();
+	for (const FSceneOutlinerTreeItemPtr& Row : Rows)
+	{
+		if (Row && Row->Flags.bIsExpanded && !Path.Contains(Row->GetID()))
+		{
+			Batch.SetItemExpansion(SOutliner, Row, false);
+		}
+	}
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, Rows.Num());
+
+	CollapseRevealedChildren(Batch, SOutliner, Path);
+}
+
+void FSceneOutlinerSelectionReveal::OnSelectionChanged(UObject* Selection)
+{
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	if (!EditorSettings || !EditorSettings->bRevealSelectionFollowsViewport || !GEditor || Selection != GEditor->GetSelectedActors())
+	{
+		return;
+	}
+
+	// A click in the viewport deselects and selects in a row, only update once the selection is settled
+	if (!FollowSelectionHandle.IsValid())
+	{
+		FollowSelectionHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSceneOutlinerSelectionReveal::TickFollowSelection));
+	}
+}
+
+bool FSceneOutlinerSelectionReveal::TickFollowSelection(float DeltaTime)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(FollowViewportSelection);
+	FollowSelectionHandle.Reset();
+
+	FSceneOutlinerExpansionBatch Batch;
+#if PRE_UE5_1
+	if (SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner())
+	{
+		if (FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(SOutliner))
+		{
+			UpdateRevealedPath(Batch, *SOutliner);
+		}
+	}
+#else
+	for (const TSharedRef<SSceneOutliner>& SOutliner : FOutlinerShortcutsEditorModule::GetAllSSceneOutliners())
+	{
+		if (FOutlinerShortcutsEditorModule::IsSceneOutlinerReady(&SOutliner.Get()))
+		{
+			UpdateRevealedPath(Batch, SOutliner.Get());
+		}
+	}
+#endif
+	return false;
+}
+
+void FSceneOutlinerSelectionReveal::UpdateRevealedPath(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner)
+{
+	FRevealedPath NewPath;
+	GatherParents(GetSelectedItems(SOutliner), NewPath);
+
+	FOutlinerState& State = FindOrAddState(SOutliner);
+	for (const TPair<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>& Parent : State.Path)
+	{
+		if (!NewPath.Contains(Parent.Key))
+		{
+			Batch.SetItemExpansion(SOutliner, Parent.Value.Pin(), false);
+		}
+	}
+	for (const TPair<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>& Parent : NewPath)
+	{
+		if (!State.Path.Contains(Parent.Key))
+		{
+			Batch.SetItemExpansion(SOutliner, Parent.Value.Pin(), true);
+		}
+	}
+	State.Path = MoveTemp(NewPath);
+}
+
+void FSceneOutlinerSelectionReveal::CollapseRevealedChildren(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FRevealedPath& Path)
+{
+	// Children shown by expanding a parent might still be expanded from before, only read their flags to find out
+	for (const TPair<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>& Parent : Path)
+	{
+		if (const FSceneOutlinerTreeItemPtr ParentItem = Parent.Value.Pin())
+		{
+			for (const TWeakPtr<ISceneOutlinerTreeItem>& WeakChild : ParentItem->GetChildren())
+			{
+				const FSceneOutlinerTreeItemPtr Child = WeakChild.Pin();
+				if (Child && Child->Flags.bIsExpanded && !Path.Contains(Child->GetID()))
+				{
+					Batch.SetItemExpansion(SOutliner, Child, false);
+				}
+			}
+		}
+	}
+}
+
+void FSceneOutlinerSelectionReveal::ScrollToFirstItem(SSceneOutliner& SOutliner, const TArray<FSceneOutlinerTreeItemPtr>& Items)
+{
+	if (Items.Num() > 0 && Items[0])
+	{
+		SOutliner.ScrollItemIntoView(Items[0]);
+	}
+}
+
+FSceneOutlinerSelectionReveal::FOutlinerState& FSceneOutlinerSelectionReveal::FindOrAddState(SSceneOutliner& SOutliner)
+{
+	States.RemoveAllSwap([](const FOutlinerState& State) { return !State.Outliner.IsValid(); });
+
+	for (FOutlinerState& State : States)
+	{
+		if (State.Outliner.Pin().Get() == &SOutliner)
+		{
+			return State;
+		}
+	}
+
+	FOutlinerState& State = States.AddDefaulted_GetRef();
+	State.Outliner = StaticCastSharedRef<SSceneOutliner>(SOutliner.AsShared());
+	return State;
+}
@@ -0,0 +1,198 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerTimeSlicedExpansion.h"
+
+#include "SSceneOutliner.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "OutlinerShortcutsSettings.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "SceneOutlinerFingerprints.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeExit.h"
+
+#define LOCTEXT_NAMESPACE "FSceneOutlinerTimeSlicedExpansion"
+
+FSceneOutlinerTimeSlicedExpansion* FSceneOutlinerTimeSlicedExpansion::Instance = nullptr;
+
+void FSceneOutlinerTimeSlicedExpansion::OnStartupModule()
+{
+	Instance = this;
+}
+
+void FSceneOutlinerTimeSlicedExpansion::OnShutdownModule()
+{
+	Cancel();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerTimeSlicedExpansion* FSceneOutlinerTimeSlicedExpansion::Get()
+{
+	return Instance;
+}
+
+bool FSceneOutlinerTimeSlicedExpansion::Start(const TArray<SSceneOutliner*>& SOutliners)
+{
+	Cancel();
+
+	for (SSceneOutliner* SOutliner : SOutliners)
+	{
+		if (!SOutliner)
+		{
+			continue;
+		}
+
+		FExpansionJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.Outliner = StaticCastSharedRef<SSceneOutliner>(SOutliner->AsShared());
+		for (const FSceneOutlinerTreeItemPtr& RootItem : FOutlinerShortcutsEditorModule::GetSceneOutlinerRootItems(SOutliner))
+		{
+			Job.Stack.Add(RootItem);
+		}
+	}
+
+	if (Jobs.Num() == 0)
+	{
+		OUTLINER_SHORTCUTS_WARN_H("No `SSceneOutliner` to expand");
+		return false;
+	}
+
+	ItemsVisited = 0;
+	ItemsExpanded = 0;
+	StartTime = FPlatformTime::Seconds();
+
+	FNotificationInfo Info(LOCTEXT("ExpandingNotification", "Expanding Outliner..."));
+	Info.bFireAndForget = false;
+	Info.ExpireDuration = 1.f;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		LOCTEXT("CancelButton", "Cancel"),
+		LOCTEXT("CancelButton_Tooltip", "Stop expanding the Outliner. Items already expanded stay expanded."),
+		FSimpleDelegate::CreateLambda([]() { if (Instance) { Instance->Cancel(); } }),
+		SNotificationItem::CS_Pending));
+	if (TSharedPtr<SNotificationItem> Item = FSlateNotificationManager::Get().AddNotification(Info))
+	{
+		Item->SetCompletionState(SNotificationItem::CS_Pending);
+		Notification = Item;
+	}
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSceneOutlinerTimeSlicedExpansion::Tick));
+	return true;
+}
+
+bool FSceneOutlinerTimeSlicedExpansion::Cancel()
+{
+	if (!IsRunning())
+	{
+		return false;
+	}
+	OUTLINER_SHORTCUTS_LOG_H("Expansion cancelled after %d items", ItemsVisited);
+	Finish(true);
+	return true;
+}
+
+bool FSceneOutlinerTimeSlicedExpansion::Tick(float DeltaTime)
+{
+	// Recorded as a command so the cost of each slice shows up in `OutlinerShortcuts.DumpStats`
+	OUTLINER_SHORTCUTS_SCOPE_COMMAND(TimeSlicedExpandAllTick);
+	const int32 ItemsVisitedBefore = ItemsVisited;
+	ON_SCOPE_EXIT
+	{
+		OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, ItemsVisited - ItemsVisitedBefore);
+	};
+	const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance();
+	const double BudgetSeconds = FMath::Max(EditorSettings ? EditorSettings->ExpandAllFrameBudgetMs : 5.f, 0.1f) / 1000.;
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+
+	// Only check the time every few items, reading the clock is not free either
+	constexpr int32 ItemsBetweenTimeChecks = 64;
+	int32 ItemsUntilTimeCheck = ItemsBetweenTimeChecks;
+
+	// The items expanded during this tick are applied together when leaving, so each Outliner refreshes at most once per frame
+	FSceneOutlinerExpansionBatch Batch;
+
+	for (int32 JobIndex = Jobs.Num() - 1; JobIndex >= 0; --JobIndex)
+	{
+		FExpansionJob& Job = Jobs[JobIndex];
+		SSceneOutliner* SOutliner = Job.Outliner.Pin().Get();
+		if (!SOutliner)
+		{
+			Jobs.RemoveAtSwap(JobIndex);
+			continue;
+		}
+
+		while (Job.Stack.Num() > 0)
+		{
+			if (--ItemsUntilTimeCheck <= 0)
+			{
+				if (FPlatformTime::Seconds() >= EndTime)
+				{
+					UpdateNotification();
+					return true;
+				}
+				ItemsUntilTimeCheck = ItemsBetweenTimeChecks;
+			}
+
+			const FSceneOutlinerTreeItemPtr Item = Job.Stack.Pop(EAllowShrinking::No).Pin();
+			if (!Item)
+			{
+				continue;
+			}
+			++ItemsVisited;
+
+			const TArray<TWeakPtr<ISceneOutlinerTreeItem>>& Children = Item->GetChildren();
+			if (Children.Num() > 0)
+			{
+				if (!Item->Flags.bIsExpanded)
+				{
+					Batch.SetItemExpansion(*SOutliner, Item, true);
+					++ItemsExpanded;
+				}
+				Job.Stack.Append(Children);
+			}
+		}
+
+		// The fingerprint hashes the expansion, so the changes of this Outliner have to be applied first
+		Batch.Commit();
+		FSceneOutlinerFingerprints::Record(*SOutliner, FSceneOutlinerFingerprints::ExpandAllPolicy);
+		Jobs.RemoveAtSwap(JobIndex);
+	}
+
+	OUTLINER_SHORTCUTS_LOG_H("Expanded %d of %d items in %.2fs", ItemsExpanded, ItemsVisited, FPlatformTime::Seconds() - StartTime);
+	Finish(false);
+	return false;
+}
+
+void FSceneOutlinerTimeSlicedExpansion::Finish(bool bCancelled)
+{
+	// The items expanded so far were already applied at the end of their tick
+	Jobs.Empty();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+
+	if (TSharedPtr<SNotificationItem> Item = Notification.Pin())
+	{
+		Item->SetText(bCancelled
+			? FText::Format(LOCTEXT("CancelledNotification", "Outliner expansion cancelled ({0} items expanded)"), FText::AsNumber(ItemsExpanded))
+			: FText::Format(LOCTEXT("FinishedNotification", "Outliner expanded ({0} items expanded)"), FText::AsNumber(ItemsExpanded)));
+		Item->SetCompletionState(bCancelled ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success);
+		Item->ExpireAndFadeout();
+	}
+	Notification.Reset();
+}
+
+void FSceneOutlinerTimeSlicedExpansion::UpdateNotification()
+{
+	if (TSharedPtr<SNotificationItem> Item = Notification.Pin())
+	{
+		Item->SetText(FText::Format(LOCTEXT("ProgressNotification", "Expanding Outliner... ({0} items visited, {1} expanded)"), FText::AsNumber(ItemsVisited), FText::AsNumber(ItemsExpanded)));
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,228 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerTracker.h"
+
+#if UE5_1_ONWARDS
+
+#include "LevelEditor.h"
+#include "ISceneOutliner.h"
+#include "SSceneOutliner.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Framework/Application/SlateApplication.h"
+
+
+FSceneOutlinerTracker* FSceneOutlinerTracker::Instance = nullptr;
+
+void FSceneOutlinerTracker::OnStartupModule()
+{
+	Instance = this;
+
+	const TSharedRef<FGlobalTabmanager> GlobalTabManager = FGlobalTabmanager::Get();
+	OnActiveTabChangedHandle = GlobalTabManager->OnActiveTabChanged_Subscribe(FOnActiveTabChanged::FDelegate::CreateRaw(this, &FSceneOutlinerTracker::OnActiveTabChanged));
+	OnTabForegroundedHandle = GlobalTabManager->OnTabForegrounded_Subscribe(FOnActiveTabChanged::FDelegate::CreateRaw(this, &FSceneOutlinerTracker::OnActiveTabChanged));
+
+	if (FLevelEditorModule* LevelEditorModule = FModuleManager::LoadModulePtr<FLevelEditorModule>("LevelEditor"))
+	{
+		OnTabContentChangedHandle = LevelEditorModule->OnTabContentChanged().AddRaw(this, &FSceneOutlinerTracker::MarkDirty);
+		OnLevelEditorCreatedHandle = LevelEditorModule->OnLevelEditorCreated().AddLambda([this](TSharedPtr<ILevelEditor>) { MarkDirty(); });
+	}
+	else
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("Not able to load `LevelEditor` module");
+	}
+}
+
+void FSceneOutlinerTracker::OnShutdownModule()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		const TSharedRef<FGlobalTabmanager> GlobalTabManager = FGlobalTabmanager::Get();
+		GlobalTabManager->OnActiveTabChanged_Unsubscribe(OnActiveTabChangedHandle);
+		GlobalTabManager->OnTabForegrounded_Unsubscribe(OnTabForegroundedHandle);
+	}
+
+	if (FLevelEditorModule* LevelEditorModule = FModuleManager::GetModulePtr<FLevelEditorModule>("LevelEditor"))
+	{
+		LevelEditorModule->OnTabContentChanged().Remove(OnTabContentChangedHandle);
+		LevelEditorModule->OnLevelEditorCreated().Remove(OnLevelEditorCreatedHandle);
+	}
+
+	Outliners.Empty();
+	OutlinerIDs.Empty();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerTracker* FSceneOutlinerTracker::Get()
+{
+	return Instance;
+}
+
+TSharedPtr<SSceneOutliner> FSceneOutlinerTracker::GetMostRecentlyUsedOutliner()
+{
+	RefreshIfDirty();
+
+	// A closed Outliner stays where it was in the list, and is only dropped here once the Outliners used after it are closed too.
+	// The others are dropped by `RemoveStaleOutliners`, there are at most four Outliners anyway.
+	while (Outliners.Num() > 0)
+	{
+		if (TSharedPtr<SSceneOutliner> SOutliner = Outliners[0].Pin())
+		{
+			return SOutliner;
+		}
+		Outliners.RemoveAt(0);
+		OutlinerIDs.RemoveAt(0);
+	}
+	return nullptr;
+}
+
+TArray<TSharedRef<SSceneOutliner>> FSceneOutlinerTracker::GetAllOutliners()
+{
+	RefreshIfDirty();
+	RemoveStaleOutliners();
+
+	TArray<TSharedRef<SSceneOutliner>> Result;
+	Result.Reserve(Outliners.Num());
+	for (const TWeakPtr<SSceneOutliner>& WeakOutliner : Outliners)
+	{
+		if (TSharedPtr<SSceneOutliner> SOutliner = WeakOutliner.Pin())
+		{
+			Result.Add(SOutliner.ToSharedRef());
+		}
+	}
+	return Result;
+}
+
+void FSceneOutlinerTracker::OnActiveTabChanged(TSharedPtr<SDockTab> PreviouslyActive, TSharedPtr<SDockTab> NewlyActivated)
+{
+	if (!NewlyActivated.IsValid())
+	{
+		return;
+	}
+
+	const FName TabID = NewlyActivated->GetLayoutIdentifier().TabType;
+	if (MoveToFront(TabID))
+	{
+		return;
+	}
+
+	// The tab might be an Outliner we don't know about yet, only look for it if the number of Outliners changed
+	if (!bIsDirty)
+	{
+		if (const FLevelEditorModule* LevelEditorModule = FModuleManager::GetModulePtr<FLevelEditorModule>("LevelEditor"))
+		{
+			if (const TSharedPtr<ILevelEditor> LevelEditor = LevelEditorModule->GetFirstLevelEditor())
+			{
+				bIsDirty = LevelEditor->GetAllSceneOutliners().Num() != Outliners.Num();
+			}
+		}
+	}
+
+	if (bIsDirty)
+	{
+		RefreshIfDirty();
+		MoveToFront(TabID);
+	}
+}
+
+bool FSceneOutlinerTracker::MoveToFront(const FName TabID)
+{
+	int32 Index = OutlinerIDs.IndexOfByKey(TabID);
+	if (Index != INDEX_NONE && !Outliners[Index].IsValid())
+	{
+		// The tab was closed and opened again with a new Outliner, which has to be gathered in place of the old one
+		bIsDirty = true;
+		RefreshIfDirty();
+		Index = OutlinerIDs.IndexOfByKey(TabID);
+	}
+	if (Index == INDEX_NONE || !Outliners[Index].IsValid())
+	{
+		return false;
+	}
+
+	if (Index > 0)
+	{
+		TWeakPtr<SSceneOutliner> SOutliner = Outliners[Index];
+		Outliners.RemoveAt(Index);
+		OutlinerIDs.RemoveAt(Index);
+		Outliners.Insert(MoveTemp(SOutliner), 0);
+		OutlinerIDs.Insert(TabID, 0);
+	}
+	OUTLINER_SHORTCUTS_LOG_D("Most Recent Outliner is: `%s`", *TabID.ToString());
+	return true;
+}
+
+void FSceneOutlinerTracker::RefreshIfDirty()
+{
+	if (!bIsDirty)
+	{
+		return;
+	}
+	bIsDirty = false;
+
+	const FLevelEditorModule* LevelEditorModule = FModuleManager::GetModulePtr<FLevelEditorModule>("LevelEditor");
+	const TSharedPtr<ILevelEditor> LevelEditor = LevelEditorModule ? LevelEditorModule->GetFirstLevelEditor() : nullptr;
+	if (!LevelEditor)
+	{
+		OUTLINER_SHORTCUTS_LOG_D("Not able to get an `ILevelEditor`, the Outliners will be gathered on the next lookup");
+		bIsDirty = true;
+		return;
+	}
+
+	OUTLINER_SHORTCUTS_LOG_D("Gathering the Outliners of the Level Editor");
+	RemoveStaleOutliners();
+
+	// New Outliners are sorted between themselves by the last activation time of their tab, and go after the ones we already know about
+	const FTabManager* Manager = LevelEditor->GetTabManager().Get();
+	TArray<TPair<double, TSharedRef<SSceneOutliner>>> NewOutliners;
+	for (const TWeakPtr<ISceneOutliner>& WeakOutliner : LevelEditor->GetAllSceneOutliners())
+	{
+		const TSharedPtr<ISceneOutliner> IOutliner = WeakOutliner.Pin();
+		if (!IOutliner)
+		{
+			continue;
+		}
+
+		const TSharedRef<SSceneOutliner> SOutliner = StaticCastSharedRef<SSceneOutliner>(IOutliner.ToSharedRef());
+		const FName ID = SOutliner->GetOutlinerIdentifier();
+		if (OutlinerIDs.Contains(ID))
+		{
+			continue;
+		}
+
+		double LastActivated = 0.;
+		if (Manager)
+		{
+			if (const TSharedPtr<SDockTab> OutlinerTab = Manager->FindExistingLiveTab(ID))
+			{
+				LastActivated = OutlinerTab->GetLastActivationTime();
+			}
+		}
+		NewOutliners.Emplace(LastActivated, SOutliner);
+	}
+
+	NewOutliners.Sort([](const TPair<double, TSharedRef<SSceneOutliner>>& A, const TPair<double, TSharedRef<SSceneOutliner>>& B) { return A.Key > B.Key; });
+	for (const TPair<double, TSharedRef<SSceneOutliner>>& NewOutliner : NewOutliners)
+	{
+		Outliners.Add(NewOutliner.Value);
+		OutlinerIDs.Add(NewOutliner.Value->GetOutlinerIdentifier());
+	}
+}
+
+void FSceneOutlinerTracker::RemoveStaleOutliners()
+{
+	for (int32 Index = Outliners.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Outliners[Index].IsValid())
+		{
+			Outliners.RemoveAt(Index);
+			OutlinerIDs.RemoveAt(Index);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,365 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerTreeModel.h"
+
+#include "OutlinerShortcutsEditor.h"
+#include "SceneOutlinerExpansionBatch.h"
+#include "SceneOutlinerTreePolicies.h"
+#include "SceneOutlinerFingerprints.h"
+#include "OutlinerShortcutsStats.h"
+
+#include "SSceneOutliner.h"
+#include "FolderTreeItem.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 TreeModelMagic = 0x5453534F; // "OSST"
+	constexpr uint32 TreeModelVersion = 1;
+}
+
+int32 ISceneOutlinerTreeModel::SetAllExpanded(bool bExpanded)
+{
+	return FSceneOutlinerTreePolicies::SetAllExpanded(*this, bExpanded, [](int32) { return TOptional<bool>(); });
+}
+
+int32 FSceneOutlinerMemoryTreeModel::AddItem(int32 Parent, FName FolderPath, bool bExpanded)
+{
+	check(Parent == INDEX_NONE || Parents.IsValidIndex(Parent));
+
+	const int32 Item = Parents.Add(Parent);
+	FirstChild.Add(INDEX_NONE);
+	LastChild.Add(INDEX_NONE);
+	NextSibling.Add(INDEX_NONE);
+	Expanded.Add(bExpanded);
+	if (!FolderPath.IsNone())
+	{
+		FolderPaths.Add(Item, FolderPath);
+	}
+
+	if (Parent == INDEX_NONE)
+	{
+		Roots.Add(Item);
+	}
+	else if (LastChild[Parent] == INDEX_NONE)
+	{
+		FirstChild[Parent] = Item;
+		LastChild[Parent] = Item;
+	}
+	else
+	{
+		NextSibling[LastChild[Parent]] = Item;
+		LastChild[Parent] = Item;
+	}
+	return Item;
+}
+
+void FSceneOutlinerMemoryTreeModel::Reset()
+{
+	Parents.Reset();
+	FirstChild.Reset();
+	LastChild.Reset();
+	NextSibling.Reset();
+	Roots.Reset();
+	Expanded.Reset();
+	FolderPaths.Reset();
+}
+
+TSharedRef<FSceneOutlinerMemoryTreeModel> FSceneOutlinerMemoryTreeModel::Capture(const ISceneOutlinerTreeModel& Source)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(CaptureTreeModel);
+	TSharedRef<FSceneOutlinerMemoryTreeModel> Model = MakeShared<FSceneOutlinerMemoryTreeModel>();
+
+	// Breadth first, so the items of a level are next to each other in the arrays
+	TArray<TPair<int32, int32>> Queue;
+	TArray<int32> Items;
+	Source.GetRootItems(Items);
+	for (const int32 Item : Items)
+	{
+		Queue.Emplace(Item, INDEX_NONE);
+	}
+
+	TArray<int32> Children;
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const int32 SourceItem = Queue[QueueIndex].Key;
+		const int32 Item = Model->AddItem(Queue[QueueIndex].Value, Source.GetFolderPath(SourceItem), Source.IsExpanded(SourceItem));
+
+		Children.Reset();
+		Source.GetChildren(SourceItem, Children);
+		for (const int32 Child : Children)
+		{
+			Queue.Emplace(Child, Item);
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, Queue.Num());
+	OUTLINER_SHORTCUTS_LOG_D("Captured %d items, %d of them folders", Model->Num(), Model->FolderPaths.Num());
+	return Model;
+}
+
+void FSceneOutlinerMemoryTreeModel::SetExpansion(const TBitArray<>& InExpanded)
+{
+	if (InExpanded.Num() == Expanded.Num())
+	{
+		Expanded = InExpanded;
+	}
+	else
+	{
+		OUTLINER_SHORTCUTS_ERROR_H("The expansion given has %d items, the tree has %d", InExpanded.Num(), Expanded.Num());
+	}
+}
+
+void FSceneOutlinerMemoryTreeModel::Serialize(FArchive& Ar)
+{
+	uint32 Magic = TreeModelMagic;
+	uint32 Version = TreeModelVersion;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsLoading() && (Magic != TreeModelMagic || Version != TreeModelVersion))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	// Folder names are saved as strings, names are not stable across sessions
+	TMap<int32, FString> FolderPathStrings;
+	if (Ar.IsSaving())
+	{
+		for (const TPair<int32, FName>& Pair : FolderPaths)
+		{
+			FolderPathStrings.Add(Pair.Key, Pair.Value.ToString());
+		}
+	}
+
+	Ar << Parents;
+	Ar << Expanded;
+	Ar << FolderPathStrings;
+
+	if (Ar.IsLoading())
+	{
+		bool bValid = Expanded.Num() == Parents.Num();
+		for (int32 Item = 0; bValid && Item < Parents.Num(); ++Item)
+		{
+			// Parents always come before their children
+			bValid = Parents[Item] >= INDEX_NONE && Parents[Item] < Item;
+		}
+		if (!bValid)
+		{
+			Ar.SetError();
+			Reset();
+			return;
+		}
+
+		FolderPaths.Reset();
+		for (const TPair<int32, FString>& Pair : FolderPathStrings)
+		{
+			FolderPaths.Add(Pair.Key, FName(*Pair.Value));
+		}
+		LinkChildren();
+	}
+}
+
+bool FSceneOutlinerMemoryTreeModel::SaveToFile(const FString& Filename) const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	const_cast<FSceneOutlinerMemoryTreeModel*>(this)->Serialize(Writer);
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+TSharedPtr<FSceneOutlinerMemoryTreeModel> FSceneOutlinerMemoryTreeModel::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename))
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FSceneOutlinerMemoryTreeModel> Model = MakeShared<FSceneOutlinerMemoryTreeModel>();
+	FMemoryReader Reader(Data);
+	Model->Serialize(Reader);
+	if (Reader.IsError())
+	{
+		OUTLINER_SHORTCUTS_WARN_H("`%s` is not a saved Outliner tree", *Filename);
+		return nullptr;
+	}
+	return Model;
+}
+
+void FSceneOutlinerMemoryTreeModel::GetChildren(int32 Item, TArray<int32>& OutChildren) const
+{
+	for (int32 Child = FirstChild[Item]; Child != INDEX_NONE; Child = NextSibling[Child])
+	{
+		OutChildren.Add(Child);
+	}
+}
+
+FName FSceneOutlinerMemoryTreeModel::GetFolderPath(int32 Item) const
+{
+	const FName* FolderPath = FolderPaths.Find(Item);
+	return FolderPath ? *FolderPath : NAME_None;
+}
+
+void FSceneOutlinerMemoryTreeModel::LinkChildren()
+{
+	const int32 NumItems = Parents.Num();
+	FirstChild.Init(INDEX_NONE, NumItems);
+	LastChild.Init(INDEX_NONE, NumItems);
+	NextSibling.Init(INDEX_NONE, NumItems);
+	Roots.Reset();
+
+	for (int32 Item = 0; Item < NumItems; ++Item)
+	{
+		const int32 Parent = Parents[Item];
+		if (Parent == INDEX_NONE)
+		{
+			Roots.Add(Item);
+		}
+		else if (LastChild[Parent] == INDEX_NONE)
+		{
+			FirstChild[Parent] = Item;
+			LastChild[Parent] = Item;
+		}
+		else
+		{
+			NextSibling[LastChild[Parent]] = Item;
+			LastChild[Parent] = Item;
+		}
+	}
+}
+
+
+FSceneOutlinerWidgetTreeModel::FSceneOutlinerWidgetTreeModel(SSceneOutliner& InOutliner, FSceneOutlinerExpansionBatch* InBatch)
+	: Outliner(InOutliner)
+	, Batch(InBatch)
+{
+}
+
+FSceneOutlinerTreeItemPtr FSceneOutlinerWidgetTreeModel::GetItem(int32 Item) const
+{
+	FSceneOutlinerTreeItemPtr TreeItem = Items[Item].Pin();
+	if (!TreeItem)
+	{
+		// Refreshes recreate the items with the same ID
+		TreeItem = Outliner.GetTreeItem(Interner.GetID(Item));
+		Items[Item] = TreeItem;
+	}
+	return TreeItem;
+}
+
+void FSceneOutlinerWidgetTreeModel::GetRootItems(TArray<int32>& OutItems) const
+{
+	for (const FSceneOutlinerTreeItemPtr& Item : FOutlinerShortcutsEditorModule::GetSceneOutlinerRootItems(&Outliner))
+	{
+		OutItems.Add(Intern(Item));
+	}
+}
+
+void FSceneOutlinerWidgetTreeModel::GetChildren(int32 Item, TArray<int32>& OutChildren) const
+{
+	if (const FSceneOutlinerTreeItemPtr TreeItem = GetItem(Item))
+	{
+		for (const TWeakPtr<ISceneOutlinerTreeItem>& Child : TreeItem->GetChildren())
+		{
+			if (const FSceneOutlinerTreeItemPtr ChildItem = Child.Pin())
+			{
+				OutChildren.Add(Intern(ChildItem));
+			}
+		}
+	}
+}
+
+bool FSceneOutlinerWidgetTreeModel::HasChildren(int32 Item) const
+{
+	const FSceneOutlinerTreeItemPtr TreeItem = GetItem(Item);
+	return TreeItem && TreeItem->GetChildren().Num() > 0;
+}
+
+int32 FSceneOutlinerWidgetTreeModel::GetParent(int32 Item) const
+{
+	const FSceneOutlinerTreeItemPtr TreeItem = GetItem(Item);
+	const FSceneOutlinerTreeItemPtr Parent = TreeItem ? TreeItem->GetParent() : nullptr;
+	return Parent ? Intern(Parent) : INDEX_NONE;
+}
+
+bool FSceneOutlinerWidgetTreeModel::IsExpanded(int32 Item) const
+{
+	const FSceneOutlinerTreeItemPtr TreeItem = GetItem(Item);
+	if (!TreeItem)
+	{
+		return false;
+	}
+	return Batch ? Batch->IsItemExpanded(Outliner, TreeItem) : TreeItem->Flags.bIsExpanded;
+}
+
+void FSceneOutlinerWidgetTreeModel::SetExpanded(int32 Item, bool bExpanded)
+{
+	const FSceneOutlinerTreeItemPtr TreeItem = GetItem(Item);
+	if (!TreeItem)
+	{
+		return;
+	}
+
+	if (Batch)
+	{
+		Batch->SetItemExpansion(Outliner, TreeItem, bExpanded);
+	}
+	else if (TreeItem->Flags.bIsExpanded != bExpanded)
+	{
+		Outliner.SetItemExpansion(TreeItem, bExpanded);
+		FSceneOutlinerFingerprints::ReportItemExpansionChanged(Outliner, TreeItem->GetID(), bExpanded);
+		if (bExpanded)
+		{
+			++NumExpanded;
+		}
+		else
+		{
+			++NumCollapsed;
+		}
+	}
+}
+
+FName FSceneOutlinerWidgetTreeModel::GetFolderPath(int32 Item) const
+{
+	const FSceneOutlinerTreeItemPtr TreeItem = GetItem(Item);
+	const FFolderTreeItem* FolderItem = TreeItem ? TreeItem->CastTo<FFolderTreeItem>() : nullptr;
+	return FolderItem ? FolderItem->GetPath() : NAME_None;
+}
+
+int32 FSceneOutlinerWidgetTreeModel::SetAllExpanded(bool bExpanded)
+{
+	if (!Batch)
+	{
+		return ISceneOutlinerTreeModel::SetAllExpanded(bExpanded);
+	}
+
+	if (bExpanded)
+	{
+		Batch->ExpandAll(Outliner);
+	}
+	else
+	{
+		Batch->CollapseAll(Outliner);
+	}
+	return 0;
+}
+
+int32 FSceneOutlinerWidgetTreeModel::Intern(const FSceneOutlinerTreeItemPtr& Item) const
+{
+	const int32 Index = Interner.Intern(Item->GetID());
+	if (Index == Items.Num())
+	{
+		Items.Add(Item);
+	}
+	else
+	{
+		// The item might have been recreated by a refresh of the Outliner
+		Items[Index] = Item;
+	}
+	return Index;
+}
@@ -0,0 +1,230 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerTreePolicies.h"
+
+#include "SceneOutlinerTreeModel.h"
+#include "SceneOutlinerExpansionFrontier.h"
+#include "FolderPathMatcher.h"
+#include "OutlinerShortcutsLibrary.h"
+#include "OutlinerShortcutsSettings.h"
+#include "OutlinerShortcutsStats.h"
+
+
+int32 FSceneOutlinerTreePolicies::GetDepth(const ISceneOutlinerTreeModel& Model, int32 Item)
+{
+	int32 Depth = 0;
+	for (int32 Parent = Model.GetParent(Item); Parent != INDEX_NONE; Parent = Model.GetParent(Parent))
+	{
+		++Depth;
+	}
+	return Depth;
+}
+
+int32 FSceneOutlinerTreePolicies::SetAllExpanded(ISceneOutlinerTreeModel& Model, bool bExpanded, TFunctionRef<TOptional<bool>(int32)> GetOverride)
+{
+	// Items under a collapsed one are walked too, so they do not reappear in another state once their parent is expanded
+	TArray<int32> Stack;
+	Model.GetRootItems(Stack);
+	int32 NumVisited = 0;
+	while (Stack.Num() > 0)
+	{
+		const int32 Item = Stack.Pop(EAllowShrinking::No);
+		++NumVisited;
+		if (!Model.HasChildren(Item))
+		{
+			continue;
+		}
+
+		const bool bItemExpanded = GetOverride(Item).Get(bExpanded);
+		if (Model.IsExpanded(Item) != bItemExpanded)
+		{
+			Model.SetExpanded(Item, bItemExpanded);
+		}
+		Model.GetChildren(Item, Stack);
+	}
+	return NumVisited;
+}
+
+int32 FSceneOutlinerTreePolicies::CollapseAll(ISceneOutlinerTreeModel& Model)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(TreeCollapseAll);
+	const int32 NumVisited = Model.SetAllExpanded(false);
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	return NumVisited;
+}
+
+int32 FSceneOutlinerTreePolicies::CollapseToRoot(ISceneOutlinerTreeModel& Model)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(TreeCollapseToRoot);
+	const int32 NumCollapsed = Model.SetAllExpanded(false);
+
+	TArray<int32> Roots;
+	Model.GetRootItems(Roots);
+	for (const int32 Root : Roots)
+	{
+		if (Model.HasChildren(Root))
+		{
+			Model.SetExpanded(Root, true);
+		}
+	}
+
+	const int32 NumVisited = NumCollapsed + Roots.Num();
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	return NumVisited;
+}
+
+int32 FSceneOutlinerTreePolicies::ExpandAll(ISceneOutlinerTreeModel& Model)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(TreeExpandAll);
+	const int32 NumVisited = Model.SetAllExpanded(true);
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	return NumVisited;
+}
+
+int32 FSceneOutlinerTreePolicies::ExpandToDepth(ISceneOutlinerTreeModel& Model, int32 Depth)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(TreeExpandToDepth);
+	FSceneOutlinerExpansionFrontier Frontier;
+	return Frontier.ExpandToDepth(Model, Depth);
+}
+
+int32 FSceneOutlinerTreePolicies::ExpandMatchingFolders(ISceneOutlinerTreeModel& Model, const FFolderPathMatcher& Matcher)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(TreeExpandMatchingFolders);
+	const int32 NumCollapsed = CollapseToRoot(Model);
+	if (Matcher.IsEmpty())
+	{
+		return NumCollapsed;
+	}
+
+	using FFolderEntry = TPair<int32, FFolderPathMatcher::FStates>;
+	TArray<FFolderEntry> Stack;
+	TArray<int32> Items;
+	Model.GetRootItems(Items);
+	for (const int32 Root : Items)
+	{
+		Stack.Emplace(Root, Matcher.GetInitialStates());
+	}
+
+	TSet<int32> Expanded;
+	int32 NumVisited = 0;
+	int32 NumFolders = 0;
+	int32 NumMatched = 0;
+	while (Stack.Num() > 0)
+	{
+		FFolderEntry Entry = Stack.Pop(EAllowShrinking::No);
+		const int32 Item = Entry.Key;
+		FFolderPathMatcher::FStates States = MoveTemp(Entry.Value);
+		++NumVisited;
+
+		const FName FolderPath = Model.GetFolderPath(Item);
+		if (!FolderPath.IsNone())
+		{
+			++NumFolders;
+			const FString Path = FolderPath.ToString();
+			int32 SlashIndex = INDEX_NONE;
+			const FStringView Leaf = Path.FindLastChar(TEXT('/'), SlashIndex) ? FStringView(Path).RightChop(SlashIndex + 1) : FStringView(Path);
+			States = Matcher.Step(States, Leaf);
+
+			if (Matcher.IsMatch(States))
+			{
+				++NumMatched;
+				// A folder is only displayed if all its parents are expanded
+				for (int32 Parent = Item; Parent != INDEX_NONE && !Expanded.Contains(Parent); Parent = Model.GetParent(Parent))
+				{
+					Expanded.Add(Parent);
+					Model.SetExpanded(Parent, true);
+				}
+			}
+		}
+
+		if (States.Num() == 0)
+		{
+			continue;
+		}
+		Items.Reset();
+		Model.GetChildren(Item, Items);
+		for (const int32 Child : Items)
+		{
+			if (!Model.GetFolderPath(Child).IsNone())
+			{
+				Stack.Emplace(Child, States);
+			}
+		}
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	OUTLINER_SHORTCUTS_LOG_D("Matched %d of the %d folders visited", NumMatched, NumFolders);
+	return NumCollapsed + NumVisited;
+}
+
+int32 FSceneOutlinerTreePolicies::SetSubtreesExpansion(ISceneOutlinerTreeModel& Model, const TArray<int32>& Items, bool bExpand)
+{
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(TreeSetSubtreesExpansion);
+
+	// Skip the items nested under another one, their subtree is walked with their ancestor's
+	const TSet<int32> ItemSet(Items);
+	TArray<int32> Stack;
+	for (const int32 Item : ItemSet)
+	{
+		int32 Parent = Model.GetParent(Item);
+		while (Parent != INDEX_NONE && !ItemSet.Contains(Parent))
+		{
+			Parent = Model.GetParent(Parent);
+		}
+		if (Parent == INDEX_NONE)
+		{
+			Stack.Add(Item);
+		}
+	}
+
+	// The whole subtree is walked even when collapsing, so the hidden items do not reappear expanded
+	int32 NumVisited = 0;
+	while (Stack.Num() > 0)
+	{
+		const int32 Item = Stack.Pop(EAllowShrinking::No);
+		++NumVisited;
+		if (!Model.HasChildren(Item))
+		{
+			continue;
+		}
+		if (Model.IsExpanded(Item) != bExpand)
+		{
+			Model.SetExpanded(Item, bExpand);
+		}
+		Model.GetChildren(Item, Stack);
+	}
+
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumVisited);
+	return NumVisited;
+}
+
+bool FSceneOutlinerTreePolicies::ApplyOperation(ISceneOutlinerTreeModel& Model, const FOutlinerShortcutsOperation& Operation, int32& OutNumVisited)
+{
+	switch (Operation.Type)
+	{
+	case EOutlinerShortcutsOperationType::CollapseAll:
+		OutNumVisited = CollapseAll(Model);
+		return true;
+	case EOutlinerShortcutsOperationType::CollapseToRoot:
+		OutNumVisited = CollapseToRoot(Model);
+		return true;
+	case EOutlinerShortcutsOperationType::ExpandAll:
+		OutNumVisited = ExpandAll(Model);
+		return true;
+	case EOutlinerShortcutsOperationType::ExpandToDepth:
+		OutNumVisited = ExpandToDepth(Model, Operation.Depth);
+		return true;
+	case EOutlinerShortcutsOperationType::ExpandMatchingFolders:
+		if (const UOutlinerShortcutsEditorSettings* EditorSettings = UOutlinerShortcutsEditorSettings::GetDefaultInstance())
+		{
+			OutNumVisited = ExpandMatchingFolders(Model, EditorSettings->GetFolderPatternMatcher());
+			return true;
+		}
+		return false;
+	default:
+		// The saved state and the actor classes are only known from a map
+		OutNumVisited = 0;
+		return false;
+	}
+}
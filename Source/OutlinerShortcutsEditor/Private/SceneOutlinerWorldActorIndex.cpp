@@ -0,0 +1,148 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerWorldActorIndex.h"
+
+#include "OutlinerShortcutsStats.h"
+
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+
+FSceneOutlinerWorldActorIndex* FSceneOutlinerWorldActorIndex::Instance = nullptr;
+
+void FSceneOutlinerWorldActorIndex::OnStartupModule()
+{
+	Instance = this;
+	OnMapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32) { MarkDirty(); });
+	// Streaming a level in or out changes the actors of the world without an actor event for each of them
+	OnLevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FSceneOutlinerWorldActorIndex::OnLevelAddedOrRemoved);
+	OnLevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FSceneOutlinerWorldActorIndex::OnLevelAddedOrRemoved);
+}
+
+void FSceneOutlinerWorldActorIndex::OnShutdownModule()
+{
+	FEditorDelegates::MapChange.Remove(OnMapChangeHandle);
+	OnMapChangeHandle.Reset();
+	FWorldDelegates::LevelAddedToWorld.Remove(OnLevelAddedToWorldHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(OnLevelRemovedFromWorldHandle);
+	OnLevelAddedToWorldHandle.Reset();
+	OnLevelRemovedFromWorldHandle.Reset();
+	UnbindActorEvents();
+	Listeners.Empty();
+	IndexedWorld.Reset();
+
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+FSceneOutlinerWorldActorIndex* FSceneOutlinerWorldActorIndex::Get()
+{
+	return Instance;
+}
+
+void FSceneOutlinerWorldActorIndex::AddListener(IListener& Listener)
+{
+	Listeners.AddUnique(&Listener);
+	// The new listener has to see every actor of the world
+	MarkDirty();
+}
+
+void FSceneOutlinerWorldActorIndex::RemoveListener(IListener& Listener)
+{
+	Listeners.Remove(&Listener);
+}
+
+void FSceneOutlinerWorldActorIndex::BuildIfNeeded(UWorld* World)
+{
+	if (!bIsDirty && IndexedWorld.Get() == World)
+	{
+		return;
+	}
+
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(BuildWorldActorIndex);
+	IndexedWorld = World;
+	bIsDirty = false;
+	for (IListener* Listener : Listeners)
+	{
+		Listener->OnIndexReset(World);
+	}
+	if (!World)
+	{
+		return;
+	}
+
+	int32 NumActors = 0;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		for (IListener* Listener : Listeners)
+		{
+			Listener->OnIndexActorAdded(**It);
+		}
+		++NumActors;
+	}
+	OUTLINER_SHORTCUTS_INC_COUNTER(ItemsVisited, NumActors);
+	OUTLINER_SHORTCUTS_LOG_D("Indexed %d actors for %d indices", NumActors, Listeners.Num());
+
+	// Only listened to once built, the actors added before are found by the build
+	BindActorEvents();
+}
+
+void FSceneOutlinerWorldActorIndex::BindActorEvents()
+{
+	if (OnLevelActorAddedHandle.IsValid() || !GEngine)
+	{
+		return;
+	}
+	OnLevelActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FSceneOutlinerWorldActorIndex::OnLevelActorAdded);
+	OnLevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FSceneOutlinerWorldActorIndex::OnLevelActorDeleted);
+	OnLevelActorListChangedHandle = GEngine->OnLevelActorListChanged().AddRaw(this, &FSceneOutlinerWorldActorIndex::OnLevelActorListChanged);
+}
+
+void FSceneOutlinerWorldActorIndex::UnbindActorEvents()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(OnLevelActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(OnLevelActorDeletedHandle);
+		GEngine->OnLevelActorListChanged().Remove(OnLevelActorListChangedHandle);
+	}
+	OnLevelActorAddedHandle.Reset();
+	OnLevelActorDeletedHandle.Reset();
+	OnLevelActorListChangedHandle.Reset();
+}
+
+void FSceneOutlinerWorldActorIndex::OnLevelActorAdded(AActor* Actor)
+{
+	if (bIsDirty || !Actor || Actor->GetWorld() != IndexedWorld.Get())
+	{
+		return;
+	}
+	for (IListener* Listener : Listeners)
+	{
+		Listener->OnIndexActorAdded(*Actor);
+	}
+}
+
+void FSceneOutlinerWorldActorIndex::OnLevelActorDeleted(AActor* Actor)
+{
+	if (bIsDirty || !Actor)
+	{
+		return;
+	}
+	for (IListener* Listener : Listeners)
+	{
+		Listener->OnIndexActorDeleted(*Actor);
+	}
+}
+
+void FSceneOutlinerWorldActorIndex::OnLevelAddedOrRemoved(ULevel* Level, UWorld* World)
+{
+	if (World && World == IndexedWorld.Get())
+	{
+		MarkDirty();
+	}
+}
@@ -0,0 +1,59 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "OutlinerShortcutsBenchmark.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Arguments of the benchmark run by the test, the 100k actors scenario takes minutes and is left to the console command
+	const TCHAR* BenchmarkTestArgs = TEXT("Actors=1000,10000 Iterations=3");
+}
+
+// Waits for the benchmark to time every command, then reports its regressions as errors of the test
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FWaitForOutlinerShortcutsBenchmark, FAutomationTestBase*, Test);
+
+bool FWaitForOutlinerShortcutsBenchmark::Update()
+{
+	const FOutlinerShortcutsBenchmark* Benchmark = FOutlinerShortcutsBenchmark::Get();
+	if (Benchmark && Benchmark->IsRunning())
+	{
+		return false;
+	}
+
+	if (!Benchmark || Benchmark->WasStopped())
+	{
+		Test->AddError(TEXT("The benchmark was stopped before timing every command, see the log"));
+	}
+	else if (Benchmark->GetNumRegressions() > 0)
+	{
+		Test->AddError(FString::Printf(TEXT("%d commands are slower than the baseline, see the log"), Benchmark->GetNumRegressions()));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOutlinerShortcutsBenchmarkTest, "OutlinerShortcuts.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FOutlinerShortcutsBenchmarkTest::RunTest(const FString& Parameters)
+{
+	FOutlinerShortcutsBenchmark* Benchmark = FOutlinerShortcutsBenchmark::Get();
+	if (!TestNotNull(TEXT("Benchmark"), Benchmark))
+	{
+		return false;
+	}
+
+	TArray<FString> Args;
+	FString(BenchmarkTestArgs).ParseIntoArrayWS(Args);
+	if (!Benchmark->Start(Args))
+	{
+		AddError(TEXT("The benchmark did not start, see the log"));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForOutlinerShortcutsBenchmark(this));
+	return true;
+}
+
+#endif
@@ -0,0 +1,117 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerHierarchyIndex.h"
+
+#include "SSceneOutliner.h"
+#include "ISceneOutlinerHierarchy.h"
+#include "Engine/Note.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Long enough for the Outliner to tick and rebuild its hierarchy
+	constexpr float RefreshWaitSeconds = 0.5f;
+
+	// Shared by the latent commands of a test, which only run once the test function returned
+	struct FHierarchyIndexTestState
+	{
+		TWeakPtr<SSceneOutliner> Outliner;
+		TWeakObjectPtr<AActor> SpawnedActor;
+		FDelegateHandle OnOutlinerHierarchyChangedHandle;
+		// The actor is added to the hierarchy while it is spawned, before it is known
+		TSet<FSceneOutlinerTreeItemID> AddedIDs;
+	};
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FFullRefreshOutlinerCommand, TSharedRef<FHierarchyIndexTestState>, State);
+
+bool FFullRefreshOutlinerCommand::Update()
+{
+	if (const TSharedPtr<SSceneOutliner> SOutliner = State->Outliner.Pin())
+	{
+		SOutliner->FullRefresh();
+	}
+	return true;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FSpawnTestActorCommand, TSharedRef<FHierarchyIndexTestState>, State);
+
+bool FSpawnTestActorCommand::Update()
+{
+	if (UWorld* World = FOutlinerShortcutsEditorModule::GetCurrentEditorWorld())
+	{
+		State->SpawnedActor = World->SpawnActor<ANote>();
+	}
+	return true;
+}
+
+// Checks that the Added event of the spawned actor went through the index, then cleans up
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FCheckAddedEventCommand, FAutomationTestBase*, Test, TSharedRef<FHierarchyIndexTestState>, State);
+
+bool FCheckAddedEventCommand::Update()
+{
+	const AActor* SpawnedActor = State->SpawnedActor.Get();
+	if (Test->TestNotNull(TEXT("Spawned actor"), SpawnedActor))
+	{
+		Test->TestTrue(TEXT("The Added event of the actor was received after two full refreshes"), State->AddedIDs.Contains(FSceneOutlinerTreeItemID(SpawnedActor)));
+	}
+
+	if (FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get())
+	{
+		HierarchyIndex->OnOutlinerHierarchyChanged().Remove(State->OnOutlinerHierarchyChangedHandle);
+	}
+	if (AActor* Actor = State->SpawnedActor.Get())
+	{
+		Actor->GetWorld()->EditorDestroyActor(Actor, false);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerHierarchyIndexRefreshTest, "OutlinerShortcuts.HierarchyIndex.TwoFullRefreshes", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSceneOutlinerHierarchyIndexRefreshTest::RunTest(const FString& Parameters)
+{
+	FSceneOutlinerHierarchyIndex* HierarchyIndex = FSceneOutlinerHierarchyIndex::Get();
+	SSceneOutliner* SOutliner = FOutlinerShortcutsEditorModule::GetSSceneOutliner();
+	if (!TestNotNull(TEXT("Hierarchy index"), HierarchyIndex) || !SOutliner || !FOutlinerShortcutsEditorModule::GetCurrentEditorWorld())
+	{
+		AddWarning(TEXT("No Outliner or editor world opened, nothing to test"));
+		return true;
+	}
+
+	const TSharedRef<FHierarchyIndexTestState> State = MakeShared<FHierarchyIndexTestState>();
+	State->Outliner = StaticCastSharedRef<SSceneOutliner>(SOutliner->AsShared());
+	HierarchyIndex->TrackOutliner(SOutliner);
+
+	State->OnOutlinerHierarchyChangedHandle = HierarchyIndex->OnOutlinerHierarchyChanged().AddLambda([TestState = State](SSceneOutliner* ChangedOutliner, const FSceneOutlinerHierarchyChangedData& Data)
+		{
+			if (ChangedOutliner != TestState->Outliner.Pin().Get() || Data.Type != FSceneOutlinerHierarchyChangedData::Added)
+			{
+				return;
+			}
+			for (const FSceneOutlinerTreeItemPtr& Item : Data.Items)
+			{
+				if (Item)
+				{
+					TestState->AddedIDs.Add(Item->GetID());
+				}
+			}
+			TestState->AddedIDs.Append(Data.ItemIDs);
+		});
+
+	// Each full refresh replaces the hierarchy of the Outliner, the index has to follow both
+	ADD_LATENT_AUTOMATION_COMMAND(FFullRefreshOutlinerCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(RefreshWaitSeconds));
+	ADD_LATENT_AUTOMATION_COMMAND(FFullRefreshOutlinerCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(RefreshWaitSeconds));
+	ADD_LATENT_AUTOMATION_COMMAND(FSpawnTestActorCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(RefreshWaitSeconds));
+	ADD_LATENT_AUTOMATION_COMMAND(FCheckAddedEventCommand(this, State));
+	return true;
+}
+
+#endif
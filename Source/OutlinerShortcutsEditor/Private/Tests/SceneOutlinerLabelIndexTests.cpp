@@ -0,0 +1,65 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerLabelIndex.h"
+
+#include "Engine/Note.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	bool ContainsActor(const TArray<FSceneOutlinerLabelIndex::FResult>& Results, const AActor* Actor)
+	{
+		return Results.ContainsByPredicate([Actor](const FSceneOutlinerLabelIndex::FResult& Result) { return Result.Actor.Get() == Actor; });
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerLabelIndexRenameTest, "OutlinerShortcuts.LabelIndex.Rename", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSceneOutlinerLabelIndexRenameTest::RunTest(const FString& Parameters)
+{
+	FSceneOutlinerLabelIndex* LabelIndex = FSceneOutlinerLabelIndex::Get();
+	UWorld* World = FOutlinerShortcutsEditorModule::GetCurrentEditorWorld();
+	if (!TestNotNull(TEXT("Label index"), LabelIndex) || !World)
+	{
+		AddWarning(TEXT("No editor world opened, nothing to test"));
+		return true;
+	}
+
+	// Built first, so the actor comes from the actor events and not from the walk of the world
+	LabelIndex->BuildIfNeeded();
+	ANote* Actor = World->SpawnActor<ANote>();
+	if (!TestNotNull(TEXT("Spawned actor"), Actor))
+	{
+		return false;
+	}
+
+	const FString OldLabel = TEXT("OutlinerShortcutsLabelTestBefore");
+	const FString NewLabel = TEXT("OutlinerShortcutsLabelTestAfter");
+	TArray<FSceneOutlinerLabelIndex::FResult> Results;
+
+	Actor->SetActorLabel(OldLabel);
+	LabelIndex->Find(OldLabel, 10, Results);
+	TestTrue(TEXT("The spawned actor is found by its label"), ContainsActor(Results, Actor));
+
+	Actor->SetActorLabel(NewLabel);
+	Results.Reset();
+	LabelIndex->Find(OldLabel, 10, Results);
+	TestFalse(TEXT("The renamed actor is not found by its old label"), ContainsActor(Results, Actor));
+	Results.Reset();
+	LabelIndex->Find(NewLabel, 10, Results);
+	TestTrue(TEXT("The renamed actor is found by its new label"), ContainsActor(Results, Actor));
+	Results.Reset();
+	LabelIndex->Find(TEXT("TestAft"), 10, Results);
+	TestTrue(TEXT("The renamed actor is found by a part of its new label"), ContainsActor(Results, Actor));
+
+	World->EditorDestroyActor(Actor, false);
+	Results.Reset();
+	LabelIndex->Find(NewLabel, 10, Results);
+	TestFalse(TEXT("The destroyed actor is not found anymore"), ContainsActor(Results, Actor));
+	return true;
+}
+
+#endif
@@ -0,0 +1,273 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#include "SceneOutlinerTreeModel.h"
+#include "SceneOutlinerTreePolicies.h"
+#include "SceneOutlinerExpansionFrontier.h"
+#include "FolderPathMatcher.h"
+
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/**
+	 * Small tree shaped like the Outliner of a map:
+	 *	World
+	 *		Lighting/			Sky, Sun
+	 *			Lighting/Fill/	Fill
+	 *		Gameplay/
+	 *			Gameplay/Spawners/	Spawner
+	 *		Floor
+	 */
+	struct FTestTree
+	{
+		FSceneOutlinerMemoryTreeModel Model;
+		int32 World = INDEX_NONE;
+		int32 Lighting = INDEX_NONE;
+		int32 Fill = INDEX_NONE;
+		int32 Gameplay = INDEX_NONE;
+		int32 Spawners = INDEX_NONE;
+		int32 Floor = INDEX_NONE;
+
+		FTestTree()
+		{
+			World = Model.AddItem(INDEX_NONE);
+			Lighting = Model.AddItem(World, TEXT("Lighting"));
+			Model.AddItem(Lighting);
+			Model.AddItem(Lighting);
+			Fill = Model.AddItem(Lighting, TEXT("Lighting/Fill"));
+			Model.AddItem(Fill);
+			Gameplay = Model.AddItem(World, TEXT("Gameplay"));
+			Spawners = Model.AddItem(Gameplay, TEXT("Gameplay/Spawners"));
+			Model.AddItem(Spawners);
+			Floor = Model.AddItem(World);
+		}
+
+		// Items with children, in the order they were added
+		TArray<int32> GetParents() const { return { World, Lighting, Fill, Gameplay, Spawners }; }
+
+		int32 NumExpanded() const
+		{
+			int32 Num = 0;
+			for (int32 Item = 0; Item < Model.Num(); ++Item)
+			{
+				Num += Model.IsExpanded(Item) ? 1 : 0;
+			}
+			return Num;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerMemoryTreeModelStructureTest, "OutlinerShortcuts.TreeModel.Structure", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSceneOutlinerMemoryTreeModelStructureTest::RunTest(const FString& Parameters)
+{
+	FTestTree Tree;
+	FSceneOutlinerMemoryTreeModel& Model = Tree.Model;
+
+	TArray<int32> Items;
+	Model.GetRootItems(Items);
+	TestEqual(TEXT("Roots"), Items, TArray<int32>({ Tree.World }));
+
+	Items.Reset();
+	Model.GetChildren(Tree.World, Items);
+	TestEqual(TEXT("Children are listed in the order they were added"), Items, TArray<int32>({ Tree.Lighting, Tree.Gameplay, Tree.Floor }));
+	TestEqual(TEXT("Parent"), Model.GetParent(Tree.Fill), Tree.Lighting);
+	TestEqual(TEXT("Depth"), FSceneOutlinerTreePolicies::GetDepth(Model, Tree.Spawners), 2);
+	TestFalse(TEXT("Leaves have no children"), Model.HasChildren(Tree.Floor));
+	TestEqual(TEXT("Folder path"), Model.GetFolderPath(Tree.Fill), FName(TEXT("Lighting/Fill")));
+	TestTrue(TEXT("Actors have no folder path"), Model.GetFolderPath(Tree.Floor).IsNone());
+
+	Model.SetExpanded(Tree.Lighting, true);
+	const TSharedRef<FSceneOutlinerMemoryTreeModel> Captured = FSceneOutlinerMemoryTreeModel::Capture(Model);
+	TestEqual(TEXT("Captured items"), Captured->Num(), Model.Num());
+
+	// Capture goes breadth first, so the items are found back from their folder paths
+	int32 CapturedLighting = INDEX_NONE;
+	int32 NumFolders = 0;
+	for (int32 Item = 0; Item < Captured->Num(); ++Item)
+	{
+		const FName FolderPath = Captured->GetFolderPath(Item);
+		NumFolders += FolderPath.IsNone() ? 0 : 1;
+		if (FolderPath == FName(TEXT("Lighting")))
+		{
+			CapturedLighting = Item;
+		}
+	}
+	TestEqual(TEXT("Captured folders"), NumFolders, 4);
+	TestTrue(TEXT("Captured expansion"), CapturedLighting != INDEX_NONE && Captured->IsExpanded(CapturedLighting));
+	TestEqual(TEXT("Captured expanded items"), Captured->GetExpansion().CountSetBits(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerMemoryTreeModelSerializeTest, "OutlinerShortcuts.TreeModel.Serialize", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSceneOutlinerMemoryTreeModelSerializeTest::RunTest(const FString& Parameters)
+{
+	FTestTree Tree;
+	Tree.Model.SetExpanded(Tree.World, true);
+	Tree.Model.SetExpanded(Tree.Fill, true);
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	Tree.Model.Serialize(Writer);
+
+	FSceneOutlinerMemoryTreeModel Loaded;
+	FMemoryReader Reader(Data);
+	Loaded.Serialize(Reader);
+	TestFalse(TEXT("Loaded without error"), Reader.IsError());
+	TestEqual(TEXT("Loaded items"), Loaded.Num(), Tree.Model.Num());
+	TestTrue(TEXT("Loaded expansion"), Loaded.GetExpansion() == Tree.Model.GetExpansion());
+	for (int32 Item = 0; Item < Loaded.Num(); ++Item)
+	{
+		TestEqual(TEXT("Loaded parent"), Loaded.GetParent(Item), Tree.Model.GetParent(Item));
+		TestEqual(TEXT("Loaded folder path"), Loaded.GetFolderPath(Item), Tree.Model.GetFolderPath(Item));
+	}
+
+	TArray<int32> Children;
+	Loaded.GetChildren(Tree.World, Children);
+	TestEqual(TEXT("Children are linked back"), Children, TArray<int32>({ Tree.Lighting, Tree.Gameplay, Tree.Floor }));
+
+	// Anything else than a saved tree is refused
+	TArray<uint8> Garbage = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	FSceneOutlinerMemoryTreeModel Refused;
+	FMemoryReader GarbageReader(Garbage);
+	Refused.Serialize(GarbageReader);
+	TestTrue(TEXT("Garbage is an error"), GarbageReader.IsError());
+	TestEqual(TEXT("Nothing loaded from garbage"), Refused.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerTreePoliciesCollapseExpandTest, "OutlinerShortcuts.TreeModel.CollapseAndExpandAll", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSceneOutlinerTreePoliciesCollapseExpandTest::RunTest(const FString& Parameters)
+{
+	FTestTree Tree;
+
+	FSceneOutlinerTreePolicies::ExpandAll(Tree.Model);
+	for (const int32 Item : Tree.GetParents())
+	{
+		TestTrue(TEXT("Items with children are expanded"), Tree.Model.IsExpanded(Item));
+	}
+	TestEqual(TEXT("Leaves are not expanded"), Tree.NumExpanded(), Tree.GetParents().Num());
+
+	FSceneOutlinerTreePolicies::CollapseToRoot(Tree.Model);
+	TestTrue(TEXT("Root stays expanded"), Tree.Model.IsExpanded(Tree.World));
+	TestEqual(TEXT("Only the root is expanded, hidden items included"), Tree.NumExpanded(), 1);
+
+	FSceneOutlinerTreePolicies::CollapseAll(Tree.Model);
+	TestEqual(TEXT("Everything is collapsed"), Tree.NumExpanded(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerExpansionFrontierTest, "OutlinerShortcuts.TreeModel.ExpandToDepth", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSceneOutlinerExpansionFrontierTest::RunTest(const FString& Parameters)
+{
+	FTestTree Tree;
+	FSceneOutlinerTreePolicies::ExpandAll(Tree.Model);
+
+	FSceneOutlinerTreePolicies::ExpandToDepth(Tree.Model, 2);
+	TestTrue(TEXT("Depth 0 expanded"), Tree.Model.IsExpanded(Tree.World));
+	TestTrue(TEXT("Depth 1 expanded"), Tree.Model.IsExpanded(Tree.Lighting) && Tree.Model.IsExpanded(Tree.Gameplay));
+	TestFalse(TEXT("Depth 2 collapsed"), Tree.Model.IsExpanded(Tree.Fill) || Tree.Model.IsExpanded(Tree.Spawners));
+
+	// The frontier kept across calls steps one level at a time
+	FSceneOutlinerExpansionFrontier Frontier;
+	Frontier.ExpandToDepth(Tree.Model, 1);
+	TestEqual(TEXT("Depth tracked"), Frontier.GetDepth(), 1);
+	TestEqual(TEXT("Only the root expanded"), Tree.NumExpanded(), 1);
+
+	TestTrue(TEXT("Expand one level"), Frontier.ExpandOneLevel(Tree.Model));
+	TestEqual(TEXT("Two levels expanded"), Tree.NumExpanded(), 3);
+	TestTrue(TEXT("Expand one more level"), Frontier.ExpandOneLevel(Tree.Model));
+	TestEqual(TEXT("Fully expanded"), Tree.NumExpanded(), Tree.GetParents().Num());
+	TestFalse(TEXT("Nothing left to expand"), Frontier.ExpandOneLevel(Tree.Model));
+
+	TestTrue(TEXT("Collapse one level"), Frontier.CollapseOneLevel(Tree.Model));
+	TestEqual(TEXT("Two levels left"), Tree.NumExpanded(), 3);
+
+	// An item collapsed by hand invalidates the levels, the next step starts over from the visible depth
+	Tree.Model.SetExpanded(Tree.Gameplay, false);
+	TestTrue(TEXT("Expand after a change by hand"), Frontier.ExpandOneLevel(Tree.Model));
+	TestTrue(TEXT("Collapsed item expanded back"), Tree.Model.IsExpanded(Tree.Gameplay));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerExpansionFrontierUpdateTest, "OutlinerShortcuts.TreeModel.FrontierUpdateItems", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSceneOutlinerExpansionFrontierUpdateTest::RunTest(const FString& Parameters)
+{
+	FTestTree Tree;
+	FSceneOutlinerExpansionFrontier Frontier;
+	Frontier.ExpandToDepth(Tree.Model, 2);
+
+	// Attaching an actor to Floor gives it children above the tracked depth
+	const int32 Attached = Tree.Model.AddItem(Tree.Floor);
+	Frontier.UpdateItems(Tree.Model, { Attached });
+	TestTrue(TEXT("Levels kept"), Frontier.IsValid());
+	TestTrue(TEXT("New parent expanded"), Tree.Model.IsExpanded(Tree.Floor));
+
+	// A new folder at the tracked depth joins the frontier, collapsed
+	const int32 Sky = Tree.Model.AddItem(Tree.Lighting, TEXT("Lighting/Sky"), true);
+	const int32 Clouds = Tree.Model.AddItem(Sky);
+	Frontier.UpdateItems(Tree.Model, { Sky, Clouds });
+	TestFalse(TEXT("New folder collapsed"), Tree.Model.IsExpanded(Sky));
+
+	TestTrue(TEXT("Expand one level"), Frontier.ExpandOneLevel(Tree.Model));
+	TestTrue(TEXT("New folder expanded with its level"), Tree.Model.IsExpanded(Sky));
+
+	Frontier.CollapseOneLevel(Tree.Model);
+	Frontier.CollapseOneLevel(Tree.Model);
+	TestFalse(TEXT("New parent collapsed with its level"), Tree.Model.IsExpanded(Tree.Floor));
+	TestEqual(TEXT("Only the root expanded"), Tree.NumExpanded(), 1);
+
+	// Removed items are dropped from the levels
+	Frontier.RemoveItems({ Tree.Lighting });
+	Frontier.ExpandOneLevel(Tree.Model);
+	TestFalse(TEXT("Removed item not expanded"), Tree.Model.IsExpanded(Tree.Lighting));
+	TestTrue(TEXT("Other items expanded"), Tree.Model.IsExpanded(Tree.Gameplay) && Tree.Model.IsExpanded(Tree.Floor));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerTreePoliciesMatchingFoldersTest, "OutlinerShortcuts.TreeModel.ExpandMatchingFolders", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSceneOutlinerTreePoliciesMatchingFoldersTest::RunTest(const FString& Parameters)
+{
+	FTestTree Tree;
+	FSceneOutlinerTreePolicies::ExpandAll(Tree.Model);
+
+	FFolderPathMatcher Matcher;
+	Matcher.Compile({ TEXT("Lighting/**"), TEXT("!Lighting/Fill") });
+	FSceneOutlinerTreePolicies::ExpandMatchingFolders(Tree.Model, Matcher);
+	TestTrue(TEXT("Matched folder expanded"), Tree.Model.IsExpanded(Tree.Lighting));
+	TestFalse(TEXT("Excluded folder collapsed"), Tree.Model.IsExpanded(Tree.Fill));
+	TestFalse(TEXT("Other folders collapsed"), Tree.Model.IsExpanded(Tree.Gameplay) || Tree.Model.IsExpanded(Tree.Spawners));
+
+	Matcher.Compile({ TEXT("**/Spawners") });
+	FSceneOutlinerTreePolicies::ExpandMatchingFolders(Tree.Model, Matcher);
+	TestTrue(TEXT("Deep folder and its parents expanded"), Tree.Model.IsExpanded(Tree.Spawners) && Tree.Model.IsExpanded(Tree.Gameplay) && Tree.Model.IsExpanded(Tree.World));
+	TestFalse(TEXT("Previous match collapsed"), Tree.Model.IsExpanded(Tree.Lighting));
+
+	Matcher.Compile({});
+	FSceneOutlinerTreePolicies::ExpandMatchingFolders(Tree.Model, Matcher);
+	TestEqual(TEXT("No pattern collapses to root"), Tree.NumExpanded(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneOutlinerTreePoliciesSubtreesTest, "OutlinerShortcuts.TreeModel.SetSubtreesExpansion", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSceneOutlinerTreePoliciesSubtreesTest::RunTest(const FString& Parameters)
+{
+	FTestTree Tree;
+
+	// Fill is under Lighting, its subtree is only walked once
+	const int32 NumVisited = FSceneOutlinerTreePolicies::SetSubtreesExpansion(Tree.Model, { Tree.Lighting, Tree.Fill }, true);
+	TestEqual(TEXT("Items visited"), NumVisited, 5);
+	TestTrue(TEXT("Subtree expanded"), Tree.Model.IsExpanded(Tree.Lighting) && Tree.Model.IsExpanded(Tree.Fill));
+	TestFalse(TEXT("Rest of the tree untouched"), Tree.Model.IsExpanded(Tree.World) || Tree.Model.IsExpanded(Tree.Gameplay));
+
+	FSceneOutlinerTreePolicies::ExpandAll(Tree.Model);
+	FSceneOutlinerTreePolicies::SetSubtreesExpansion(Tree.Model, { Tree.Gameplay }, false);
+	TestFalse(TEXT("Hidden items collapsed too"), Tree.Model.IsExpanded(Tree.Gameplay) || Tree.Model.IsExpanded(Tree.Spawners));
+	TestTrue(TEXT("Siblings untouched"), Tree.Model.IsExpanded(Tree.Lighting) && Tree.Model.IsExpanded(Tree.Fill));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,65 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Matches folder paths against a list of glob patterns, compiled once into a trie of path segments.
+ *
+ * Patterns are relative to the root of the Outliner and made of `/` separated segments:
+ *	`Lighting`				the folder `Lighting`
+ *	`Lighting/*`			the direct sub folders of `Lighting`
+ *	`Lighting/**`			`Lighting` and all its sub folders
+ *	`**\/Spawn?rs_*`		any folder named like `Spawners_Red`, at any depth. `*` and `?` can be used inside a segment
+ *	`!Gameplay/Spawners/*`	excludes the folders matched, a `!` pattern only excludes what the patterns above it included
+ * The last pattern matching a folder decides if it is included or excluded. Matching is case insensitive.
+ *
+ * A path is matched one segment at a time, from the states of its parent folder: walking a folder tree costs one step per folder,
+ * and a folder without states can't have matching sub folders, so its children don't need to be visited.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FFolderPathMatcher
+{
+public:
+	// Indices of the trie nodes reached by a path
+	using FStates = TArray<int32, TInlineAllocator<8>>;
+
+	// Builds the trie from the patterns. Empty lines and lines starting with `#` are ignored.
+	void Compile(const TArray<FString>& Patterns);
+	bool IsEmpty() const { return NumPatterns == 0; }
+
+	// States of the root, before any segment
+	FStates GetInitialStates() const;
+	// States reached from `States` through a folder named `Segment`
+	FStates Step(const FStates& States, FStringView Segment) const;
+	// True if the last pattern matching the states is an include pattern
+	bool IsMatch(const FStates& States) const;
+
+	// Matches a full path, ex: `Lighting/Sky`
+	bool Matches(FStringView FolderPath) const;
+	// Returns the states of a folder from the states of its parent folder, looked up in or added to `CachedStates`.
+	// Walking a flat list of folders costs one step per folder this way, the parents being shared by their sub folders.
+	const FStates& GetFolderStates(FName FolderPath, TMap<FName, FStates>& CachedStates) const;
+
+private:
+	struct FNode
+	{
+		TMap<FName, int32> Literals;
+		TArray<TPair<FString, int32>> Wildcards;
+		// `*`
+		int32 AnySegment = INDEX_NONE;
+		// `**`
+		int32 AnyDepth = INDEX_NONE;
+		bool bIsAnyDepth = false;
+		// Index of the last include and exclude patterns ending on this node
+		int32 IncludePattern = INDEX_NONE;
+		int32 ExcludePattern = INDEX_NONE;
+	};
+
+	int32 AddChild(int32 Parent, const FString& Segment);
+	// Adds the `**` nodes reachable without consuming any segment
+	void AddClosure(FStates& States, int32 Node) const;
+
+	TArray<FNode> Nodes;
+	int32 NumPatterns = 0;
+};
@@ -0,0 +1,125 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "Containers/Ticker.h"
+
+class IConsoleObject;
+class AActor;
+class SDockTab;
+
+/**
+ * Benchmarks the Outliner commands on synthetic maps, registered as the `OutlinerShortcuts.Benchmark` console command.
+ *
+ * For each actor count, a blank map is filled with actors spread in a tree of folders and attachment chains, then every command
+ * and the map open path are timed once the Outliner is populated. Results are written as CSV in `Saved/OutlinerShortcuts/Benchmarks/`
+ * and compared to a baseline, the median of a command being a regression when it exceeds the baseline by more than the threshold.
+ * Commands only flag the Outliners for refresh, so each command is timed twice: until it returns, and until the Outliners rebuilt their rows
+ * on the following ticks. The second one is rounded up to the frame it completes in.
+ * From UE 5.1, a second Outliner is opened while the benchmark runs if there is only one, for the commands updating several Outliners.
+ *
+ * Arguments (all optional):
+ *	Actors=1000,10000,100000	Actor counts, one synthetic map each
+ *	FolderDepth=3				Depth of the folder tree
+ *	FolderFanOut=4				Sub folders per folder
+ *	AttachmentDepth=2			Length of the attachment chains under each top level actor
+ *	Iterations=5				Runs of each command
+ *	Threshold=0.2				Allowed slowdown against the baseline, as a fraction of the baseline
+ *	Baseline=<Path>				Baseline to compare against, `Baseline.csv` next to the results by default
+ *	-SaveBaseline				Also writes the results as the new baseline
+ *	-Force						Runs even if the current map has unsaved changes, which are lost
+ *	-Quit						Exits the editor when done, with a non zero code if a regression was found
+ *
+ * Example, headless: `UnrealEditor <Project> -nullrhi -unattended -ExecCmds="OutlinerShortcuts.Benchmark Actors=1000,10000 -Quit"`
+ *
+ * The hierarchy of a real map can also be captured and replayed without Slate nor the map, see `FSceneOutlinerMemoryTreeModel`:
+ *	OutlinerShortcuts.CaptureTree [File=<Path>]				Saves the tree of the most recently used Outliner, in `Saved/OutlinerShortcuts/Trees/` by default
+ *	OutlinerShortcuts.ReplayTree <Path> [Iterations=5] [-Quit]	Times the expansion policies of `FSceneOutlinerTreePolicies` on a saved tree
+ */
+class OUTLINERSHORTCUTSEDITOR_API FOutlinerShortcutsBenchmark : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the benchmark registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FOutlinerShortcutsBenchmark* Get();
+
+	// Starts the benchmark with the arguments of the console command, it then runs on the following ticks. Returns false if it could not start.
+	bool Start(const TArray<FString>& Args);
+	bool IsRunning() const { return TickHandle.IsValid(); }
+	// Number of commands slower than the baseline in the last run, once it is done
+	int32 GetNumRegressions() const { return NumRegressions; }
+	// True if the last run was stopped before timing every command, ex: when the Outliner was not populated in time
+	bool WasStopped() const { return bWasStopped; }
+
+private:
+	struct FScenario
+	{
+		int32 NumActors = 1000;
+		int32 FolderDepth = 3;
+		int32 FolderFanOut = 4;
+		int32 AttachmentDepth = 2;
+
+		FString GetName() const;
+	};
+
+	struct FResult
+	{
+		FString Scenario;
+		FScenario Settings;
+		FString Command;
+		TArray<double> SamplesMs;
+		// Time until the Outliners were refreshed, the command included
+		TArray<double> RefreshedSamplesMs;
+
+		double GetMedianMs() const { return GetMedianMs(SamplesMs); }
+		static double GetMedianMs(const TArray<double>& Samples);
+	};
+
+	// A step of the benchmark, ticked until it returns true
+	using FStep = TFunction<bool()>;
+
+	bool Tick(float DeltaTime);
+	void Finish();
+
+	void AddScenarioSteps(const FScenario& Scenario);
+	void AddCommandSteps(const FScenario& Scenario, const FString& CommandName, TFunction<void()> Setup, TFunction<bool()> Command);
+
+	// Opens a blank map and fills it with the actors of the scenario
+	static void PopulateWorld(const FScenario& Scenario, TWeakObjectPtr<AActor>& OutLastActor);
+	void WriteResults() const;
+	// Returns the number of commands slower than the baseline
+	int32 CompareToBaseline(const FString& BaselineFilename) const;
+
+	static void CaptureTree(const TArray<FString>& Args);
+	static void ReplayTree(const TArray<FString>& Args);
+
+	TArray<FStep> Steps;
+	int32 CurrentStep = 0;
+	TArray<FResult> Results;
+
+	int32 Iterations = 5;
+	float Threshold = 0.2f;
+	FString BaselineFilename;
+	bool bSaveBaseline = false;
+	bool bQuitWhenDone = false;
+	bool bPreviousTimeSliceExpandAll = false;
+	TArray<FString> PreviousFolderExpansionPatterns;
+	TArray<TSoftClassPtr<AActor>> PreviousFocusedActorClasses;
+#if UE5_1_ONWARDS
+	// Outliner opened for the benchmark, closed when it finishes
+	TWeakPtr<SDockTab> OpenedOutlinerTab;
+#endif
+	int32 NumRegressions = 0;
+	bool bWasStopped = false;
+
+	FTSTicker::FDelegateHandle TickHandle;
+	IConsoleObject* BenchmarkCommand = nullptr;
+	IConsoleObject* CaptureTreeCommand = nullptr;
+	IConsoleObject* ReplayTreeCommand = nullptr;
+
+	static FOutlinerShortcutsBenchmark* Instance;
+};
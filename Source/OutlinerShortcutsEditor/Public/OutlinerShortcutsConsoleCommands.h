@@ -0,0 +1,41 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+
+class IConsoleObject;
+struct FOutlinerShortcutsOperation;
+
+/**
+ * Registers the console commands running the operations of `UOutlinerShortcutsLibrary`:
+ *	OutlinerShortcuts.CollapseAll [OutlinerId...]
+ *	OutlinerShortcuts.CollapseToRoot [OutlinerId...]
+ *	OutlinerShortcuts.ExpandAll [OutlinerId...]
+ *	OutlinerShortcuts.ExpandToDepth <Depth> [OutlinerId...]
+ *	OutlinerShortcuts.RestoreLastState [OutlinerId...]
+ *	OutlinerShortcuts.ExpandMatchingFolders [OutlinerId...]
+ *	OutlinerShortcuts.ExpandFocusedClasses [OutlinerId...]
+ *	OutlinerShortcuts.CollapseAllExceptFocusedClasses [OutlinerId...]
+ *	OutlinerShortcuts.Apply <Operation>... [Outliner=<OutlinerId>]...	ex: `OutlinerShortcuts.Apply CollapseAll ExpandToDepth=2`
+ *	OutlinerShortcuts.ListOutliners
+ *	OutlinerShortcuts.FindLabel <Query> [Max=<MaxResults>]		Times a lookup of `FSceneOutlinerLabelIndex`
+ */
+class OUTLINERSHORTCUTSEDITOR_API FOutlinerShortcutsConsoleCommands : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+private:
+	void RegisterOperationCommand(const TCHAR* Name, const TCHAR* Help, const FOutlinerShortcutsOperation& Operation);
+
+	static void ApplyOperations(const TArray<FOutlinerShortcutsOperation>& Operations, const TArray<FName>& OutlinerIds, FOutputDevice& Ar);
+	static void Apply(const TArray<FString>& Args, FOutputDevice& Ar);
+	static void ExpandToDepth(const TArray<FString>& Args, FOutputDevice& Ar);
+	static void ListOutliners(const TArray<FString>& Args, FOutputDevice& Ar);
+	static void FindLabel(const TArray<FString>& Args, FOutputDevice& Ar);
+
+	TArray<IConsoleObject*> ConsoleObjects;
+};
@@ -4,11 +4,28 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Templates/Function.h"
 
 #include "SceneOutlinerFwd.h"
 #include "OutlinerShortcutsEditorDefinitions.h"
 #include "Styling/AppStyle.h"
 
+class FSceneOutlinerExpansionFrontier;
+class ISceneOutlinerTreeModel;
+class FSceneOutlinerExpansionBatch;
+class FFolderPathMatcher;
+
+// Whether an Outliner has been populated, see `FOutlinerShortcutsEditorModule::GetSceneOutlinerReadiness`
+enum class ESceneOutlinerReadiness : uint8
+{
+	// The items of the Outliner are populated and can be expanded
+	Ready,
+	// The Outliner is still getting populated
+	Pending,
+	// The Outliner has no mode or hierarchy to populate it, it will never be ready
+	Unsupported,
+};
+
 class IModuleListenerInterface
 {
 public:
@@ -47,6 +64,28 @@ public:
 	static bool SceneOutlinerCollapseToRoot();
 	// Expand the most recently used Scene Outliner
 	static bool SceneOutlinerExpandAll();
+	// Restore the expansion state saved when the current map was last closed in the most recently used Scene Outliner, or collapse it to root
+	static bool SceneOutlinerRestoreLastState();
+	// Expand the most recently used Scene Outliner down to the given depth, collapsing the deeper items
+	static bool SceneOutlinerExpandToDepth(int32 Depth);
+	// Expand one more level of the most recently used Scene Outliner
+	static bool SceneOutlinerExpandOneLevel();
+	// Collapse the deepest expanded level of the most recently used Scene Outliner
+	static bool SceneOutlinerCollapseOneLevel();
+	// Collapse the most recently used Scene Outliner except the parents of the selected actors
+	static bool SceneOutlinerRevealSelection();
+	// Collapse the most recently used Scene Outliner except the folders matching `UOutlinerShortcutsEditorSettings::FolderExpansionPatterns` and their parents
+	static bool SceneOutlinerExpandMatchingFolders();
+	// Expand the parents of the actors of `UOutlinerShortcutsEditorSettings::FocusedActorClasses` in the most recently used Scene Outliner
+	static bool SceneOutlinerExpandFocusedClasses();
+	// Collapse the most recently used Scene Outliner except the parents of the actors of `UOutlinerShortcutsEditorSettings::FocusedActorClasses`
+	static bool SceneOutlinerCollapseAllExceptFocusedClasses();
+	// Expand the selected items and everything under them in the most recently used Scene Outliner
+	static bool SceneOutlinerExpandSelectedRecursively();
+	// Collapse the selected items and everything under them in the most recently used Scene Outliner
+	static bool SceneOutlinerCollapseSelectedRecursively();
+	// Open the Find and Reveal popup over the most recently used Scene Outliner
+	static bool SceneOutlinerFindAndReveal();
 
 #if UE5_1_ONWARDS
 	// [UE 5.1 Onwards] Collapse all the opened Scene Outliners
@@ -55,19 +94,51 @@ public:
 	static bool SceneOutlinerCollapseAllOutlinersToRoot();
 	// [UE 5.1 Onwards] Expand all the opened Scene Outliners
 	static bool SceneOutlinerExpandAllOutliners();
+	// [UE 5.1 Onwards] Restore the expansion state saved when the current map was last closed in all the opened Scene Outliners
+	static bool SceneOutlinerRestoreLastStateAllOutliners();
+	// [UE 5.1 Onwards] Expand only the folders matching the patterns of the settings in all the opened Scene Outliners
+	static bool SceneOutlinerExpandMatchingFoldersAllOutliners();
+	// [UE 5.1 Onwards] Copy the expansion of the most recently used Scene Outliner to the other opened ones, only changing the items that differ
+	static bool SceneOutlinerMirrorExpansion();
+	// [UE 5.1 Onwards] Start or stop mirroring the expansion changes of the most recently used Scene Outliner to the other opened ones
+	static bool SceneOutlinerToggleLiveExpansionMirror();
 #endif
 
+	// Returns true if `Expand All` should be spread over several frames, see `UOutlinerShortcutsEditorSettings::bTimeSliceExpandAll`
+	static bool ShouldTimeSliceExpandAll();
+	// Cancels the running time sliced expansion. Returns true if one was running.
+	static bool CancelTimeSlicedExpansion();
+
 	static ISceneOutliner* GetISceneOutliner();
 	static SSceneOutliner* GetSSceneOutliner();
 #if UE5_1_ONWARDS
-	static TArray<ISceneOutliner*> GetAllISceneOutliners();
-	static TArray<SSceneOutliner*> GetAllSSceneOutliners();
+	// [UE 5.1 Onwards] Returns all the opened Scene Outliners, from the most recently used to the least recently used
+	static TArray<TSharedRef<ISceneOutliner>> GetAllISceneOutliners();
+	static TArray<TSharedRef<SSceneOutliner>> GetAllSSceneOutliners();
 #endif
 
-	FORCEINLINE static UWorld* GetCurrentEditorWorld();
+	static UWorld* GetCurrentEditorWorld();
 	static FSceneOutlinerTreeItemPtr GetWorldTreeItemPtr(SSceneOutliner* SceneOutliner);
+	/**
+	 * Outliners showing the actors are ready once the item of the editor world is created. The other modes (Data Layers, custom modes...)
+	 * do not have a world item and are ready as soon as they have root items.
+	 */
+	static ESceneOutlinerReadiness GetSceneOutlinerReadiness(SSceneOutliner* SceneOutliner);
 	static bool IsSceneOutlinerReady(SSceneOutliner* SceneOutliner);
+	// Returns the most recently used Scene Outliner if it is ready, logging why otherwise
+	static SSceneOutliner* GetReadySSceneOutliner();
+	// Runs the function with the expansion frontier kept for the Outliner and the model its levels refer to, or with transient ones if the Outliner is not tracked.
+	// The changes of the model go through the batch.
+	static void WithExpansionFrontier(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, TFunctionRef<void(ISceneOutlinerTreeModel& /*Model*/, FSceneOutlinerExpansionFrontier& /*Frontier*/)> Function);
 	static TArray<FSceneOutlinerTreeItemPtr> GetSceneOutlinerRootItems(SSceneOutliner* SOutliner);
+	// Adds to the batch the changes collapsing the Outliner while keeping its root items expanded
+	static void CollapseToRoot(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner);
+	// Adds to the batch the changes collapsing the Outliner except its root items, the folders matched and their parents
+	static void ExpandMatchingFolders(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FFolderPathMatcher& Matcher);
+	// Adds to the batch the changes expanding the parents of the actors of the given classes, collapsing the other items if `bCollapseOthers`. Returns the number of actors found.
+	static int32 ExpandParentsOfClasses(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const TArray<UClass*>& Classes, bool bCollapseOthers);
+	// Adds to the batch the changes expanding or collapsing the selected items and everything under them. Returns the number of items visited.
+	static int32 SetSelectedSubtreesExpansion(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, bool bExpand);
 };
 
 class OUTLINERSHORTCUTSEDITOR_API OutlinerShortcutsCommands : public TCommands<OutlinerShortcutsCommands>
@@ -93,9 +164,22 @@ public:
 	TSharedPtr<FUICommandInfo> SceneOutlinerCollapseAll;
 	TSharedPtr<FUICommandInfo> SceneOutlinerCollapseToRoot;
 	TSharedPtr<FUICommandInfo> SceneOutlinerExpandAll;
+	TSharedPtr<FUICommandInfo> SceneOutlinerExpandToDepth;
+	TSharedPtr<FUICommandInfo> SceneOutlinerExpandOneLevel;
+	TSharedPtr<FUICommandInfo> SceneOutlinerCollapseOneLevel;
+	TSharedPtr<FUICommandInfo> SceneOutlinerRevealSelection;
+	TSharedPtr<FUICommandInfo> SceneOutlinerExpandMatchingFolders;
+	TSharedPtr<FUICommandInfo> SceneOutlinerExpandFocusedClasses;
+	TSharedPtr<FUICommandInfo> SceneOutlinerCollapseAllExceptFocusedClasses;
+	TSharedPtr<FUICommandInfo> SceneOutlinerExpandSelectedRecursively;
+	TSharedPtr<FUICommandInfo> SceneOutlinerCollapseSelectedRecursively;
+	TSharedPtr<FUICommandInfo> SceneOutlinerFindAndReveal;
 #if UE5_1_ONWARDS
 	TSharedPtr<FUICommandInfo> SceneOutlinerCollapseAllOutliners;
 	TSharedPtr<FUICommandInfo> SceneOutlinerCollapseAllOutlinersToRoot;
 	TSharedPtr<FUICommandInfo> SceneOutlinerExpandAllOutliners;
+	TSharedPtr<FUICommandInfo> SceneOutlinerExpandMatchingFoldersAllOutliners;
+	TSharedPtr<FUICommandInfo> SceneOutlinerMirrorExpansion;
+	TSharedPtr<FUICommandInfo> SceneOutlinerToggleLiveExpansionMirror;
 #endif
 };
\ No newline at end of file
@@ -10,7 +10,60 @@ DECLARE_LOG_CATEGORY_EXTERN(LogOutlinerShortcutsEditor, Log, All);
 #undef DEBUG_OUTLINER_SHORTCUTS
 #define DEBUG_OUTLINER_SHORTCUTS 0
 
+// Levels of the logging macros, see OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL
+#define OUTLINER_SHORTCUTS_LOG_LEVEL_VERBOSE 1
+#define OUTLINER_SHORTCUTS_LOG_LEVEL_DISPLAY 2
+#define OUTLINER_SHORTCUTS_LOG_LEVEL_WARNING 3
+#define OUTLINER_SHORTCUTS_LOG_LEVEL_ERROR 4
+#define OUTLINER_SHORTCUTS_LOG_LEVEL_NONE 5
+
+#ifndef OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL
+/**
+* @brief Lowest level of the logging macros compiled in. The macros below it expand to nothing, so their arguments are never formatted.
+* The editor is built in Development, which only keeps the Display level and above. Debug and DebugGame keep everything.
+* Can be set from the Build.cs with `PublicDefinitions.Add("OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL=4");`
+*/
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+#define OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL OUTLINER_SHORTCUTS_LOG_LEVEL_ERROR
+#elif UE_BUILD_DEVELOPMENT
+#define OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL OUTLINER_SHORTCUTS_LOG_LEVEL_DISPLAY
+#else
+#define OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL OUTLINER_SHORTCUTS_LOG_LEVEL_VERBOSE
+#endif
+#endif
 
+#ifndef OUTLINER_SHORTCUTS_LOG_RATE_LIMIT_SECONDS
+/**
+* @brief Minimum delay between two messages of the same rate limited call site (the `_RL` macros).
+*/
+#define OUTLINER_SHORTCUTS_LOG_RATE_LIMIT_SECONDS 5.0
+#endif
+
+/**
+ * State of one call site of the rate limited logging macros. Each call site holds a static instance.
+ * The messages arriving before the delay has elapsed are counted and reported with the next message, or at shutdown with `LogSummary`.
+ */
+struct OUTLINERSHORTCUTSEDITOR_API FOutlinerShortcutsLogLimiter
+{
+	FOutlinerShortcutsLogLimiter(const ANSICHAR* InFunction, int32 InLine);
+
+	// Returns true if the message can be logged, with the number of messages suppressed since the last one
+	bool ShouldLog(int32& OutNumSuppressed);
+
+	// Logs the messages still suppressed at every call site
+	static void LogSummary();
+
+private:
+	const ANSICHAR* Function;
+	int32 Line;
+	double NextAllowedTime = 0.;
+	int32 NumSuppressed = 0;
+	int32 TotalSuppressed = 0;
+	FOutlinerShortcutsLogLimiter* Next = nullptr;
+};
+
+
+#if OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL <= OUTLINER_SHORTCUTS_LOG_LEVEL_DISPLAY
 #ifndef OUTLINER_SHORTCUTS_LOG
 /**
 * @brief LOG. Calls UE_LOG(LogOutlinerShortcutsEditor, Display, ...).
@@ -40,8 +93,14 @@ DECLARE_LOG_CATEGORY_EXTERN(LogOutlinerShortcutsEditor, Log, All);
 #define OUTLINER_SHORTCUTS_LOG_D(Format, ...) {}
 #endif //DEBUG_OUTLINER_SHORTCUTS
 #endif
+#else // OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL > OUTLINER_SHORTCUTS_LOG_LEVEL_DISPLAY
+#define OUTLINER_SHORTCUTS_LOG(Format, ...) {}
+#define OUTLINER_SHORTCUTS_LOG_H(Format, ...) {}
+#define OUTLINER_SHORTCUTS_LOG_D(Format, ...) {}
+#endif
 
 
+#if OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL <= OUTLINER_SHORTCUTS_LOG_LEVEL_VERBOSE
 #ifndef OUTLINER_SHORTCUTS_LOGV
 /**
 * @brief LOG VERBOSE. Calls UE_LOG(LogOutlinerShortcutsEditor, Log, ...). 
@@ -57,7 +116,12 @@ DECLARE_LOG_CATEGORY_EXTERN(LogOutlinerShortcutsEditor, Log, All);
 #define OUTLINER_SHORTCUTS_LOGV_H(Format, ...) __OUTLINER_SHORTCUTS_LOGVH__(Format, ##__VA_ARGS__);
 #define __OUTLINER_SHORTCUTS_LOGVH__(Format, ...) UE_LOG(LogOutlinerShortcutsEditor, Log, TEXT("[%hs]  " Format), __FUNCTION__, ##__VA_ARGS__);
 #endif
+#else // OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL > OUTLINER_SHORTCUTS_LOG_LEVEL_VERBOSE
+#define OUTLINER_SHORTCUTS_LOGV(Format, ...) {}
+#define OUTLINER_SHORTCUTS_LOGV_H(Format, ...) {}
+#endif
 
+#if OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL <= OUTLINER_SHORTCUTS_LOG_LEVEL_WARNING
 #ifndef OUTLINER_SHORTCUTS_WARN
 /**
 * @brief WARN. Calls UE_LOG(LogOutlinerShortcutsEditor, Warning, ...). 
@@ -87,7 +151,13 @@ DECLARE_LOG_CATEGORY_EXTERN(LogOutlinerShortcutsEditor, Log, All);
 #define OUTLINER_SHORTCUTS_WARN_D(Format, ...) {}
 #endif //DEBUG_OUTLINER_SHORTCUTS
 #endif
+#else // OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL > OUTLINER_SHORTCUTS_LOG_LEVEL_WARNING
+#define OUTLINER_SHORTCUTS_WARN(Format, ...) {}
+#define OUTLINER_SHORTCUTS_WARN_H(Format, ...) {}
+#define OUTLINER_SHORTCUTS_WARN_D(Format, ...) {}
+#endif
 
+#if OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL <= OUTLINER_SHORTCUTS_LOG_LEVEL_ERROR
 #ifndef OUTLINER_SHORTCUTS_ERROR
 /**
 * @brief ERROR. Calls UE_LOG(LogOutlinerShortcutsEditor, Error, ...).
@@ -103,6 +173,64 @@ DECLARE_LOG_CATEGORY_EXTERN(LogOutlinerShortcutsEditor, Log, All);
 #define OUTLINER_SHORTCUTS_ERROR_H(Format, ...) __OUTLINER_SHORTCUTS_ERRORH__(Format, ##__VA_ARGS__);
 #define __OUTLINER_SHORTCUTS_ERRORH__(Format, ...) UE_LOG(LogOutlinerShortcutsEditor, Error, TEXT("[%hs]  " Format), __FUNCTION__, ##__VA_ARGS__);
 #endif
+#else // OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL > OUTLINER_SHORTCUTS_LOG_LEVEL_ERROR
+#define OUTLINER_SHORTCUTS_ERROR(Format, ...) {}
+#define OUTLINER_SHORTCUTS_ERROR_H(Format, ...) {}
+#endif
+
+
+#ifndef __OUTLINER_SHORTCUTS_RATE_LIMITED__
+/**
+* @brief Logs at most one message every OUTLINER_SHORTCUTS_LOG_RATE_LIMIT_SECONDS from this call site, the others are only counted.
+* The arguments are only formatted when the message is logged.
+*/
+#define __OUTLINER_SHORTCUTS_RATE_LIMITED__(Verbosity, Format, ...) \
+	{ \
+		static FOutlinerShortcutsLogLimiter OutlinerShortcutsLogLimiter(__FUNCTION__, __LINE__); \
+		int32 OutlinerShortcutsNumSuppressed = 0; \
+		if (OutlinerShortcutsLogLimiter.ShouldLog(OutlinerShortcutsNumSuppressed)) \
+		{ \
+			if (OutlinerShortcutsNumSuppressed > 0) \
+			{ \
+				UE_LOG(LogOutlinerShortcutsEditor, Verbosity, TEXT("[%hs]  %d similar messages suppressed"), __FUNCTION__, OutlinerShortcutsNumSuppressed); \
+			} \
+			UE_LOG(LogOutlinerShortcutsEditor, Verbosity, TEXT("[%hs]  " Format), __FUNCTION__, ##__VA_ARGS__); \
+		} \
+	}
+#endif
+
+#ifndef OUTLINER_SHORTCUTS_LOG_H_RL
+#if OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL <= OUTLINER_SHORTCUTS_LOG_LEVEL_DISPLAY
+/**
+* @brief LOG + HERE, RATE LIMITED. Calls UE_LOG(LogOutlinerShortcutsEditor, Display, ...) at most once every OUTLINER_SHORTCUTS_LOG_RATE_LIMIT_SECONDS.
+*/
+#define OUTLINER_SHORTCUTS_LOG_H_RL(Format, ...) __OUTLINER_SHORTCUTS_RATE_LIMITED__(Display, Format, ##__VA_ARGS__);
+#else
+#define OUTLINER_SHORTCUTS_LOG_H_RL(Format, ...) {}
+#endif
+#endif
+
+#ifndef OUTLINER_SHORTCUTS_WARN_H_RL
+#if OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL <= OUTLINER_SHORTCUTS_LOG_LEVEL_WARNING
+/**
+* @brief WARN + HERE, RATE LIMITED. Calls UE_LOG(LogOutlinerShortcutsEditor, Warning, ...) at most once every OUTLINER_SHORTCUTS_LOG_RATE_LIMIT_SECONDS.
+*/
+#define OUTLINER_SHORTCUTS_WARN_H_RL(Format, ...) __OUTLINER_SHORTCUTS_RATE_LIMITED__(Warning, Format, ##__VA_ARGS__);
+#else
+#define OUTLINER_SHORTCUTS_WARN_H_RL(Format, ...) {}
+#endif
+#endif
+
+#ifndef OUTLINER_SHORTCUTS_ERROR_H_RL
+#if OUTLINER_SHORTCUTS_COMPILED_LOG_LEVEL <= OUTLINER_SHORTCUTS_LOG_LEVEL_ERROR
+/**
+* @brief ERROR + HERE, RATE LIMITED. Calls UE_LOG(LogOutlinerShortcutsEditor, Error, ...) at most once every OUTLINER_SHORTCUTS_LOG_RATE_LIMIT_SECONDS.
+*/
+#define OUTLINER_SHORTCUTS_ERROR_H_RL(Format, ...) __OUTLINER_SHORTCUTS_RATE_LIMITED__(Error, Format, ##__VA_ARGS__);
+#else
+#define OUTLINER_SHORTCUTS_ERROR_H_RL(Format, ...) {}
+#endif
+#endif
 
 
 #ifndef __OUTLINER_SHORTCUTS_FILENAME__
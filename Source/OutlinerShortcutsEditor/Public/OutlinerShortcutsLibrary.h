@@ -0,0 +1,116 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "OutlinerShortcutsLibrary.generated.h"
+
+UENUM(BlueprintType)
+enum class EOutlinerShortcutsOperationType : uint8
+{
+	CollapseAll,
+	CollapseToRoot,
+	ExpandAll,
+	// Expands down to `Depth` and collapses the deeper items
+	ExpandToDepth,
+	// Restores the expansion saved when the current map was last closed, or collapses to root
+	RestoreLastState,
+	// Expands only the folders matching the `Folder Expansion Patterns` of the settings
+	ExpandMatchingFolders,
+	// Expands the parents of the actors of the `Focused Actor Classes` of the settings
+	ExpandFocusedClasses,
+	// Collapses everything except the parents of the actors of the `Focused Actor Classes` of the settings
+	CollapseAllExceptFocusedClasses,
+};
+
+USTRUCT(BlueprintType)
+struct OUTLINERSHORTCUTSEDITOR_API FOutlinerShortcutsOperation
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Outliner Shortcuts")
+		EOutlinerShortcutsOperationType Type = EOutlinerShortcutsOperationType::CollapseToRoot;
+
+	// Only used by `ExpandToDepth`. At depth 1, only the root items are expanded.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Outliner Shortcuts")
+		int32 Depth = 1;
+};
+
+USTRUCT(BlueprintType)
+struct OUTLINERSHORTCUTSEDITOR_API FOutlinerShortcutsBatchResult
+{
+	GENERATED_BODY()
+
+	// False if one of the Outliners was not found or not ready
+	UPROPERTY(BlueprintReadOnly, Category = "Outliner Shortcuts")
+		bool bSuccess = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Outliner Shortcuts")
+		int32 OutlinersTouched = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Outliner Shortcuts")
+		int32 ItemsVisited = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Outliner Shortcuts")
+		int32 ItemsExpanded = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Outliner Shortcuts")
+		int32 ItemsCollapsed = 0;
+
+	// Time spent applying the operations. The Outliners only rebuild their rows on their next tick, which is not included.
+	UPROPERTY(BlueprintReadOnly, Category = "Outliner Shortcuts")
+		float DurationMs = 0.f;
+};
+
+/**
+ * Exposes the Outliner commands to Blueprints and Python.
+ * All the operations of a call are applied in one pass, each Outliner being refreshed once at the end.
+ * The refresh is deferred by the Outliner to its next tick, so the rows only reflect the changes on the next frame.
+ *
+ * Outliners are given by their identifier, see `GetOutlinerIds()`. An empty list targets the most recently used Outliner.
+ * [Before UE 5.1] There is a single Outliner and the identifiers are ignored.
+ */
+UCLASS()
+class OUTLINERSHORTCUTSEDITOR_API UOutlinerShortcutsLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Applies the operations in order to each of the given Outliners, and refreshes each of them once
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult ApplyOperations(const TArray<FOutlinerShortcutsOperation>& Operations, const TArray<FName>& OutlinerIds);
+
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult CollapseAll(const TArray<FName>& OutlinerIds);
+
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult CollapseToRoot(const TArray<FName>& OutlinerIds);
+
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult ExpandAll(const TArray<FName>& OutlinerIds);
+
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult ExpandToDepth(int32 Depth, const TArray<FName>& OutlinerIds);
+
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult RestoreLastState(const TArray<FName>& OutlinerIds);
+
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult ExpandMatchingFolders(const TArray<FName>& OutlinerIds);
+
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult ExpandFocusedClasses(const TArray<FName>& OutlinerIds);
+
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static FOutlinerShortcutsBatchResult CollapseAllExceptFocusedClasses(const TArray<FName>& OutlinerIds);
+
+	// Returns the identifiers of the opened Outliners, from the most recently used to the least recently used
+	UFUNCTION(BlueprintCallable, Category = "Outliner Shortcuts")
+		static TArray<FName> GetOutlinerIds();
+
+	// Parses an operation as written in the console commands, ex: `CollapseToRoot` or `ExpandToDepth=2`.
+	// A bare `ExpandToDepth` takes the depth of the settings. Returns false for an unknown operation or a depth that is not a positive whole number.
+	static bool ParseOperation(const FString& Text, FOutlinerShortcutsOperation& OutOperation);
+};
@@ -5,9 +5,14 @@
 #include "CoreMinimal.h"
 #include "UObject/Class.h"
 #include "UObject/ReflectedTypeAccessors.h"
+#include "UObject/SoftObjectPtr.h"
+#include "FolderPathMatcher.h"
 
 #include "OutlinerShortcutsSettings.generated.h"
 
+class SSceneOutliner;
+class AActor;
+
 UENUM()
 enum class EOutlinerExpansionBehaviorOnMapOpen : uint8
 {
@@ -17,6 +22,14 @@ enum class EOutlinerExpansionBehaviorOnMapOpen : uint8
 	CollapseAll,
 	// Collapses all the actors in the Scene Outliner but keep the root item expanded.
 	CollapseToRoot,
+	// Restores the items that were expanded the last time the map was closed. Collapses to root if the map was never opened before.
+	RestoreLastState,
+	// Expands the Scene Outliner down to the depth of `Expand to Depth` and collapses the deeper items.
+	ExpandToDepth,
+	// Expands only the folders matching the `Folder Expansion Patterns`, and the parents needed to show them.
+	ExpandMatchingFolders,
+	// Leaves the Scene Outliner as it is. Mostly useful to skip some Outliners in `Outliner Expansion Behavior Overrides`.
+	LeaveAlone,
 };
 
 /**
@@ -34,8 +47,98 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts")
 		EOutlinerExpansionBehaviorOnMapOpen DefaultOutlinerExpansionBehaviorOnMapOpen = EOutlinerExpansionBehaviorOnMapOpen::CollapseToRoot;
 
+	/*
+	* [UE 5.1 Onwards] Behavior of specific Outliners when a map opens, by Outliner identifier. The other Outliners use the default behavior above.
+	* The identifiers of the opened Outliners are printed by the console command `OutlinerShortcuts.ListOutliners`, ex: `LevelEditorSceneOutliner2`.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts")
+		TMap<FName, EOutlinerExpansionBehaviorOnMapOpen> OutlinerExpansionBehaviorOverrides;
+
+	/*
+	* Time to wait for the Scene Outliner to be populated after a map opens, in seconds. The settings above are not applied if the Outliner is not ready by then.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts", AdvancedDisplay, meta = (ClampMin = "1", UIMin = "5", UIMax = "120", Units = "s"))
+		float OutlinerReadyTimeout = 30.f;
+
+	/*
+	* Depth used by the `Expand to Depth` command. At depth 1, only the root items are expanded.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts", meta = (ClampMin = "0", UIMin = "0", UIMax = "10"))
+		int32 ExpandToDepth = 2;
+
+	/*
+	* Applies the behavior above to the items added after the map opened, ex: World Partition cells, level instances or sub levels loaded later.
+	* Only the new items are changed, the items already in the Outliner are left as they are.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts")
+		bool bApplyBehaviorToLoadedItems = true;
+
+	/*
+	* Time to gather the items added to the Outliner before applying the behavior to them, in seconds. Items loaded together are processed in a single pass.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts", AdvancedDisplay, meta = (EditCondition = "bApplyBehaviorToLoadedItems", ClampMin = "0", UIMin = "0", UIMax = "2", Units = "s"))
+		float LoadedItemsCoalesceWindow = 0.25f;
+
+	/*
+	* Folders expanded by the `Expand Matching Folders` command, as paths relative to the root of the Outliner. The last pattern matching a folder wins.
+	* `*` matches one folder, `**` any number of folders, and a pattern starting with `!` excludes the folders it matches. ex: `Lighting/**`, `!Gameplay/Spawners/*`
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts")
+		TArray<FString> FolderExpansionPatterns;
+
+	/*
+	* Actor classes shown by the `Expand Focused Classes` and `Collapse All Except Focused Classes` commands, child classes included. ex: `Light`, a blueprint spawner class
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts", meta = (AllowAbstract = "true"))
+		TArray<TSoftClassPtr<AActor>> FocusedActorClasses;
+
+	/*
+	* Expands the parents of the actors selected in the viewport as the selection changes, and collapses the ones that are no longer needed.
+	* Works best after `Reveal Selection` or `Collapse to Root`, as the other items are left as they are.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts")
+		bool bRevealSelectionFollowsViewport = false;
+
+	/*
+	* Sets the expansion of the actor folders from the behavior above as soon as the map opens, before the Outliner builds its rows,
+	* so the rows of the folders collapsed by the behavior are never created. Only used when all the opened Outliners share the same behavior.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts|Performance")
+		bool bPreseedFolderExpansion = true;
+
+	/*
+	* Spreads `Expand All` over several frames instead of expanding the whole tree at once, which keeps the editor responsive on large maps.
+	* Pressing the shortcut again while the expansion is running cancels it.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts|Performance")
+		bool bTimeSliceExpandAll = false;
+
+	/*
+	* Time spent expanding items each frame when `Time Slice Expand All` is enabled, in milliseconds.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Outliner Shortcuts|Performance", meta = (EditCondition = "bTimeSliceExpandAll", ClampMin = "0.5", UIMin = "1", UIMax = "33", Units = "ms"))
+		float ExpandAllFrameBudgetMs = 5.f;
+
 	FORCEINLINE static const UOutlinerShortcutsEditorSettings* GetDefaultInstance()
 	{
 		return GetDefault<UOutlinerShortcutsEditorSettings>();
 	}
+
+	// Returns the behavior to apply to the Outliner when a map opens, taking `OutlinerExpansionBehaviorOverrides` into account
+	EOutlinerExpansionBehaviorOnMapOpen GetExpansionBehaviorOnMapOpen(const SSceneOutliner& SOutliner) const;
+
+	// Returns the classes of `FocusedActorClasses`, loading them if needed
+	TArray<UClass*> GetFocusedActorClasses() const;
+
+	// Returns the `FolderExpansionPatterns` compiled, they are only compiled again after they change
+	const FFolderPathMatcher& GetFolderPatternMatcher() const;
+
+	virtual void PostReloadConfig(FProperty* PropertyThatWasLoaded) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	mutable FFolderPathMatcher FolderPatternMatcher;
+	mutable bool bFolderPatternMatcherDirty = true;
 };
@@ -0,0 +1,120 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "OutlinerShortcutsEditor.h"
+
+class IConsoleObject;
+
+DECLARE_STATS_GROUP(TEXT("OutlinerShortcuts"), STATGROUP_OutlinerShortcuts, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Items Visited"), STAT_OutlinerShortcuts_ItemsVisited, STATGROUP_OutlinerShortcuts, OUTLINERSHORTCUTSEDITOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Items Expanded"), STAT_OutlinerShortcuts_ItemsExpanded, STATGROUP_OutlinerShortcuts, OUTLINERSHORTCUTSEDITOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Items Collapsed"), STAT_OutlinerShortcuts_ItemsCollapsed, STATGROUP_OutlinerShortcuts, OUTLINERSHORTCUTSEDITOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Outliners Touched"), STAT_OutlinerShortcuts_OutlinersTouched, STATGROUP_OutlinerShortcuts, OUTLINERSHORTCUTSEDITOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Fingerprints Checked"), STAT_OutlinerShortcuts_FingerprintsChecked, STATGROUP_OutlinerShortcuts, OUTLINERSHORTCUTSEDITOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Outliners Skipped"), STAT_OutlinerShortcuts_OutlinersSkipped, STATGROUP_OutlinerShortcuts, OUTLINERSHORTCUTSEDITOR_API);
+
+// Enable with `-trace=cpu,OutlinerShortcuts` or `Trace.Enable OutlinerShortcuts` to see the plugin scopes in Unreal Insights
+UE_TRACE_CHANNEL_EXTERN(OutlinerShortcutsChannel, OUTLINERSHORTCUTSEDITOR_API);
+
+
+#ifndef OUTLINER_SHORTCUTS_SCOPE_COUNTER
+/**
+* @brief Times the current scope in the `OutlinerShortcuts` stats group and in the `OutlinerShortcuts` trace channel.
+*/
+#define OUTLINER_SHORTCUTS_SCOPE_COUNTER(Name) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_OutlinerShortcuts_##Name, STATGROUP_OutlinerShortcuts); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("OutlinerShortcuts::" #Name, OutlinerShortcutsChannel);
+#endif
+
+#ifndef OUTLINER_SHORTCUTS_SCOPE_COMMAND
+/**
+* @brief Same as OUTLINER_SHORTCUTS_SCOPE_COUNTER, and also records the latency and counters of the command for `OutlinerShortcuts.DumpStats`.
+*/
+#define OUTLINER_SHORTCUTS_SCOPE_COMMAND(Name) \
+	OUTLINER_SHORTCUTS_SCOPE_COUNTER(Name) \
+	const FOutlinerShortcutsStats::FScopedCommand ScopedCommand_##Name(TEXT(#Name));
+#endif
+
+#ifndef OUTLINER_SHORTCUTS_INC_COUNTER
+/**
+* @brief Adds to one of the counters of the `OutlinerShortcuts` stats group and to the commands being recorded.
+* @param Counter One of ItemsVisited, ItemsExpanded, ItemsCollapsed, OutlinersTouched, FingerprintsChecked or OutlinersSkipped
+*/
+#define OUTLINER_SHORTCUTS_INC_COUNTER(Counter, Amount) \
+	{ \
+		INC_DWORD_STAT_BY(STAT_OutlinerShortcuts_##Counter, Amount); \
+		FOutlinerShortcutsStats::AddToRunningCommands(&FOutlinerShortcutsStats::FCounters::Counter, Amount); \
+	}
+#endif
+
+
+/**
+ * Keeps the latency and the counters of every command run during the session, to tell apart the hitches of the plugin from the ones of Slate.
+ * Dump them with the `OutlinerShortcuts.DumpStats` console command, and reset them with `OutlinerShortcuts.ResetStats`.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FOutlinerShortcutsStats : public IModuleListenerInterface
+{
+public:
+	struct FCounters
+	{
+		int64 ItemsVisited = 0;
+		int64 ItemsExpanded = 0;
+		int64 ItemsCollapsed = 0;
+		int64 OutlinersTouched = 0;
+		// Outliners checked against their fingerprint, and the ones skipped as already up to date
+		int64 FingerprintsChecked = 0;
+		int64 OutlinersSkipped = 0;
+	};
+
+	// Records the command for the lifetime of the scope. Commands can be nested, the counters are added to all the running ones.
+	class OUTLINERSHORTCUTSEDITOR_API FScopedCommand : public FNoncopyable
+	{
+	public:
+		explicit FScopedCommand(const TCHAR* InCommandName);
+		~FScopedCommand();
+
+	private:
+		friend class FOutlinerShortcutsStats;
+
+		const TCHAR* CommandName;
+		double StartTime;
+		FCounters Counters;
+		FScopedCommand* Parent;
+	};
+
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	static FOutlinerShortcutsStats* Get();
+
+	// Adds to the given counter of all the commands currently running on the game thread
+	static void AddToRunningCommands(int64 FCounters::* Counter, int64 Amount);
+
+	void DumpStats(FOutputDevice& Ar) const;
+	void ResetStats();
+
+private:
+	struct FCommandHistory
+	{
+		// Latency of the last runs, in milliseconds. Older runs are overwritten once full.
+		TArray<float> LatenciesMs;
+		int32 NextIndex = 0;
+		int64 NumRuns = 0;
+		FCounters Totals;
+	};
+
+	void RecordCommand(const TCHAR* CommandName, double LatencySeconds, const FCounters& Counters);
+
+	TMap<FName, FCommandHistory> Histories;
+	IConsoleObject* DumpStatsCommand = nullptr;
+	IConsoleObject* ResetStatsCommand = nullptr;
+
+	static FScopedCommand* RunningCommand;
+	static FOutlinerShortcutsStats* Instance;
+};
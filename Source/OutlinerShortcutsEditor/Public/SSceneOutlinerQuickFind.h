@@ -0,0 +1,50 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneOutlinerLabelIndex.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class IMenu;
+class ITableRow;
+class SSearchBox;
+class STableViewBase;
+
+/**
+ * Popup of the Find and Reveal command, listing the actors and folders whose label contains the text typed.
+ * Results come from `FSceneOutlinerLabelIndex`, so typing never filters nor refreshes the Outliner.
+ * Picking a result selects its actor and only expands the parents of its item, see `FSceneOutlinerSelectionReveal::RevealItem`.
+ */
+class OUTLINERSHORTCUTSEDITOR_API SSceneOutlinerQuickFind : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SSceneOutlinerQuickFind) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<SSceneOutliner>& InOutliner);
+
+	// Opens the popup at the mouse cursor, revealing the results in the given Outliner
+	static void Open(SSceneOutliner& SOutliner);
+
+private:
+	using FResultPtr = TSharedPtr<FSceneOutlinerLabelIndex::FResult>;
+
+	void OnSearchTextChanged(const FText& Text);
+	void OnSearchTextCommitted(const FText& Text, ETextCommit::Type CommitType);
+	// Moves the selected result with the arrows, so the focus can stay in the search box
+	FReply OnSearchKeyDown(const FGeometry& Geometry, const FKeyEvent& KeyEvent);
+	TSharedRef<ITableRow> OnGenerateRow(FResultPtr Result, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnResultClicked(FResultPtr Result) { Pick(Result); }
+
+	void Pick(FResultPtr Result);
+	void Close();
+
+	TWeakPtr<SSceneOutliner> Outliner;
+	TWeakPtr<IMenu> Menu;
+	TSharedPtr<SSearchBox> SearchBox;
+	TSharedPtr<SListView<FResultPtr>> ResultsList;
+	TArray<FResultPtr> Results;
+	FText SearchText;
+};
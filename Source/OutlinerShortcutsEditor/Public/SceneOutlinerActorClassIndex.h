@@ -0,0 +1,47 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "SceneOutlinerWorldActorIndex.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+
+/**
+ * Keeps the actors of the editor world grouped by class, so the actors of a few classes can be found without going through the whole Outliner.
+ * Built and maintained from the actors walked by `FSceneOutlinerWorldActorIndex`.
+ * Finding the actors of the given classes costs the number of distinct classes in the world plus the number of actors found.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerActorClassIndex : public IModuleListenerInterface, public FSceneOutlinerWorldActorIndex::IListener
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the index registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerActorClassIndex* Get();
+
+	// Adds the actors of the current editor world which are of one of the given classes, or of a child class
+	void GatherActors(const TArray<UClass*>& Classes, TArray<FObjectKey>& OutActors);
+
+	// Rebuilds the index on the next lookup
+	void MarkDirty();
+
+	//~ Begin FSceneOutlinerWorldActorIndex::IListener
+	virtual void OnIndexReset(UWorld* World) override;
+	virtual void OnIndexActorAdded(AActor& Actor) override;
+	virtual void OnIndexActorDeleted(AActor& Actor) override;
+	//~ End FSceneOutlinerWorldActorIndex::IListener
+
+private:
+	// Recompiling a blueprint replaces the class of its actors
+	void OnBlueprintCompiled() { MarkDirty(); }
+
+	TMap<TWeakObjectPtr<UClass>, TSet<FObjectKey>> ActorsByClass;
+
+	FDelegateHandle OnBlueprintCompiledHandle;
+
+	static FSceneOutlinerActorClassIndex* Instance;
+};
@@ -4,6 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "OutlinerShortcutsEditor.h"
+#include "Containers/Ticker.h"
+
+struct FSceneOutlinerHierarchyChangedData;
+class UOutlinerShortcutsEditorSettings;
+class UWorld;
 
 
 /**
@@ -20,13 +25,38 @@ public:
 
 	//class UMapOutlinerData* LatestLoadedData;
 	FTSTicker::FDelegateHandle TickUntilActorsLoadedHandle;
-	static bool TickUntilActorsLoaded(float DeltaTime);
+	/*
+	 * Checks if the Outliner is ready and applies the settings. Polls again with an exponential backoff until the timeout from the settings.
+	 */
+	bool TickUntilActorsLoaded(float DeltaTime);
 	/*
 	 *
 	 */
 	static bool ApplyOutlinerActionsFromOnMapOpenedSettings();
 	static bool ApplyOutlinerExpansionFromOnMapOpenedSettings(const SSceneOutliner* SceneOutliner);
 private:
+#if UE5_1_ONWARDS
+	// [UE 5.1 Onwards] Applies to each Outliner its own behavior from `OutlinerExpansionBehaviorOverrides`, skipping the ones left alone
+	static bool ApplyOutlinerExpansionPerOutliner(const UOutlinerShortcutsEditorSettings& EditorSettings);
+#endif
+	/**
+	 * Returns the most recently used Outliner that can get ready, skipping the ones without a hierarchy.
+	 * `OutReadiness` is `Unsupported` if none of the opened Outliners will ever be ready, in which case there is no point waiting,
+	 * and `Pending` if no Outliner is opened yet.
+	 */
+	static SSceneOutliner* FindOutlinerToWaitFor(ESceneOutlinerReadiness& OutReadiness);
+	// Sets the expansion of the folders of the world from the behavior on map open, before the Outliners create their items from it
+	static void PreseedFolderExpansion(UWorld* World);
+	// The Outliners get populated right after their hierarchy is refreshed, so this is where we check if they are ready
+	void OnOutlinerHierarchyChanged(SSceneOutliner* SOutliner, const FSceneOutlinerHierarchyChangedData& Data);
+	void ScheduleReadinessCheck(float Delay);
+	void StopWaitingForOutliner();
+
+	FDelegateHandle OnOutlinerHierarchyChangedHandle;
+	bool bWaitingForOutliner = false;
+	bool bReadinessCheckScheduledFromEvent = false;
+	double WaitStartTime = 0.;
+	float PollDelay = 0.f;
 
 	/** Private array of event callback releaser data, inspired from FAcquiredResources */
 	//struct FReleaser
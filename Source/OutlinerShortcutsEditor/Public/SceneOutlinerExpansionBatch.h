@@ -0,0 +1,71 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISceneOutlinerTreeItem.h"
+
+/**
+ * Collects expansion changes for one or more Scene Outliners and applies them all at once when committed or destroyed.
+ * Only the items whose expansion actually differs from the requested state are changed, and each Outliner is refreshed once.
+ *
+ * Usage:
+ *	{
+ *		FSceneOutlinerExpansionBatch Batch;
+ *		Batch.CollapseAll(*SOutliner);
+ *		Batch.SetItemExpansion(*SOutliner, RootItem, true);
+ *	} // changes applied here
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerExpansionBatch : public FNoncopyable
+{
+public:
+	struct FStats
+	{
+		int32 OutlinersTouched = 0;
+		int32 ItemsVisited = 0;
+		int32 ItemsExpanded = 0;
+		int32 ItemsCollapsed = 0;
+	};
+
+	FSceneOutlinerExpansionBatch() = default;
+	~FSceneOutlinerExpansionBatch();
+
+	// Collapses every item of the Outliner, except the ones set to expanded afterwards
+	void CollapseAll(SSceneOutliner& SOutliner);
+	// Expands every item of the Outliner, except the ones set to collapsed afterwards
+	void ExpandAll(SSceneOutliner& SOutliner);
+	void SetItemExpansion(SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemPtr& Item, bool bIsExpanded);
+
+	// Returns the expansion the item will have once the batch is committed
+	bool IsItemExpanded(const SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemPtr& Item) const;
+
+	// Applies the changes collected so far and refreshes the changed Outliners
+	void Commit();
+
+	// Totals of all the commits of this batch
+	const FStats& GetStats() const { return Stats; }
+
+private:
+	enum class EBaseState : uint8
+	{
+		// Items not set explicitly keep their current expansion
+		Unchanged,
+		Collapsed,
+		Expanded,
+	};
+
+	struct FOutlinerChanges
+	{
+		TWeakPtr<SSceneOutliner> Outliner;
+		EBaseState BaseState = EBaseState::Unchanged;
+		// Requested expansion of individual items, the last request wins
+		TMap<FSceneOutlinerTreeItemID, TPair<TWeakPtr<ISceneOutlinerTreeItem>, bool>> Items;
+	};
+
+	FOutlinerChanges& FindOrAddChanges(SSceneOutliner& SOutliner);
+	const FOutlinerChanges* FindChanges(const SSceneOutliner& SOutliner) const;
+	void Apply(FOutlinerChanges& Changes);
+
+	TArray<FOutlinerChanges> OutlinerChanges;
+	FStats Stats;
+};
@@ -0,0 +1,85 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "SceneOutlinerExpansionSet.h"
+#include "Tasks/Task.h"
+
+class FSceneOutlinerExpansionBatch;
+
+/**
+ * Expansion state loaded from the cache file of a map.
+ * The keys are read on a worker thread, then resolved once on the game thread so the items can be looked up without building their key:
+ * actors are interned by ID, folders are looked up by path.
+ */
+struct OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerSavedExpansion
+{
+	// Keys of the expanded items, as read from the file
+	TArray<FString> ExpandedKeys;
+
+	// Resolves the keys against the loaded objects. Must be called on the game thread before `Contains`, only the first call does something.
+	void Resolve();
+	bool IsResolved() const { return bIsResolved; }
+	// Returns true if the item was expanded when the state was saved
+	bool Contains(const ISceneOutlinerTreeItem& Item) const;
+	int32 Num() const { return ExpandedKeys.Num(); }
+
+private:
+	FSceneOutlinerItemInterner Interner;
+	FSceneOutlinerExpansionSet ExpandedItems;
+	TSet<FName> ExpandedFolders;
+	// Items that are neither actors, folders nor the world are only identified by their display string
+	TSet<FString> ExpandedOtherKeys;
+	bool bIsWorldExpanded = false;
+	bool bIsResolved = false;
+};
+
+/**
+ * Saves the expansion state of the Scene Outliner for each map, to restore it the next time the map opens.
+ *
+ * The state is saved in `Saved/OutlinerShortcuts/ExpansionState/` as a small binary file per map:
+ * a table of the stable keys of the visible items that have children, followed by a bitset of the expanded ones indexed like the table.
+ * Files are written on a worker thread when the map closes, and memory mapped when the state is restored.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerExpansionCache : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the cache registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerExpansionCache* Get();
+
+	// Adds the expansion state saved for the current map to the batch. Returns false if nothing was saved for this map.
+	bool RestoreExpansion(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner);
+	// Loads the keys of the items expanded when the map was last closed on a worker thread, after the pending writes. The result is unset if nothing was saved for this map.
+	UE::Tasks::TTask<TOptional<FSceneOutlinerSavedExpansion>> LoadSavedExpansionAsync(const FString& MapPackageName);
+	// Saves the expansion state of the most recently used Outliner for the current map, in the background
+	void SaveExpansion();
+	// Saves the expansion state of the Outliner for the given map, in the background. Unlike the above, temporary maps are not skipped, ex: to seed the state of a synthetic map.
+	void SaveExpansion(SSceneOutliner& SOutliner, const FString& MapPackageName);
+	// Blocks until the files being written in the background are written
+	void WaitForPendingWrites();
+
+	// Returns a key identifying the item across editor sessions, or an empty string if the item can't be identified
+	static FString GetStableItemKey(const ISceneOutlinerTreeItem& Item);
+	static FString GetCacheFilename(const FString& MapPackageName);
+
+	// Adds to the batch the changes collapsing the Outliner except the items expanded in the saved state, which must be resolved.
+	// Only the expanded items are walked down, so this costs the number of rows that end up visible.
+	static void ApplySavedExpansion(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FSceneOutlinerSavedExpansion& SavedExpansion);
+
+private:
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void SaveExpansion(UWorld* World);
+
+	// Loads the keys of the expanded items from the cache file of the map
+	static bool LoadExpandedKeys(const FString& Filename, TArray<FString>& OutExpandedKeys);
+
+	TArray<UE::Tasks::FTask> PendingWrites;
+	FDelegateHandle OnWorldCleanupHandle;
+
+	static FSceneOutlinerExpansionCache* Instance;
+};
@@ -0,0 +1,57 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ISceneOutlinerTreeModel;
+
+/**
+ * Tracks how deep a tree of Outliner items is expanded, level by level.
+ * The items of each expanded level are kept, along with the frontier: the collapsed items with children right below the last expanded level.
+ * Expanding or collapsing one more level only costs the size of the frontier and of the level being changed, not a walk of the whole tree.
+ * Items are the indices of the given model, so a frontier kept across calls must always be used with the same model.
+ * On a live Outliner, changes go through the batch of its `FSceneOutlinerWidgetTreeModel`, so several steps can be chained before the Outliner refreshes.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerExpansionFrontier
+{
+public:
+	// Expands every item above the given depth and collapses the ones below. Roots are at depth 0. Returns the number of items visited.
+	int32 ExpandToDepth(ISceneOutlinerTreeModel& Model, int32 Depth);
+	// Expands the items of the frontier. Returns false if there was nothing left to expand.
+	bool ExpandOneLevel(ISceneOutlinerTreeModel& Model);
+	// Collapses the last expanded level. Returns false if there was nothing left to collapse.
+	bool CollapseOneLevel(ISceneOutlinerTreeModel& Model);
+
+	// Moves the given items and their subtrees to the levels of their current depth, ex: after they were added or moved in the tree.
+	// Costs the size of their subtrees down to the tracked depth, instead of the walk of the whole tree of a rebuild.
+	void UpdateItems(ISceneOutlinerTreeModel& Model, const TArray<int32>& Items);
+	// Forgets the items removed from the tree. Their children left in the levels have no children anymore, so they are skipped.
+	void RemoveItems(const TArray<int32>& Items);
+
+	// Forgets the tracked levels, the next call will start from the current state of the tree
+	void Invalidate();
+	bool IsValid() const { return bIsValid; }
+	// Number of levels currently expanded
+	int32 GetDepth() const { return ExpandedLevels.Num(); }
+
+private:
+	// Collapses the tree and expands it back to the given depth
+	void Rebuild(ISceneOutlinerTreeModel& Model, int32 Depth);
+	// Checks that the frontier and the last expanded level, the ones the next step touches, still match the tree, in case items were expanded or collapsed by hand.
+	// Changes by hand in the shallower levels are not detected.
+	bool Validate(const ISceneOutlinerTreeModel& Model);
+	// Returns the depth of the shallowest visible item that could be expanded
+	int32 FindVisibleDepth(const ISceneOutlinerTreeModel& Model);
+	// Adds the item with children to the level of its depth, expanding or collapsing it to match. Returns false if it was already there.
+	bool Track(ISceneOutlinerTreeModel& Model, int32 Item, int32 ItemDepth);
+	void Untrack(int32 Item);
+
+	// Items expanded at each depth, `ExpandedLevels[0]` being the roots
+	TArray<TSet<int32>> ExpandedLevels;
+	// Collapsed items with children right below the last expanded level
+	TSet<int32> Frontier;
+	bool bIsValid = false;
+	// Items visited by the current call, for the stats
+	int32 NumVisited = 0;
+};
@@ -0,0 +1,78 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+
+#if UE5_1_ONWARDS
+
+#include "SceneOutlinerExpansionSet.h"
+#include "Containers/Ticker.h"
+
+struct FSceneOutlinerHierarchyChangedData;
+struct FPointerEvent;
+struct FKeyEvent;
+
+/**
+ * [UE 5.1 Onwards] Copies the expansion state of one Scene Outliner to the other opened ones.
+ *
+ * Only the items whose expansion differs are changed: the expanded items of each Outliner are gathered as a bitset of interned IDs,
+ * and the difference with the source is applied. In live mode, the items flipped in the source by the expansion batches are sent as they are reported,
+ * and the source is only gathered again after the user clicked in it or pressed a key that expands its items, or when its hierarchy changed.
+ * The other Outliners are checked a few times per second, only to bring the newly opened ones in sync.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerExpansionMirror : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the instance registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerExpansionMirror* Get();
+
+	// Copies the expansion of the Outliner to the other opened Outliners. Returns false if there is no other ready Outliner.
+	bool MirrorFrom(SSceneOutliner& Source);
+
+	// Keeps mirroring the Outliner to the others until stopped
+	void StartLiveMirror(SSceneOutliner& Source);
+	void StopLiveMirror();
+	bool IsLiveMirrorRunning() const { return LiveMirrorHandle.IsValid(); }
+
+private:
+	bool TickLiveMirror(float DeltaTime);
+	void OnItemExpansionChanged(const SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemID& ID, bool bIsExpanded);
+	void OnOutlinerHierarchyChanged(SSceneOutliner* SOutliner, const FSceneOutlinerHierarchyChangedData& Data);
+	// The items of another world are all new, the indices are started over
+	void OnMapChange(uint32 MapChangeFlags);
+	void OnMousePreInputButtonDown(const FPointerEvent& MouseEvent);
+	void OnPreInputKeyDown(const FKeyEvent& KeyEvent);
+	// Forgets the state of the source and of the targets, so they are all gathered again on the next tick
+	void ResetLiveState();
+	// Applies the given changes of the expanded items to the Outliner, returns the number of items found
+	int32 ApplyChanges(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& Target, const TArray<int32>& Expanded, const TArray<int32>& Collapsed) const;
+	static TArray<TSharedRef<SSceneOutliner>> GetTargets(const SSceneOutliner& Source);
+
+	FSceneOutlinerItemInterner Interner;
+
+	TWeakPtr<SSceneOutliner> LiveSource;
+	// Expansion of the source as last known, the synced targets match it once the pending changes are sent
+	FSceneOutlinerExpansionSet LiveSourceSet;
+	// Changes of the source not sent to the synced targets yet, by interned index
+	TMap<int32, bool> PendingChanges;
+	// Set when the source might have changed without reporting its items, ex: on user input
+	bool bSourceNeedsCapture = false;
+	// Outliners already matching the source, the other ones get a full diff on the next tick
+	TMap<const SSceneOutliner*, TWeakPtr<SSceneOutliner>> SyncedTargets;
+	FTSTicker::FDelegateHandle LiveMirrorHandle;
+
+	FDelegateHandle OnItemExpansionChangedHandle;
+	FDelegateHandle OnOutlinerHierarchyChangedHandle;
+	FDelegateHandle OnMapChangeHandle;
+	FDelegateHandle OnMousePreInputButtonDownHandle;
+	FDelegateHandle OnPreInputKeyDownHandle;
+
+	static FSceneOutlinerExpansionMirror* Instance;
+};
+
+#endif
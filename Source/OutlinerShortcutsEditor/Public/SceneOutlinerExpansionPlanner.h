@@ -0,0 +1,58 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "SceneOutlinerExpansionCache.h"
+#include "Tasks/Task.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FSceneOutlinerExpansionBatch;
+
+/**
+ * Computes the expansion applied when a map opens on worker tasks, while the Scene Outliner is still being populated.
+ *
+ * When the map opens, the hierarchy of its actors is captured in a `FSceneOutlinerHierarchySnapshot`, or the saved expansion state is loaded,
+ * and the items to expand are computed in the background. Once the Outliner is ready, the game thread only applies the finished plan:
+ * items planned from a snapshot are looked up by ID, only the saved state needs its keys matched against the tree.
+ * Behaviors that don't need the hierarchy, like `Collapse All` or `Expand All`, are not planned and run as before.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerExpansionPlanner : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the planner registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerExpansionPlanner* Get();
+
+	// Starts computing the expansion of `DefaultOutlinerExpansionBehaviorOnMapOpen` for the world. Returns false if the behavior has nothing to plan.
+	bool StartMapOpenPlan(UWorld* World);
+	// Returns true while the plan started for the current world is computed, to be polled before applying it
+	bool IsMapOpenPlanRunning() const;
+	// Applies the plan started for the current world to the ready Outliners, waiting for it if it is not finished yet.
+	// Returns false if there is no plan for this world, in which case the settings should be applied directly.
+	bool ApplyMapOpenPlan();
+	void CancelMapOpenPlan();
+
+private:
+	struct FPlan
+	{
+		// Items to expand, when planned from a snapshot
+		TOptional<TArray<FSceneOutlinerTreeItemID>> ExpandedItems;
+		// Items to expand, when loaded from the saved state. Resolved on the game thread when the plan is applied.
+		TOptional<FSceneOutlinerSavedExpansion> SavedExpansion;
+	};
+
+	// Adds to the batch the changes collapsing the Outliner except the given items, looked up by ID
+	static void ApplyExpandedItems(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const TArray<FSceneOutlinerTreeItemID>& ExpandedItems);
+	static void ApplyPlan(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FPlan& Plan);
+
+	UE::Tasks::TTask<FPlan> PlanTask;
+	TWeakObjectPtr<UWorld> PlanWorld;
+	double PlanStartTime = 0.;
+
+	static FSceneOutlinerExpansionPlanner* Instance;
+};
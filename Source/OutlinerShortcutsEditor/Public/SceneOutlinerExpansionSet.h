@@ -0,0 +1,76 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "Containers/BitArray.h"
+
+/**
+ * Maps the IDs of Scene Outliner items to dense indices, so sets of items can be stored as bits.
+ * The same item has the same index in every Outliner using the same interner, as items are identified by their object or folder.
+ * Indices are never released, only `Reset` frees them, which invalidates the sets built with this interner.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerItemInterner
+{
+public:
+	// Returns the index of the ID, adding it if needed
+	int32 Intern(const FSceneOutlinerTreeItemID& ID);
+	// Returns the index of the ID, or INDEX_NONE if it was never interned
+	int32 Find(const FSceneOutlinerTreeItemID& ID) const;
+	const FSceneOutlinerTreeItemID& GetID(int32 Index) const { return IDs[FSetElementId::FromInteger(Index)]; }
+
+	int32 Num() const { return IDs.Num(); }
+	void Reserve(int32 Number) { IDs.Reserve(Number); }
+	void Reset();
+	SIZE_T GetAllocatedSize() const { return IDs.GetAllocatedSize(); }
+
+private:
+	// Nothing is removed from the set, so its element indices stay dense and are used as the indices of the IDs
+	TSet<FSceneOutlinerTreeItemID> IDs;
+};
+
+/**
+ * Set of items stored as one bit per interned item, ex: the expanded items of an Outliner or a snapshot of all its items.
+ * Sets are only comparable when built with the same interner. Set operations work on whole words of bits.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerExpansionSet
+{
+public:
+	void Add(int32 Index);
+	void Remove(int32 Index);
+	bool Contains(int32 Index) const { return Bits.IsValidIndex(Index) && Bits[Index]; }
+	int32 Num() const { return Bits.CountSetBits(); }
+	bool IsEmpty() const { return Bits.Find(true) == INDEX_NONE; }
+	void Reset() { Bits.Reset(); }
+
+	// Adds the items of the other set
+	void Union(const FSceneOutlinerExpansionSet& Other);
+	// Keeps only the items also in the other set
+	void Intersect(const FSceneOutlinerExpansionSet& Other);
+	// Removes the items of the other set
+	void Subtract(const FSceneOutlinerExpansionSet& Other);
+	// Returns true if all the items of the other set are in this one
+	bool Includes(const FSceneOutlinerExpansionSet& Other) const;
+
+	// Drops the trailing unset bits, ex: before keeping the set around
+	void Trim();
+	SIZE_T GetAllocatedSize() const { return Bits.GetAllocatedSize(); }
+
+	bool operator==(const FSceneOutlinerExpansionSet& Other) const;
+	bool operator!=(const FSceneOutlinerExpansionSet& Other) const { return !(*this == Other); }
+
+	// Returns the expanded items of the Outliner. Only the expanded items are walked down, so this costs the number of visible rows.
+	static FSceneOutlinerExpansionSet Capture(SSceneOutliner& SOutliner, FSceneOutlinerItemInterner& Interner);
+	// Returns all the items of the Outliner, collapsed ones included
+	static FSceneOutlinerExpansionSet CaptureAll(SSceneOutliner& SOutliner, FSceneOutlinerItemInterner& Interner);
+
+	// Gathers the items expanded in `To` but not in `From`, and the items expanded in `From` but not in `To`
+	static void Diff(const FSceneOutlinerExpansionSet& From, const FSceneOutlinerExpansionSet& To, TArray<int32>& OutExpanded, TArray<int32>& OutCollapsed);
+
+	// Iterate over the items with `TConstSetBitIterator<>`
+	const TBitArray<>& GetBits() const { return Bits; }
+
+private:
+	TBitArray<> Bits;
+};
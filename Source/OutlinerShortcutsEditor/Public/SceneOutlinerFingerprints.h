@@ -0,0 +1,100 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "ISceneOutlinerTreeItem.h"
+
+struct FSceneOutlinerHierarchyChangedData;
+struct FPointerEvent;
+struct FKeyEvent;
+
+/**
+ * Remembers the last expansion policy applied to each Scene Outliner, to skip the commands that would not change anything.
+ *
+ * The fingerprint of an Outliner is the policy applied, a generation bumped by every change of its hierarchy or of the world, and a hash of its expanded items.
+ * The hash is kept up to date by the expansion batches as they flip items, so checking a fingerprint doesn't walk the tree.
+ * It is only checked again when the generation changes, or when the user clicked in the Outliner or pressed a key that expands its items,
+ * which only visits the items known to be expanded and the visible ones, so a stale fingerprint never skips a command.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerFingerprints : public IModuleListenerInterface
+{
+public:
+	static const FName CollapseAllPolicy;
+	static const FName CollapseToRootPolicy;
+	static const FName ExpandAllPolicy;
+	// Returns the policy of Expand to Depth for the given depth
+	static FName MakeExpandToDepthPolicy(int32 Depth);
+
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the instance registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerFingerprints* Get();
+
+	// Returns true if the policy was the last one applied to the Outliner and nothing changed since. Counted in the stats either way.
+	static bool ShouldSkip(SSceneOutliner& SOutliner, const FName Policy);
+	// Remembers that the policy was just applied to the Outliner. Must be called once the changes are committed.
+	static void Record(SSceneOutliner& SOutliner, const FName Policy);
+
+	// Updates the expansion hash of the Outliner, must be called for each item whose expansion was just flipped
+	static void ReportItemExpansionChanged(const SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemID& ID, bool bIsExpanded);
+
+	DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnItemExpansionChanged, const SSceneOutliner& /*SOutliner*/, const FSceneOutlinerTreeItemID& /*ID*/, bool /*bIsExpanded*/);
+	// Broadcast for each item flipped by the expansion batches and tree models. The changes made by the user are not reported.
+	FOnItemExpansionChanged& OnItemExpansionChanged() { return ItemExpansionChangedEvent; }
+
+	void Reset();
+
+private:
+	struct FFingerprint
+	{
+		TWeakPtr<SSceneOutliner> Outliner;
+		FName Policy;
+		uint32 Generation = 0;
+		uint32 ExpansionHash = 0;
+	};
+
+	// Sum of the mixed hashes of the expanded items, so an item can be added or removed in any order
+	struct FExpansionHash
+	{
+		TWeakPtr<SSceneOutliner> Outliner;
+		// Items known to be expanded, the sum only changes when one is added or removed
+		TSet<FSceneOutlinerTreeItemID> ExpandedIDs;
+		uint32 Sum = 0;
+		// Generation of the hierarchy the items were checked for
+		uint32 Generation = 0;
+		bool bIsValid = false;
+
+		void Add(const FSceneOutlinerTreeItemID& ID);
+		void Remove(const FSceneOutlinerTreeItemID& ID);
+	};
+
+	void OnOutlinerHierarchyChanged(SSceneOutliner* SOutliner, const FSceneOutlinerHierarchyChangedData& Data);
+	// The items of another world are all new, even if the Outliner didn't tell yet
+	void OnMapChange(uint32 MapChangeFlags);
+	void OnMousePreInputButtonDown(const FPointerEvent& MouseEvent);
+	void OnPreInputKeyDown(const FKeyEvent& KeyEvent);
+
+	// Returns the hash of the expanded items of the Outliner, only checking them again if they might have changed
+	uint32 GetExpansionHash(SSceneOutliner& SOutliner);
+	/**
+	 * Drops the items no longer expanded and adds the expanded items found from the roots, only walking down the expanded ones.
+	 * The user can only expand the visible items, and the batches report the hidden ones they flip.
+	 */
+	static void CheckExpansion(SSceneOutliner& SOutliner, FExpansionHash& Hash);
+	static uint32 MixItemHash(const FSceneOutlinerTreeItemID& ID) { return MurmurFinalize32(GetTypeHash(ID)); }
+
+	TMap<const SSceneOutliner*, FFingerprint> Fingerprints;
+	TMap<const SSceneOutliner*, FExpansionHash> ExpansionHashes;
+	// Bumped by the hierarchy changes, kept apart from the fingerprints so the Outliners changed before any command are counted too
+	TMap<const SSceneOutliner*, uint32> Generations;
+	FDelegateHandle OnOutlinerHierarchyChangedHandle;
+	FDelegateHandle OnMapChangeHandle;
+	FDelegateHandle OnMousePreInputButtonDownHandle;
+	FDelegateHandle OnPreInputKeyDownHandle;
+	FOnItemExpansionChanged ItemExpansionChangedEvent;
+
+	static FSceneOutlinerFingerprints* Instance;
+};
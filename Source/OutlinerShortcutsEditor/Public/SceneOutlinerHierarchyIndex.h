@@ -0,0 +1,95 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "SceneOutlinerExpansionFrontier.h"
+#include "SceneOutlinerTreeModel.h"
+#include "Containers/Ticker.h"
+
+struct FSceneOutlinerHierarchyChangedData;
+class FSceneOutlinerExpansionBatch;
+class ISceneOutlinerHierarchy;
+
+/**
+ * Keeps an index of the root items of each Scene Outliner, maintained from the Outliner's hierarchy-changed events.
+ * Looking up the roots costs O(roots) once the index is built, and never touches the selection of the Outliner.
+ *
+ * The Outliner creates a new hierarchy on every full refresh, with or without an event, so the index checks each tick that it is bound
+ * to the live hierarchy of each tracked Outliner, and whenever one is looked up. A re-bind is broadcast as a full refresh, as the items of the new hierarchy are all new.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerHierarchyIndex : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the index registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerHierarchyIndex* Get();
+
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnOutlinerHierarchyChanged, SSceneOutliner* /*SOutliner*/, const FSceneOutlinerHierarchyChangedData& /*Data*/);
+	// Broadcasts the hierarchy-changed events of every tracked Scene Outliner, after the index has been updated
+	FOnOutlinerHierarchyChanged& OnOutlinerHierarchyChanged() { return OutlinerHierarchyChangedEvent; }
+
+	// Starts listening to the hierarchy of the Scene Outliner, if it was not already tracked
+	void TrackOutliner(SSceneOutliner* SOutliner);
+
+	// Returns the root items of the Scene Outliner, only rescanning the Outliner if its index was invalidated
+	TArray<FSceneOutlinerTreeItemPtr> GetRootItems(SSceneOutliner* SOutliner);
+
+	/**
+	 * Runs the function with the expansion levels tracked for the Scene Outliner and the model of the Outliner whose items they hold, the changes going through the batch.
+	 * The items added, moved or removed since the last call are moved to their levels first. The levels are only invalidated by full refreshes and moved folders.
+	 * Returns false if the Outliner can't be tracked.
+	 */
+	bool WithExpansionFrontier(SSceneOutliner& SOutliner, FSceneOutlinerExpansionBatch& Batch, TFunctionRef<void(ISceneOutlinerTreeModel& /*Model*/, FSceneOutlinerExpansionFrontier& /*Frontier*/)> Function);
+
+	// Scans the rows of the Scene Outliner for the items without parent. Does not use the index and does not modify the selection.
+	static TArray<FSceneOutlinerTreeItemPtr> FindRootItems(SSceneOutliner* SOutliner);
+
+private:
+	struct FOutlinerEntry
+	{
+		TWeakPtr<SSceneOutliner> Outliner;
+		// Only valid on the hierarchy it was bound to, which is never kept as it is destroyed by the full refreshes
+		FDelegateHandle HierarchyChangedHandle;
+
+		// IDs of the items known to be roots
+		TSet<FSceneOutlinerTreeItemID> RootIDs;
+		// IDs of the items added or moved since the last lookup. They are only resolved once the Outliner added them to its tree.
+		TSet<FSceneOutlinerTreeItemID> PendingIDs;
+		// Set on full refreshes, the next lookup will rescan the Outliner
+		bool bNeedsRebuild = true;
+
+		FSceneOutlinerExpansionFrontier ExpansionFrontier;
+		// Kept with the frontier, its levels hold the indices of this model
+		TUniquePtr<FSceneOutlinerWidgetTreeModel> TreeModel;
+		// IDs of the items added or moved since the frontier was last used, resolved once the Outliner added them to its tree
+		TSet<FSceneOutlinerTreeItemID> FrontierPendingIDs;
+	};
+
+	FOutlinerEntry* FindOrAddEntry(SSceneOutliner* SOutliner);
+	// Binds the entry to the live hierarchy of the Outliner if it is not bound to it yet. Returns true if it was re-bound.
+	bool BindEntryIfNeeded(FOutlinerEntry& Entry, SSceneOutliner& SOutliner);
+	void UnbindEntry(FOutlinerEntry& Entry);
+	void RemoveStaleEntries();
+	// Re-binds the entries whose Outliner replaced its hierarchy, for as long as there are tracked Outliners
+	bool TickRebind(float DeltaTime);
+	void ScheduleRebind();
+
+	static ISceneOutlinerHierarchy* GetLiveHierarchy(const SSceneOutliner& SOutliner);
+
+	void OnHierarchyChanged(FSceneOutlinerHierarchyChangedData Data, const SSceneOutliner* Key);
+	static void UpdateRootIDs(FOutlinerEntry& Entry, const FSceneOutlinerHierarchyChangedData& Data);
+	static void UpdateExpansionFrontier(FOutlinerEntry& Entry, const FSceneOutlinerHierarchyChangedData& Data);
+	// Moves the pending items to the levels of the frontier
+	static void ResolveFrontierPendingItems(FOutlinerEntry& Entry, SSceneOutliner& SOutliner);
+
+	TMap<const SSceneOutliner*, FOutlinerEntry> Entries;
+	FOnOutlinerHierarchyChanged OutlinerHierarchyChangedEvent;
+	FTSTicker::FDelegateHandle RebindTickerHandle;
+
+	static FSceneOutlinerHierarchyIndex* Instance;
+};
@@ -0,0 +1,62 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Folder.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "UObject/ObjectKey.h"
+
+class FFolderPathMatcher;
+
+/**
+ * Read-only copy of the folder and attachment hierarchy of the actors of a world, as displayed by the Scene Outliner in Actor mode.
+ * Nodes are identified by the `FSceneOutlinerTreeItemID` of their Outliner item, so the items computed from the snapshot
+ * are found in the Outliner with one `GetTreeItem` lookup each.
+ *
+ * `Capture` only copies the object keys, attachments and folders of the actors and must run on the game thread.
+ * Everything else, building the IDs included, only reads the snapshot and can run on worker threads.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerHierarchySnapshot
+{
+public:
+	struct FNode
+	{
+		FSceneOutlinerTreeItemID ID;
+		// Full path of a folder, none for the other nodes
+		FName FolderPath;
+		int32 Parent = INDEX_NONE;
+		// The world is at depth 0, the items directly under it at depth 1
+		int32 Depth = 0;
+		bool bHasChildren = false;
+	};
+
+	// Copies the folder and attach parent of each actor listed in the Outliner. Game thread only.
+	static TSharedRef<FSceneOutlinerHierarchySnapshot> Capture(const UWorld& World);
+
+	// Creates the folder nodes and resolves the IDs, parents and depths of the captured actors
+	void Build();
+
+	// Items with children down to `Depth`, as expanded by `Expand to Depth`
+	TArray<FSceneOutlinerTreeItemID> ComputeExpandToDepthItems(int32 Depth) const;
+	// Folders matched and their parents, as expanded by `Expand Matching Folders`
+	TArray<FSceneOutlinerTreeItemID> ComputeMatchingFolderItems(const FFolderPathMatcher& Matcher) const;
+
+	const TArray<FNode>& GetNodes() const { return Nodes; }
+
+private:
+	struct FCapturedActor
+	{
+		FObjectKey Actor;
+		FFolder Folder;
+		int32 AttachParent = INDEX_NONE;
+	};
+
+	int32 FindOrAddFolder(const FFolder& Folder, TMap<FFolder, int32>& FolderNodes);
+	// Gathers the IDs of the flagged nodes
+	TArray<FSceneOutlinerTreeItemID> GatherItems(const TArray<bool>& Flags) const;
+
+	FObjectKey World;
+	TArray<FCapturedActor> CapturedActors;
+	TArray<FNode> Nodes;
+};
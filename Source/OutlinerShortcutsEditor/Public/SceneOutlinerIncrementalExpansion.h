@@ -0,0 +1,72 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "SceneOutlinerExpansionCache.h"
+#include "Containers/Ticker.h"
+
+struct FSceneOutlinerHierarchyChangedData;
+class ULevel;
+class UWorld;
+enum class EOutlinerExpansionBehaviorOnMapOpen : uint8;
+
+/**
+ * Applies `DefaultOutlinerExpansionBehaviorOnMapOpen` to the items added to the Scene Outliner after the map opened,
+ * ex: World Partition cells, level instances or sub levels loaded later.
+ *
+ * The items added within `LoadedItemsCoalesceWindow` are gathered and processed in one batch, and only the new items are visited.
+ * The new items come from the Added events of the Outliners, and from the actors of the levels added to the world,
+ * which the Outliners only show after a full refresh without telling which items are new. The Outliner restores the expansion of the other items by itself.
+ * The parents of the new items are processed too when all their children are new, ex: the folders created for them.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerIncrementalExpansion : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the instance registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerIncrementalExpansion* Get();
+
+	// Forgets the items waiting to be processed, ex: once the behavior was applied to the whole Outliners
+	void Reset();
+
+private:
+	struct FOutlinerState
+	{
+		TWeakPtr<SSceneOutliner> Outliner;
+		// Items added since the last pass. The ones not yet in the tree are kept for the next pass.
+		TSet<FSceneOutlinerTreeItemID> PendingIDs;
+		int32 NumRetries = 0;
+	};
+
+	void OnOutlinerHierarchyChanged(SSceneOutliner* SOutliner, const FSceneOutlinerHierarchyChangedData& Data);
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+	FOutlinerState& FindOrAddState(SSceneOutliner& SOutliner);
+	// Returns true if all the children of the parent are new, in which case the parent is new too
+	static bool AreAllChildrenNew(const ISceneOutlinerTreeItem& Parent, const TSet<FSceneOutlinerTreeItemID>& NewIDs);
+	void SchedulePass();
+	bool TickPass(float DeltaTime);
+	// Returns false if the Outliner is not ready and the pass should be retried
+	bool ApplyToNewItems(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, FOutlinerState& State);
+
+	// Returns true if the new item should be expanded according to the behavior. `bOutExpandParents` is set if its parents need to be expanded to show it.
+	bool ShouldExpand(const ISceneOutlinerTreeItem& Item, EOutlinerExpansionBehaviorOnMapOpen Behavior, bool& bOutExpandParents);
+	// Returns the expansion saved for the current map, only loading and resolving it once per map
+	const FSceneOutlinerSavedExpansion* GetSavedExpansion();
+
+	static int32 GetItemDepth(const ISceneOutlinerTreeItem& Item);
+
+	TMap<const SSceneOutliner*, FOutlinerState> States;
+	FTSTicker::FDelegateHandle PassHandle;
+	FDelegateHandle OnOutlinerHierarchyChangedHandle;
+	FDelegateHandle OnLevelAddedToWorldHandle;
+
+	FString SavedExpansionMap;
+	TOptional<FSceneOutlinerSavedExpansion> SavedExpansion;
+
+	static FSceneOutlinerIncrementalExpansion* Instance;
+};
@@ -0,0 +1,107 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "SceneOutlinerWorldActorIndex.h"
+
+class AActor;
+struct FFolder;
+
+/**
+ * Trigram index of the labels of the actors and of the names of the folders of the editor world, backing the Find and Reveal popup.
+ * Built and maintained from the actors walked by `FSceneOutlinerWorldActorIndex`, and from the actor renamed and folder events.
+ * A renamed actor is re-indexed under its new label. Undo and redo restore labels without a rename event, so they dirty the index instead.
+ *
+ * Each label is split in lowercase trigrams, the first two being padded so a label can be found from its first one or two characters.
+ * A lookup walks the shortest list of entries among the trigrams of the query and checks each entry, stopping at the maximum number of results,
+ * so it costs the size of that list at most, whatever the number of actors.
+ * Removed entries are only flagged and skipped by lookups, the lists are rebuilt once there are more removed entries than live ones.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerLabelIndex : public IModuleListenerInterface, public FSceneOutlinerWorldActorIndex::IListener
+{
+public:
+	struct FResult
+	{
+		FSceneOutlinerTreeItemID ID;
+		FString Label;
+		// Folder of the actor, or parent folder of the folder
+		FName ParentPath;
+		TWeakObjectPtr<AActor> Actor;
+		bool bIsFolder = false;
+	};
+
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the index registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerLabelIndex* Get();
+
+	// Adds up to `MaxResults` actors and folders of the current editor world whose label contains the query, ignoring case.
+	// The labels starting with the query come first. Queries shorter than 3 characters only match the start of the labels.
+	void Find(const FString& Query, int32 MaxResults, TArray<FResult>& OutResults);
+
+	// Builds the index for the current editor world if needed, ex: when the popup opens, so the first lookup is not slowed down
+	void BuildIfNeeded();
+	// Rebuilds the index on the next lookup
+	void MarkDirty();
+
+	int32 Num() const { return Entries.Num() - NumRemoved; }
+
+	//~ Begin FSceneOutlinerWorldActorIndex::IListener
+	virtual void OnIndexReset(UWorld* World) override;
+	virtual void OnIndexActorAdded(AActor& Actor) override { AddActor(&Actor); }
+	virtual void OnIndexActorDeleted(AActor& Actor) override { RemoveEntry(FSceneOutlinerTreeItemID(&Actor)); }
+	//~ End FSceneOutlinerWorldActorIndex::IListener
+
+private:
+	struct FEntry
+	{
+		FSceneOutlinerTreeItemID ID;
+		FString Label;
+		// Only kept for the folders, actors can be moved to another folder without being renamed
+		FName ParentPath;
+		TWeakObjectPtr<AActor> Actor;
+		bool bIsFolder = false;
+		bool bRemoved = false;
+	};
+
+	// Three lowercase characters packed together, the padding character being 0
+	using FTrigram = uint64;
+	// Sets `OutTrigrams` to the distinct trigrams of the text, with two padding characters in front if `bPadded`
+	static void GetTrigrams(const FString& Text, bool bPadded, TArray<FTrigram>& OutTrigrams);
+	// Returns the shortest list among the given trigrams, or null if one of them is not indexed, as nothing can match
+	const TArray<int32>* FindShortestList(const TArray<FTrigram>& Trigrams) const;
+
+	void AddEntry(FEntry&& Entry);
+	void RemoveEntry(const FSceneOutlinerTreeItemID& ID);
+	void AddActor(AActor* Actor);
+	void AddFolder(const FFolder& Folder);
+	// Rebuilds the lists without the removed entries
+	void Compact();
+
+	void BindEvents();
+	void UnbindEvents();
+
+	void OnActorLabelChanged(AActor* Actor);
+	void OnUndoRedo() { MarkDirty(); }
+	void OnFolderCreated(UWorld& World, const FFolder& Folder);
+	void OnFolderDeleted(UWorld& World, const FFolder& Folder);
+	void OnFolderMoved(UWorld& World, const FFolder& Source, const FFolder& Destination);
+
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	TArray<FEntry> Entries;
+	TMap<FSceneOutlinerTreeItemID, int32> EntryIndices;
+	TMap<FTrigram, TArray<int32>> EntriesByTrigram;
+	int32 NumRemoved = 0;
+
+	FDelegateHandle OnActorLabelChangedHandle;
+	FDelegateHandle OnPostUndoRedoHandle;
+	FDelegateHandle OnFolderCreatedHandle;
+	FDelegateHandle OnFolderDeletedHandle;
+	FDelegateHandle OnFolderMovedHandle;
+
+	static FSceneOutlinerLabelIndex* Instance;
+};
@@ -0,0 +1,66 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "ISceneOutlinerTreeItem.h"
+#include "Containers/Ticker.h"
+
+class FSceneOutlinerExpansionBatch;
+
+/**
+ * Reveals the selected actors in the Scene Outliner by expanding only the chain of parents of each of them.
+ * The chains are found by walking up from the selected items, so the cost is the number of selected items times their depth, whatever the size of the tree.
+ *
+ * When `bRevealSelectionFollowsViewport` is enabled, the chains are updated each time the actor selection changes:
+ * only the parents that are no longer needed are collapsed, and only the new ones are expanded.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerSelectionReveal : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the instance registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerSelectionReveal* Get();
+
+	// Collapses the visible items and expands the parents of the selected items. Returns false if nothing is selected.
+	bool RevealSelection(SSceneOutliner& SOutliner);
+
+	// Expands the parents of the item and scrolls to it, leaving the rest of the Outliner untouched
+	static void RevealItem(SSceneOutliner& SOutliner, const FSceneOutlinerTreeItemPtr& Item);
+
+	// Returns the selected actors of the level editor, or the items selected in the Outliner if no actor is selected
+	static TArray<FSceneOutlinerTreeItemPtr> GetSelectedItems(SSceneOutliner& SOutliner);
+	// Adds the parents of the given items to `OutPath`, stopping at the parents already in it
+	static void GatherParents(const TArray<FSceneOutlinerTreeItemPtr>& Items, TMap<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>& OutPath);
+	// Collapses the visible items which are not in `Path`, and the children shown by expanding the items of `Path`
+	static void CollapseOutsidePath(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const TMap<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>& Path);
+
+private:
+	using FRevealedPath = TMap<FSceneOutlinerTreeItemID, TWeakPtr<ISceneOutlinerTreeItem>>;
+
+	struct FOutlinerState
+	{
+		TWeakPtr<SSceneOutliner> Outliner;
+		// Parents expanded by the last reveal
+		FRevealedPath Path;
+	};
+
+	void OnSelectionChanged(UObject* Selection);
+	bool TickFollowSelection(float DeltaTime);
+	// Expands the new parents of the selection and collapses the ones that were only needed by the previous selection
+	void UpdateRevealedPath(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner);
+
+	static void CollapseRevealedChildren(FSceneOutlinerExpansionBatch& Batch, SSceneOutliner& SOutliner, const FRevealedPath& Path);
+	static void ScrollToFirstItem(SSceneOutliner& SOutliner, const TArray<FSceneOutlinerTreeItemPtr>& Items);
+
+	FOutlinerState& FindOrAddState(SSceneOutliner& SOutliner);
+
+	TArray<FOutlinerState> States;
+	FDelegateHandle OnSelectionChangedHandle;
+	FTSTicker::FDelegateHandle FollowSelectionHandle;
+
+	static FSceneOutlinerSelectionReveal* Instance;
+};
@@ -0,0 +1,51 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+#include "Containers/Ticker.h"
+
+class SNotificationItem;
+
+/**
+ * Expands Scene Outliners over several frames, spending at most the frame budget from the settings each tick.
+ * Shows a notification with the progress, which can be cancelled from the notification or by calling `Cancel()`.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerTimeSlicedExpansion : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the instance registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerTimeSlicedExpansion* Get();
+
+	// Starts expanding the given Outliners, cancelling any expansion already running
+	bool Start(const TArray<SSceneOutliner*>& SOutliners);
+	// Stops the running expansion. Returns true if an expansion was running.
+	bool Cancel();
+	bool IsRunning() const { return Jobs.Num() > 0; }
+
+private:
+	struct FExpansionJob
+	{
+		TWeakPtr<SSceneOutliner> Outliner;
+		// Items still to visit, the tree is walked depth first so we never hold more than one level of siblings per depth
+		TArray<TWeakPtr<ISceneOutlinerTreeItem>> Stack;
+	};
+
+	bool Tick(float DeltaTime);
+	void Finish(bool bCancelled);
+	void UpdateNotification();
+
+	TArray<FExpansionJob> Jobs;
+	FTSTicker::FDelegateHandle TickHandle;
+	TWeakPtr<SNotificationItem> Notification;
+
+	int32 ItemsVisited = 0;
+	int32 ItemsExpanded = 0;
+	double StartTime = 0.;
+
+	static FSceneOutlinerTimeSlicedExpansion* Instance;
+};
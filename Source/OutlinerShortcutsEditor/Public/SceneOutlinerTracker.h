@@ -0,0 +1,55 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+
+#if UE5_1_ONWARDS
+
+class SDockTab;
+
+/**
+ * [UE 5.1 Onwards] Keeps the opened Scene Outliners sorted from the most recently used to the least recently used.
+ * The order is updated from the tab activation events, and the list of Outliners is only gathered again when the Level Editor tabs change,
+ * so finding the most recently used Outliner does not need to go through all the Outliner tabs.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerTracker : public IModuleListenerInterface
+{
+public:
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the tracker registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerTracker* Get();
+
+	// Returns the most recently used Scene Outliner, or null if none is opened
+	TSharedPtr<SSceneOutliner> GetMostRecentlyUsedOutliner();
+	// Returns all the opened Scene Outliners, from the most recently used to the least recently used
+	TArray<TSharedRef<SSceneOutliner>> GetAllOutliners();
+
+	// Gathers the Outliners from the Level Editor again on the next lookup
+	void MarkDirty() { bIsDirty = true; }
+
+private:
+	void OnActiveTabChanged(TSharedPtr<SDockTab> PreviouslyActive, TSharedPtr<SDockTab> NewlyActivated);
+	// Moves the Outliner of the tab to the front of the list, returns false if the tab does not hold a known Outliner
+	bool MoveToFront(const FName TabID);
+	void RefreshIfDirty();
+	void RemoveStaleOutliners();
+
+	// Known Outliners, the most recently used first
+	TArray<TWeakPtr<SSceneOutliner>> Outliners;
+	// Identifiers of the known Outliners, in the same order
+	TArray<FName> OutlinerIDs;
+	bool bIsDirty = true;
+
+	FDelegateHandle OnActiveTabChangedHandle;
+	FDelegateHandle OnTabForegroundedHandle;
+	FDelegateHandle OnTabContentChangedHandle;
+	FDelegateHandle OnLevelEditorCreatedHandle;
+
+	static FSceneOutlinerTracker* Instance;
+};
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneOutlinerFwd.h"
+#include "SceneOutlinerExpansionSet.h"
+#include "Containers/BitArray.h"
+
+class FSceneOutlinerExpansionBatch;
+
+/**
+ * Minimal view of a tree of Outliner items, so the expansion policies of `FSceneOutlinerTreePolicies` can run without Slate.
+ * Items are identified by an index, valid for the lifetime of the model.
+ */
+class OUTLINERSHORTCUTSEDITOR_API ISceneOutlinerTreeModel
+{
+public:
+	virtual ~ISceneOutlinerTreeModel() {}
+
+	virtual void GetRootItems(TArray<int32>& OutItems) const = 0;
+	virtual void GetChildren(int32 Item, TArray<int32>& OutChildren) const = 0;
+	virtual bool HasChildren(int32 Item) const = 0;
+	// Returns INDEX_NONE for the root items
+	virtual int32 GetParent(int32 Item) const = 0;
+	virtual bool IsExpanded(int32 Item) const = 0;
+	virtual void SetExpanded(int32 Item, bool bExpanded) = 0;
+	// Full path of a folder item, none for the other items
+	virtual FName GetFolderPath(int32 Item) const = 0;
+
+	// Expands or collapses every item with children. Returns the number of items visited.
+	virtual int32 SetAllExpanded(bool bExpanded);
+};
+
+/**
+ * Tree held in flat arrays, a few bytes per item. Used to replay hierarchies captured from real maps in benchmarks.
+ *
+ * Trees are saved as a small binary file: the parent of each item, a bitset of the expanded ones, and the paths of the folders.
+ * Children are listed in the order they were added.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerMemoryTreeModel : public ISceneOutlinerTreeModel
+{
+public:
+	// Adds an item under the given parent, or a root item if the parent is INDEX_NONE. Returns its index.
+	int32 AddItem(int32 Parent, FName FolderPath = NAME_None, bool bExpanded = false);
+	int32 Num() const { return Parents.Num(); }
+	void Reset();
+
+	// Copies the items and the expansion of any model, ex: of a live Outliner through `FSceneOutlinerWidgetTreeModel`
+	static TSharedRef<FSceneOutlinerMemoryTreeModel> Capture(const ISceneOutlinerTreeModel& Source);
+
+	const TBitArray<>& GetExpansion() const { return Expanded; }
+	// Restores an expansion returned by `GetExpansion`, ex: between two runs of a benchmark
+	void SetExpansion(const TBitArray<>& InExpanded);
+
+	void Serialize(FArchive& Ar);
+	bool SaveToFile(const FString& Filename) const;
+	// Returns null if the file is missing or not a saved tree
+	static TSharedPtr<FSceneOutlinerMemoryTreeModel> LoadFromFile(const FString& Filename);
+
+	//~ Begin ISceneOutlinerTreeModel
+	virtual void GetRootItems(TArray<int32>& OutItems) const override { OutItems.Append(Roots); }
+	virtual void GetChildren(int32 Item, TArray<int32>& OutChildren) const override;
+	virtual bool HasChildren(int32 Item) const override { return FirstChild[Item] != INDEX_NONE; }
+	virtual int32 GetParent(int32 Item) const override { return Parents[Item]; }
+	virtual bool IsExpanded(int32 Item) const override { return Expanded[Item]; }
+	virtual void SetExpanded(int32 Item, bool bExpanded) override { Expanded[Item] = bExpanded; }
+	virtual FName GetFolderPath(int32 Item) const override;
+	//~ End ISceneOutlinerTreeModel
+
+private:
+	// Rebuilds the children lists and the roots from the parents, after loading
+	void LinkChildren();
+
+	TArray<int32> Parents;
+	TArray<int32> FirstChild;
+	TArray<int32> LastChild;
+	TArray<int32> NextSibling;
+	TArray<int32> Roots;
+	TBitArray<> Expanded;
+	// Only a small part of the items are folders
+	TMap<int32, FName> FolderPaths;
+};
+
+/**
+ * Model of a live Scene Outliner. Items are interned as they are reached, so an index stays valid across refreshes of the Outliner.
+ * With a batch, the expansion is read from and added to the batch. Without one, the items are expanded right away, ex: when the batch itself is applied.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerWidgetTreeModel : public ISceneOutlinerTreeModel
+{
+public:
+	explicit FSceneOutlinerWidgetTreeModel(SSceneOutliner& InOutliner, FSceneOutlinerExpansionBatch* InBatch = nullptr);
+
+	// Changes the batch the expansion goes through, ex: for a model kept across commands. Null expands the items right away.
+	void SetBatch(FSceneOutlinerExpansionBatch* InBatch) { Batch = InBatch; }
+
+	// Returns the index of an item of the Outliner, ex: of a selected item
+	int32 Intern(const FSceneOutlinerTreeItemPtr& Item) const;
+	// Returns the item of the Outliner, looking it up again if it was recreated by a refresh. Null if it was removed since.
+	FSceneOutlinerTreeItemPtr GetItem(int32 Item) const;
+	const FSceneOutlinerTreeItemID& GetID(int32 Item) const { return Interner.GetID(Item); }
+	// Returns the index of the item with this ID, or INDEX_NONE if it was never reached
+	int32 Find(const FSceneOutlinerTreeItemID& ID) const { return Interner.Find(ID); }
+
+	// Items changed right away, when there is no batch
+	int32 GetNumExpanded() const { return NumExpanded; }
+	int32 GetNumCollapsed() const { return NumCollapsed; }
+
+	//~ Begin ISceneOutlinerTreeModel
+	virtual void GetRootItems(TArray<int32>& OutItems) const override;
+	virtual void GetChildren(int32 Item, TArray<int32>& OutChildren) const override;
+	virtual bool HasChildren(int32 Item) const override;
+	virtual int32 GetParent(int32 Item) const override;
+	virtual bool IsExpanded(int32 Item) const override;
+	virtual void SetExpanded(int32 Item, bool bExpanded) override;
+	virtual FName GetFolderPath(int32 Item) const override;
+	// With a batch, only sets its base state, the tree is walked once when the batch is applied
+	virtual int32 SetAllExpanded(bool bExpanded) override;
+	//~ End ISceneOutlinerTreeModel
+
+private:
+	SSceneOutliner& Outliner;
+	FSceneOutlinerExpansionBatch* Batch = nullptr;
+	// Items are interned lazily by the const accessors
+	mutable FSceneOutlinerItemInterner Interner;
+	mutable TArray<TWeakPtr<ISceneOutlinerTreeItem>> Items;
+	int32 NumExpanded = 0;
+	int32 NumCollapsed = 0;
+};
@@ -0,0 +1,42 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class ISceneOutlinerTreeModel;
+class FFolderPathMatcher;
+struct FOutlinerShortcutsOperation;
+
+/**
+ * Expansion policies written against `ISceneOutlinerTreeModel`. The commands run them on the live Outliners through `FSceneOutlinerWidgetTreeModel`,
+ * and the benchmarks on trees loaded from a file, so both time the same code.
+ * Each function returns the number of items visited. On a live Outliner, the items walked when the batch is applied are counted by the batch.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerTreePolicies
+{
+public:
+	// Roots are at depth 0
+	static int32 GetDepth(const ISceneOutlinerTreeModel& Model, int32 Item);
+
+	// Sets the expansion of every item with children, to the override if any or to `bExpanded`
+	static int32 SetAllExpanded(ISceneOutlinerTreeModel& Model, bool bExpanded, TFunctionRef<TOptional<bool>(int32)> GetOverride);
+
+	static int32 CollapseAll(ISceneOutlinerTreeModel& Model);
+	// Collapses everything, then expands the root items
+	static int32 CollapseToRoot(ISceneOutlinerTreeModel& Model);
+	static int32 ExpandAll(ISceneOutlinerTreeModel& Model);
+	// Expands the items above the given depth and collapses the deeper ones. At depth 1, only the root items are expanded.
+	// Goes through a transient `FSceneOutlinerExpansionFrontier`, the commands use the one kept for their Outliner.
+	static int32 ExpandToDepth(ISceneOutlinerTreeModel& Model, int32 Depth);
+	// Collapses to root, then expands the folders matched and their parents.
+	// Each folder is matched from the states of its parent, and only the folders that can still lead to a match are walked into.
+	static int32 ExpandMatchingFolders(ISceneOutlinerTreeModel& Model, const FFolderPathMatcher& Matcher);
+	// Expands or collapses the given items and everything under them, leaving the rest of the tree untouched.
+	// Items inside the subtree of another given item are only visited once.
+	static int32 SetSubtreesExpansion(ISceneOutlinerTreeModel& Model, const TArray<int32>& Items, bool bExpand);
+
+	// Applies the operation, taking the patterns from the settings. Returns false for the operations that need the actors of a map.
+	static bool ApplyOperation(ISceneOutlinerTreeModel& Model, const FOutlinerShortcutsOperation& Operation, int32& OutNumVisited);
+};
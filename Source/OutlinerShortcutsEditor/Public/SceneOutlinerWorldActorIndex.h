@@ -0,0 +1,68 @@
+// Copyright Voulz 2021-2022. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OutlinerShortcutsEditor.h"
+
+class AActor;
+class ULevel;
+
+/**
+ * Walks the actors of the editor world for the indices built on them, ex: `FSceneOutlinerActorClassIndex` and `FSceneOutlinerLabelIndex`,
+ * then forwards them the actor added and deleted events.
+ * The indices are built together in a single pass the first time one of them is needed for a world, and dirtied together when the map changes,
+ * when the actor list of the world changes without an actor event (ex: undo) or when a level is added to or removed from the world.
+ */
+class OUTLINERSHORTCUTSEDITOR_API FSceneOutlinerWorldActorIndex : public IModuleListenerInterface
+{
+public:
+	// An index built from the actors of the editor world
+	class IListener
+	{
+	public:
+		virtual ~IListener() {}
+
+		// Called before the actors of the world are added, to start over. The world is null if there is no editor world.
+		virtual void OnIndexReset(UWorld* World) = 0;
+		// Called for each actor of the world when built, then for each actor added to the world
+		virtual void OnIndexActorAdded(AActor& Actor) = 0;
+		virtual void OnIndexActorDeleted(AActor& Actor) = 0;
+	};
+
+	virtual void OnStartupModule() override;
+	virtual void OnShutdownModule() override;
+
+	// Returns the index registered by the module, or null if the module listeners are not running (ex: in commandlets)
+	static FSceneOutlinerWorldActorIndex* Get();
+
+	void AddListener(IListener& Listener);
+	void RemoveListener(IListener& Listener);
+
+	// Builds the listeners for the world, if it is not the one indexed or if the index was dirtied since
+	void BuildIfNeeded(UWorld* World);
+	// Rebuilds the listeners on the next lookup of any of them
+	void MarkDirty() { bIsDirty = true; }
+
+private:
+	void BindActorEvents();
+	void UnbindActorEvents();
+
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnLevelActorListChanged() { MarkDirty(); }
+	void OnLevelAddedOrRemoved(ULevel* Level, UWorld* World);
+
+	TArray<IListener*> Listeners;
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	bool bIsDirty = true;
+
+	FDelegateHandle OnLevelActorAddedHandle;
+	FDelegateHandle OnLevelActorDeletedHandle;
+	FDelegateHandle OnLevelActorListChangedHandle;
+	FDelegateHandle OnMapChangeHandle;
+	FDelegateHandle OnLevelAddedToWorldHandle;
+	FDelegateHandle OnLevelRemovedFromWorldHandle;
+
+	static FSceneOutlinerWorldActorIndex* Instance;
+};